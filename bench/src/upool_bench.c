@@ -0,0 +1,66 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "upool_bench.h"
+#include "ulib.h"
+
+enum {
+    SEED = 31,
+#ifdef ULIB_TINY
+    ITEM_COUNT = ULIB_UINT_MAX / 2,
+#else
+    ITEM_COUNT = 1000000,
+#endif
+    REPEAT_COUNT = 5,
+};
+
+typedef struct bench_ctx {
+    double *items;
+    double *out;
+} bench_ctx;
+
+static void transform_range(void *ctx, ulib_uint start, ulib_uint len) {
+    bench_ctx *c = (bench_ctx *)ctx;
+    for (ulib_uint i = start; i < start + len; ++i) {
+        double x = c->items[i], y = 1.0;
+        // Newton iterations for the square root, to get some CPU-bound work.
+        for (unsigned j = 0; j < 16; ++j) y = 0.5 * (y + x / y);
+        c->out[i] = y;
+    }
+}
+
+void bench_upool(void) {
+    ulog_info("==[ UPool ]==");
+
+    bench_ctx ctx;
+    ctx.items = (double *)ulib_alloc_array(ctx.items, ITEM_COUNT);
+    ctx.out = (double *)ulib_alloc_array(ctx.out, ITEM_COUNT);
+
+    urand_set_seed(SEED);
+    for (ulib_uint i = 0; i < ITEM_COUNT; ++i) {
+        ctx.items[i] = (double)urand_range(1, 1000);
+    }
+
+    UPool *pool = upool_new(0);
+    ulog_info("- Parallel for (%u workers)", upool_threads(pool));
+
+    ulog_perf("sequential") {
+        for (unsigned i = 0; i < REPEAT_COUNT; ++i) {
+            transform_range(&ctx, 0, ITEM_COUNT);
+        }
+    }
+
+    ulog_perf("upool_parallel_for") {
+        for (unsigned i = 0; i < REPEAT_COUNT; ++i) {
+            upool_parallel_for(pool, 0, ITEM_COUNT, 0, transform_range, &ctx);
+        }
+    }
+
+    upool_free(pool);
+    ulib_free(ctx.items);
+    ulib_free(ctx.out);
+}
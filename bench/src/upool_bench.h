@@ -0,0 +1,19 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UPOOL_BENCH_H
+#define UPOOL_BENCH_H
+
+#include "uattrs.h"
+
+ULIB_BEGIN_DECLS
+
+void bench_upool(void);
+
+ULIB_END_DECLS
+
+#endif // UPOOL_BENCH_H
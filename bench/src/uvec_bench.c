@@ -119,6 +119,36 @@ static void bench_uvec_sort_large_repeated(void) {
     uvec_deinit(ulib_int, &v);
 }
 
+static void bench_uvec_top_k(void) {
+    UVec(ulib_int) v = uvec(ulib_int);
+    UVec(ulib_int) top = uvec(ulib_int);
+
+    for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+        uvec_push(ulib_int, &v, urand());
+    }
+
+    ulog_info("- Top 100");
+    ulog_perf("uvec_min_heapq_push_pop") {
+        uvec_clear(ulib_int, &top);
+        uvec_foreach (ulib_int, &v, e) {
+            if (uvec_count(ulib_int, &top) < 100) {
+                uvec_min_heapq_push(ulib_int, &top, *e.item);
+            } else {
+                uvec_min_heapq_push_pop(ulib_int, &top, *e.item, NULL);
+            }
+        }
+    }
+    ulog_perf("uvec_top_k") {
+        uvec_top_k(ulib_int, &v, 100, &top);
+    }
+    ulog_perf("uvec_nth_element") {
+        uvec_nth_element(ulib_int, &v, SORT_COUNT_LARGE / 2);
+    }
+
+    uvec_deinit(ulib_int, &v);
+    uvec_deinit(ulib_int, &top);
+}
+
 static void bench_uvec_sorted_insertion(void) {
     UVec(ulib_int) v = uvec(ulib_int);
     uvec_reserve(ulib_int, &v, INSERT_COUNT_SMALL);
@@ -143,9 +173,106 @@ static void bench_uvec_sorted_insertion(void) {
         }
     }
 
+    static ulib_int array[INSERT_COUNT_LARGE];
+    for (unsigned i = 0; i < INSERT_COUNT_LARGE; ++i) {
+        array[i] = urand();
+    }
+
+    ulog_perf("batch") {
+        uvec_sorted_insert_all(ulib_int, &v, array, INSERT_COUNT_LARGE);
+    }
+
     uvec_deinit(ulib_int, &v);
 }
 
+static void bench_uvec_sorted_search(void) {
+    UVec(ulib_int) v = uvec(ulib_int);
+    uvec_reserve(ulib_int, &v, SORT_COUNT_LARGE);
+
+    for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+        uvec_push(ulib_int, &v, (ulib_int)i * 2);
+    }
+
+    ulib_uint found = 0;
+    ulog_info("- Sorted search");
+
+    urand_set_seed(SEED);
+    ulog_perf("binary") {
+        for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+            ulib_int const item = (ulib_int)urand_range(0, SORT_COUNT_LARGE * 2);
+            found += uvec_sorted_index_of(ulib_int, &v, item) < SORT_COUNT_LARGE;
+        }
+    }
+
+    urand_set_seed(SEED);
+    ulog_perf("branchless") {
+        for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+            ulib_int const item = (ulib_int)urand_range(0, SORT_COUNT_LARGE * 2);
+            found += uvec_sorted_index_of_branchless(ulib_int, &v, item) < SORT_COUNT_LARGE;
+        }
+    }
+
+    uvec_eytzinger(ulib_int, &v);
+    urand_set_seed(SEED);
+    ulog_perf("eytzinger") {
+        for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+            ulib_int const item = (ulib_int)urand_range(0, SORT_COUNT_LARGE * 2);
+            found += uvec_eytzinger_index_of(ulib_int, &v, item) < SORT_COUNT_LARGE;
+        }
+    }
+
+    ulog_debug("Found: %" ULIB_UINT_FMT, found);
+    uvec_deinit(ulib_int, &v);
+}
+
+static void bench_uvec_sorted_intersect(void) {
+    UVec(ulib_int) large = uvec(ulib_int);
+    UVec(ulib_int) small = uvec(ulib_int);
+    UVec(ulib_int) result = uvec(ulib_int);
+
+    for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+        uvec_push(ulib_int, &large, (ulib_int)i * 2);
+    }
+    for (unsigned i = 0; i < SORT_COUNT_LARGE / 256; ++i) {
+        uvec_push(ulib_int, &small, (ulib_int)i * 512 + (ulib_int)(i & 1));
+    }
+
+    ulog_info("- Sorted intersection: skewed");
+    ulog_perf("uvec_sorted_contains") {
+        uvec_clear(ulib_int, &result);
+        uvec_foreach (ulib_int, &small, e) {
+            if (uvec_sorted_contains(ulib_int, &large, *e.item)) {
+                uvec_push(ulib_int, &result, *e.item);
+            }
+        }
+    }
+    ulog_perf("uvec_sorted_intersect") {
+        uvec_sorted_intersect(ulib_int, &small, &large, &result);
+    }
+
+    uvec_clear(ulib_int, &small);
+    for (unsigned i = 0; i < SORT_COUNT_LARGE; ++i) {
+        uvec_push(ulib_int, &small, (ulib_int)i * 3);
+    }
+
+    ulog_info("- Sorted intersection: balanced");
+    ulog_perf("uvec_sorted_contains") {
+        uvec_clear(ulib_int, &result);
+        uvec_foreach (ulib_int, &small, e) {
+            if (uvec_sorted_contains(ulib_int, &large, *e.item)) {
+                uvec_push(ulib_int, &result, *e.item);
+            }
+        }
+    }
+    ulog_perf("uvec_sorted_intersect") {
+        uvec_sorted_intersect(ulib_int, &small, &large, &result);
+    }
+
+    uvec_deinit(ulib_int, &large);
+    uvec_deinit(ulib_int, &small);
+    uvec_deinit(ulib_int, &result);
+}
+
 static void bench_uvec_heap_queue(void) {
     UVec(ulib_int) items = uvec(ulib_int);
     UVec(ulib_int) heap = uvec(ulib_int);
@@ -194,6 +321,9 @@ void bench_uvec(void) {
     bench_uvec_sort_small();
     bench_uvec_sort_large();
     bench_uvec_sort_large_repeated();
+    bench_uvec_top_k();
     bench_uvec_sorted_insertion();
+    bench_uvec_sorted_search();
+    bench_uvec_sorted_intersect();
     bench_uvec_heap_queue();
 }
@@ -0,0 +1,595 @@
+/**
+ * A type-safe, generic C double-ended queue.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UDEQUE_H
+#define UDEQUE_H
+
+#include "ualloc.h"
+#include "uattrs.h"
+#include "unumber.h"
+#include "uutils.h"
+#include "uvec.h"
+#include <string.h>
+
+ULIB_BEGIN_DECLS
+
+// Types
+
+/**
+ * References a specific deque type.
+ *
+ * @param T Deque type.
+ */
+#define UDeque(T) ULIB_MACRO_CONCAT(UDeque_, T)
+
+/**
+ * Generic double-ended queue type.
+ *
+ * Elements are stored in a ring buffer whose size is a power of two, allowing elements
+ * to be pushed and popped at both ends in *O(1)*.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{UDeque(T)} macro to reference a specific deque type.
+ * @alias typedef struct UDeque(T) UDeque(T);
+ */
+
+/**
+ * References the span type of a specific deque type.
+ *
+ * @param T Deque type.
+ */
+#define UDequeSpans(T) ULIB_MACRO_CONCAT(UDequeSpans_, T)
+
+/**
+ * Pair of contiguous memory regions of a deque, in logical order.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{UDequeSpans(T)} macro to reference a specific span type.
+ * @alias typedef struct UDequeSpans(T) UDequeSpans(T);
+ */
+
+/**
+ * Deque type forward declaration.
+ *
+ * @param T @ctype{symbol} Deque type.
+ */
+#define udeque_decl(T) typedef struct UDeque(T) UDeque(T)
+
+/*
+ * Defines a new deque struct.
+ *
+ * @param T @ctype{symbol} Deque type.
+ */
+#define P_UDEQUE_DEF_TYPE(T)                                                                       \
+    typedef struct UDeque_##T {                                                                    \
+        /** @cond */                                                                               \
+        T *_data;                                                                                  \
+        ulib_uint _head;                                                                           \
+        ulib_uint _count;                                                                          \
+        ulib_uint _size;                                                                           \
+        /** @endcond */                                                                            \
+    } UDeque_##T;                                                                                  \
+                                                                                                   \
+    typedef struct UDequeSpans_##T {                                                               \
+        /** First span. */                                                                         \
+        T *first;                                                                                  \
+        /** Number of elements in the first span. */                                               \
+        ulib_uint first_count;                                                                     \
+        /** Second span. */                                                                        \
+        T *second;                                                                                 \
+        /** Number of elements in the second span. */                                              \
+        ulib_uint second_count;                                                                    \
+    } UDequeSpans_##T;
+
+/*
+ * Generates function declarations for the specified deque type.
+ *
+ * @param T @ctype{symbol} Deque type.
+ * @param ATTRS @ctype{attributes} Attributes of the declarations.
+ */
+#define P_UDEQUE_DECL(T, ATTRS)                                                                    \
+    /** @cond */                                                                                   \
+    ATTRS uvec_ret udeque_reserve_##T(UDeque_##T *q, ulib_uint size);                              \
+    ATTRS uvec_ret udeque_push_back_array_##T(UDeque_##T *q, T const *array, ulib_uint n);         \
+    ATTRS ulib_uint udeque_pop_front_array_##T(UDeque_##T *q, T *array, ulib_uint n);              \
+    /** @endcond */
+
+/*
+ * Generates inline function definitions for the specified deque type.
+ *
+ * @param T @ctype{symbol} Deque type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_UDEQUE_DEF_INLINE(T, ATTRS)                                                              \
+    /** @cond */                                                                                   \
+    ATTRS ULIB_INLINE UDeque_##T udeque_##T(void) {                                                \
+        UDeque_##T q = ulib_struct_init;                                                           \
+        return q;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void udeque_deinit_##T(UDeque_##T *q) {                                      \
+        ulib_free(q->_data);                                                                       \
+        q->_data = NULL;                                                                           \
+        q->_head = q->_count = q->_size = 0;                                                       \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void udeque_clear_##T(UDeque_##T *q) {                                       \
+        q->_head = q->_count = 0;                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint udeque_count_##T(UDeque_##T const *q) {                  \
+        return q->_count;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint udeque_size_##T(UDeque_##T const *q) {                   \
+        return q->_size;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T *udeque_get_ref_##T(UDeque_##T const *q, ulib_uint idx) {        \
+        return q->_data + ((q->_head + idx) & (q->_size - 1));                                     \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T udeque_get_##T(UDeque_##T const *q, ulib_uint idx) {             \
+        return *udeque_get_ref_##T(q, idx);                                                        \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void udeque_set_##T(UDeque_##T *q, ulib_uint idx, T item) {                  \
+        *udeque_get_ref_##T(q, idx) = item;                                                        \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T udeque_first_##T(UDeque_##T const *q) {                          \
+        return q->_data[q->_head];                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T udeque_last_##T(UDeque_##T const *q) {                           \
+        return udeque_get_##T(q, q->_count - 1);                                                   \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE uvec_ret udeque_push_back_##T(UDeque_##T *q, T item) {                       \
+        if (q->_count == q->_size && udeque_reserve_##T(q, q->_count + 1)) return UVEC_ERR;        \
+        *udeque_get_ref_##T(q, q->_count++) = item;                                                \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE uvec_ret udeque_push_front_##T(UDeque_##T *q, T item) {                      \
+        if (q->_count == q->_size && udeque_reserve_##T(q, q->_count + 1)) return UVEC_ERR;        \
+        q->_head = (q->_head - 1) & (q->_size - 1);                                                \
+        q->_data[q->_head] = item;                                                                 \
+        q->_count++;                                                                               \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool udeque_pop_back_##T(UDeque_##T *q, T *item) {                           \
+        if (!q->_count) return false;                                                              \
+        q->_count--;                                                                               \
+        if (item) *item = udeque_get_##T(q, q->_count);                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool udeque_pop_front_##T(UDeque_##T *q, T *item) {                          \
+        if (!q->_count) return false;                                                              \
+        if (item) *item = q->_data[q->_head];                                                      \
+        q->_head = (q->_head + 1) & (q->_size - 1);                                                \
+        q->_count--;                                                                               \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE UDequeSpans_##T udeque_spans_##T(UDeque_##T const *q) {            \
+        UDequeSpans_##T s = { q->_data + q->_head, q->_count, q->_data, 0 };                       \
+        if (q->_head + q->_count > q->_size) {                                                     \
+            s.first_count = q->_size - q->_head;                                                   \
+            s.second_count = q->_count - s.first_count;                                            \
+        }                                                                                          \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE UDequeSpans_##T udeque_free_spans_##T(UDeque_##T const *q) {       \
+        UDequeSpans_##T s = { q->_data, (ulib_uint)(q->_size - q->_count), q->_data, 0 };          \
+        if (!q->_size) return s;                                                                   \
+        ulib_uint const tail = (q->_head + q->_count) & (q->_size - 1);                            \
+        s.first += tail;                                                                           \
+        if (tail >= q->_head && tail + s.first_count > q->_size) {                                 \
+            s.first_count = q->_size - tail;                                                       \
+            s.second_count = q->_head;                                                             \
+        }                                                                                          \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void udeque_commit_##T(UDeque_##T *q, ulib_uint n) {                         \
+        q->_count += n;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void udeque_consume_##T(UDeque_##T *q, ulib_uint n) {                        \
+        q->_head = (q->_head + n) & (q->_size - 1);                                                \
+        q->_count -= n;                                                                            \
+    }                                                                                              \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified deque type.
+ *
+ * @param T @ctype{symbol} Deque type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_UDEQUE_IMPL(T, ATTRS)                                                                    \
+                                                                                                   \
+    ATTRS uvec_ret udeque_reserve_##T(UDeque_##T *q, ulib_uint size) {                             \
+        ulib_uint const old_size = q->_size;                                                       \
+        if (size <= old_size) return UVEC_OK;                                                      \
+                                                                                                   \
+        if (size > (ULIB_UINT_MAX >> 1U) + 1U) return UVEC_ERR;                                    \
+        size = ulib_uint_ceil2(size);                                                              \
+                                                                                                   \
+        T *data = (T *)ulib_realloc_array(q->_data, size);                                         \
+        if (!data) return UVEC_ERR;                                                                \
+                                                                                                   \
+        if (q->_head + q->_count > old_size) {                                                     \
+            /* The elements wrap around: move the leading ones past the old end. */                \
+            ulib_uint const wrapped = q->_head + q->_count - old_size;                             \
+            memcpy(data + old_size, data, wrapped * sizeof(T));                                    \
+        }                                                                                          \
+                                                                                                   \
+        q->_data = data;                                                                           \
+        q->_size = size;                                                                           \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret udeque_push_back_array_##T(UDeque_##T *q, T const *array, ulib_uint n) {        \
+        if (!n) return UVEC_OK;                                                                    \
+        if (n > ULIB_UINT_MAX - q->_count) return UVEC_ERR;                                        \
+        if (udeque_reserve_##T(q, q->_count + n)) return UVEC_ERR;                                 \
+                                                                                                   \
+        UDequeSpans_##T s = udeque_free_spans_##T(q);                                              \
+        ulib_uint const first = ulib_min(n, s.first_count);                                        \
+        memcpy(s.first, array, first * sizeof(T));                                                 \
+        if (n > first) memcpy(s.second, array + first, (n - first) * sizeof(T));                   \
+        q->_count += n;                                                                            \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint udeque_pop_front_array_##T(UDeque_##T *q, T *array, ulib_uint n) {             \
+        n = ulib_min(n, q->_count);                                                                \
+        if (!n) return 0;                                                                          \
+                                                                                                   \
+        if (array) {                                                                               \
+            UDequeSpans_##T s = udeque_spans_##T(q);                                               \
+            ulib_uint const first = ulib_min(n, s.first_count);                                    \
+            memcpy(array, s.first, first * sizeof(T));                                             \
+            if (n > first) memcpy(array + first, s.second, (n - first) * sizeof(T));               \
+        }                                                                                          \
+                                                                                                   \
+        udeque_consume_##T(q, n);                                                                  \
+        return n;                                                                                  \
+    }
+
+/**
+ * @defgroup UDeque_definitions UDeque type definitions
+ * @{
+ */
+
+/**
+ * Declares a new deque type.
+ *
+ * @param T @ctype{symbol} Deque type.
+ */
+#define UDEQUE_DECL(T)                                                                             \
+    P_UDEQUE_DEF_TYPE(T)                                                                           \
+    P_UDEQUE_DECL(T, ulib_unused)                                                                  \
+    P_UDEQUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Declares a new deque type, prepending a specifier to the generated declarations.
+ *
+ * @param T @ctype{symbol} Deque type.
+ * @param SPEC @ctype{specifier} Specifier.
+ */
+#define UDEQUE_DECL_SPEC(T, SPEC)                                                                  \
+    P_UDEQUE_DEF_TYPE(T)                                                                           \
+    P_UDEQUE_DECL(T, SPEC ulib_unused)                                                             \
+    P_UDEQUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Implements a previously declared deque type.
+ *
+ * @param T @ctype{symbol} Deque type.
+ */
+#define UDEQUE_IMPL(T) P_UDEQUE_IMPL(T, ulib_unused)
+
+/**
+ * Defines a new static deque type.
+ *
+ * @param T @ctype{symbol} Deque type.
+ */
+#define UDEQUE_INIT(T)                                                                             \
+    P_UDEQUE_DEF_TYPE(T)                                                                           \
+    P_UDEQUE_DECL(T, ULIB_INLINE ulib_unused)                                                      \
+    P_UDEQUE_DEF_INLINE(T, ulib_unused)                                                            \
+    P_UDEQUE_IMPL(T, ULIB_INLINE ulib_unused)
+
+/// @}
+
+/**
+ * @defgroup UDeque_api UDeque API
+ * @{
+ */
+
+/**
+ * Initializes a new deque.
+ *
+ * @param T Deque type.
+ * @return Initialized deque instance.
+ *
+ * @destructor{udeque_deinit}
+ * @alias UDeque(T) udeque(symbol T);
+ */
+#define udeque(T) ULIB_MACRO_CONCAT(udeque_, T)()
+
+/**
+ * De-initializes a deque previously initialized via @func{udeque(T)}.
+ *
+ * @param T Deque type.
+ * @param q Deque to deinitialize.
+ *
+ * @alias void udeque_deinit(symbol T, UDeque(T) *q);
+ */
+#define udeque_deinit(T, q) ULIB_MACRO_CONCAT(udeque_deinit_, T)(q)
+
+/**
+ * Removes all the elements in the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ *
+ * @alias void udeque_clear(symbol T, UDeque(T) *q);
+ */
+#define udeque_clear(T, q) ULIB_MACRO_CONCAT(udeque_clear_, T)(q)
+
+/**
+ * Returns the number of elements in the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @return Number of elements.
+ *
+ * @alias ulib_uint udeque_count(symbol T, UDeque(T) const *q);
+ */
+#define udeque_count(T, q) ULIB_MACRO_CONCAT(udeque_count_, T)(q)
+
+/**
+ * Returns the maximum number of elements that can be held by the deque without reallocating.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @return Maximum number of elements.
+ *
+ * @alias ulib_uint udeque_size(symbol T, UDeque(T) const *q);
+ */
+#define udeque_size(T, q) ULIB_MACRO_CONCAT(udeque_size_, T)(q)
+
+/**
+ * Ensures the deque can hold at least as many elements as `size`.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param size Number of elements the deque should be able to hold.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret udeque_reserve(symbol T, UDeque(T) *q, ulib_uint size);
+ */
+#define udeque_reserve(T, q, size) ULIB_MACRO_CONCAT(udeque_reserve_, T)(q, size)
+
+/**
+ * Returns the element at the specified index, counting from the front of the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param idx Index.
+ * @return Element at the specified index.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias T udeque_get(symbol T, UDeque(T) const *q, ulib_uint idx);
+ */
+#define udeque_get(T, q, idx) ULIB_MACRO_CONCAT(udeque_get_, T)(q, idx)
+
+/**
+ * Returns a pointer to the element at the specified index, counting from the front of the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param idx Index.
+ * @return Pointer to the element at the specified index.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias T *udeque_get_ref(symbol T, UDeque(T) const *q, ulib_uint idx);
+ */
+#define udeque_get_ref(T, q, idx) ULIB_MACRO_CONCAT(udeque_get_ref_, T)(q, idx)
+
+/**
+ * Replaces the element at the specified index, counting from the front of the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param idx Index.
+ * @param item Replacement element.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias void udeque_set(symbol T, UDeque(T) *q, ulib_uint idx, T item);
+ */
+#define udeque_set(T, q, idx, item) ULIB_MACRO_CONCAT(udeque_set_, T)(q, idx, item)
+
+/**
+ * Returns the element at the front of the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @return First element.
+ *
+ * @warning Calling this function on an empty deque results in undefined behavior.
+ * @alias T udeque_first(symbol T, UDeque(T) const *q);
+ */
+#define udeque_first(T, q) ULIB_MACRO_CONCAT(udeque_first_, T)(q)
+
+/**
+ * Returns the element at the back of the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @return Last element.
+ *
+ * @warning Calling this function on an empty deque results in undefined behavior.
+ * @alias T udeque_last(symbol T, UDeque(T) const *q);
+ */
+#define udeque_last(T, q) ULIB_MACRO_CONCAT(udeque_last_, T)(q)
+
+/**
+ * Pushes the specified element at the back of the deque.
+ * Amortized performance: *O(1)*
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param item Element to push.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret udeque_push_back(symbol T, UDeque(T) *q, T item);
+ */
+#define udeque_push_back(T, q, item) ULIB_MACRO_CONCAT(udeque_push_back_, T)(q, item)
+
+/**
+ * Pushes the specified element at the front of the deque.
+ * Amortized performance: *O(1)*
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param item Element to push.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret udeque_push_front(symbol T, UDeque(T) *q, T item);
+ */
+#define udeque_push_front(T, q, item) ULIB_MACRO_CONCAT(udeque_push_front_, T)(q, item)
+
+/**
+ * Removes and returns the element at the back of the deque.
+ * Performance: *O(1)*
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param[out] item Removed element.
+ * @return True if an element was removed, false if the deque was empty.
+ *
+ * @alias bool udeque_pop_back(symbol T, UDeque(T) *q, T *item);
+ */
+#define udeque_pop_back(T, q, item) ULIB_MACRO_CONCAT(udeque_pop_back_, T)(q, item)
+
+/**
+ * Removes and returns the element at the front of the deque.
+ * Performance: *O(1)*
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param[out] item Removed element.
+ * @return True if an element was removed, false if the deque was empty.
+ *
+ * @alias bool udeque_pop_front(symbol T, UDeque(T) *q, T *item);
+ */
+#define udeque_pop_front(T, q, item) ULIB_MACRO_CONCAT(udeque_pop_front_, T)(q, item)
+
+/**
+ * Pushes the elements of the specified array at the back of the deque.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param array Array of elements to push.
+ * @param n Number of elements to push.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret udeque_push_back_array(symbol T, UDeque(T) *q, T const *array, ulib_uint n);
+ */
+#define udeque_push_back_array(T, q, array, n)                                                     \
+    ULIB_MACRO_CONCAT(udeque_push_back_array_, T)(q, array, n)
+
+/**
+ * Removes up to `n` elements from the front of the deque, copying them to the specified array.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param[out] array Array receiving the removed elements, or NULL to discard them.
+ * @param n Maximum number of elements to remove.
+ * @return Number of removed elements.
+ *
+ * @alias ulib_uint udeque_pop_front_array(symbol T, UDeque(T) *q, T *array, ulib_uint n);
+ */
+#define udeque_pop_front_array(T, q, array, n)                                                     \
+    ULIB_MACRO_CONCAT(udeque_pop_front_array_, T)(q, array, n)
+
+/**
+ * Returns the contiguous memory regions holding the elements of the deque,
+ * from front to back.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @return Element spans. The second span is empty if the elements do not wrap around.
+ *
+ * @note Spans are invalidated by any operation that modifies the deque.
+ * @alias UDequeSpans(T) udeque_spans(symbol T, UDeque(T) const *q);
+ */
+#define udeque_spans(T, q) ULIB_MACRO_CONCAT(udeque_spans_, T)(q)
+
+/**
+ * Returns the contiguous memory regions following the back of the deque
+ * that are not occupied by elements.
+ *
+ * Usage example:
+ * @code
+ * udeque_reserve(ulib_byte, &q, udeque_count(ulib_byte, &q) + 4096);
+ * UDequeSpans(ulib_byte) s = udeque_free_spans(ulib_byte, &q);
+ * size_t read = fread(s.first, 1, s.first_count, file);
+ * udeque_commit(ulib_byte, &q, (ulib_uint)read);
+ * @endcode
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @return Free spans. Writing to them and calling @func{udeque_commit} appends elements.
+ *
+ * @note Spans are invalidated by any operation that modifies the deque.
+ * @alias UDequeSpans(T) udeque_free_spans(symbol T, UDeque(T) const *q);
+ */
+#define udeque_free_spans(T, q) ULIB_MACRO_CONCAT(udeque_free_spans_, T)(q)
+
+/**
+ * Appends `n` elements previously written to the spans returned by @func{udeque_free_spans}.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param n Number of elements to append.
+ *
+ * @warning `n` must not exceed the total number of elements of the free spans.
+ * @alias void udeque_commit(symbol T, UDeque(T) *q, ulib_uint n);
+ */
+#define udeque_commit(T, q, n) ULIB_MACRO_CONCAT(udeque_commit_, T)(q, n)
+
+/**
+ * Discards `n` elements from the front of the deque, typically after processing them
+ * via the spans returned by @func{udeque_spans}.
+ *
+ * @param T Deque type.
+ * @param q Deque instance.
+ * @param n Number of elements to discard.
+ *
+ * @warning `n` must not exceed the number of elements in the deque.
+ * @alias void udeque_consume(symbol T, UDeque(T) *q, ulib_uint n);
+ */
+#define udeque_consume(T, q, n) ULIB_MACRO_CONCAT(udeque_consume_, T)(q, n)
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UDEQUE_H
@@ -17,6 +17,7 @@
 #include "uhash.h" // IWYU pragma: export
 #include "unumber.h"
 #include "ustring.h"
+#include "ustrpool.h"
 
 ULIB_BEGIN_DECLS
 
@@ -55,6 +56,16 @@ UHASH_DECL_SPEC(ulib_ptr, ulib_ptr, ulib_ptr, ULIB_API)
  */
 UHASH_DECL_SPEC(UString, UString, ulib_ptr, ULIB_API)
 
+/**
+ * @type{UHash(T)} with @type{UStrSym} keys and @type{ulib_ptr} values.
+ *
+ * @note Keys are hashed and compared in constant time, though they must all
+ *       belong to the same @type{UStrPool}.
+ *
+ * @alias typedef struct UHash(UStrSym) UHash(UStrSym);
+ */
+UHASH_DECL_SPEC(UStrSym, UStrSym, ulib_ptr, ULIB_API)
+
 /// @}
 
 ULIB_END_DECLS
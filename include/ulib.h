@@ -19,6 +19,7 @@
 #include "ubit.h"
 #include "ucolor.h"
 #include "udebug.h"
+#include "udeque.h"
 #include "uhash.h"
 #include "uhash_builtin.h"
 #include "uhash_func.h"
@@ -26,18 +27,28 @@
 #include "ulib_ret.h"
 #include "ulog.h"
 #include "umeta.h"
+#include "umultimatch.h"
 #include "unumber.h"
+#include "upackedvec.h"
+#include "upool.h"
+#include "upqueue.h"
+#include "uqueue.h"
 #include "urand.h"
+#include "urope.h"
+#include "usegvec.h"
+#include "usoa.h"
 #include "ustrbuf.h"
 #include "ustream.h"
 #include "ustream_varint.h"
 #include "ustring.h"
 #include "ustring_raw.h"
+#include "ustrpool.h"
 #include "utest.h"
 #include "utime.h"
 #include "uutils.h"
 #include "uvec.h"
 #include "uvec_builtin.h"
+#include "uvec_parallel.h"
 #include "uversion.h"
 #include "uwarning.h"
 
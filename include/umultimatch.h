@@ -0,0 +1,180 @@
+/**
+ * Multi-pattern string matching.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UMULTIMATCH_H
+#define UMULTIMATCH_H
+
+#include "uattrs.h"
+#include "ulib_ret.h"
+#include "unumber.h"
+#include "ustream.h"
+#include "ustring.h"
+#include "uutils.h"
+#include "uvec_builtin.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+ULIB_BEGIN_DECLS
+
+/// @cond
+struct p_umultimatch_out;
+/// @endcond
+
+/**
+ * Multi-pattern matcher.
+ *
+ * Matchers are Aho-Corasick automata, compiled into deterministic finite automata
+ * whose transitions are stored in a single table. Bytes that do not occur in any pattern
+ * share the same column, so that the table stays small, and states that match some pattern
+ * are numbered last, so that matching requires a single table lookup and comparison per byte.
+ * Therefore, searching for any number of patterns takes time linear in the length
+ * of the searched text, plus the number of matches.
+ */
+typedef struct UMultiMatch {
+    /// @cond
+    ulib_uint *_delta;
+    struct p_umultimatch_out *_out;
+    ulib_uint _out_start;
+    ulib_uint _classes;
+    ulib_byte _class[256];
+    /// @endcond
+} UMultiMatch;
+
+/// Occurrence of a pattern.
+typedef struct UMultiMatchHit {
+    /// Index of the pattern.
+    ulib_uint pattern;
+
+    /// Start offset of the occurrence.
+    size_t start;
+
+    /// Length of the occurrence.
+    size_t length;
+} UMultiMatchHit;
+
+/**
+ * Incremental scan of a text, which can be provided in chunks.
+ *
+ * @note Scans can outlive the chunks they have been fed, but they must not outlive
+ *       their matcher.
+ */
+typedef struct UMultiMatchScan {
+    /// @cond
+    UMultiMatch const *_mm;
+    unsigned char const *_buf;
+    size_t _length;
+    size_t _pos;
+    size_t _offset;
+    size_t _end;
+    ulib_uint _state;
+    ulib_uint _out;
+    /// @endcond
+} UMultiMatchScan;
+
+/**
+ * @defgroup UMultiMatch UMultiMatch API
+ * @{
+ */
+
+/**
+ * Initializes a new matcher for the specified patterns.
+ *
+ * @param mm Matcher.
+ * @param patterns Patterns.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if some pattern is empty, or if the automaton
+ *         would have too many states, otherwise @val{ULIB_ERR_MEM}.
+ *
+ * @destructor{umultimatch_deinit}
+ * @note The matcher does not reference the patterns, so they can be deinitialized afterwards.
+ */
+ULIB_API
+ulib_ret umultimatch_init(UMultiMatch *mm, UVec(UString) const *patterns);
+
+/**
+ * Deinitializes a matcher.
+ *
+ * @param mm Matcher.
+ */
+ULIB_API
+void umultimatch_deinit(UMultiMatch *mm);
+
+/**
+ * Returns the occurrence of a pattern in the string that ends first.
+ *
+ * @param mm Matcher.
+ * @param string String.
+ * @param[out] hit Occurrence, can be NULL.
+ * @return True if the string contains some pattern, false otherwise.
+ *
+ * @note If multiple patterns end at the same position, the longest one is returned.
+ */
+ULIB_API
+bool umultimatch_find(UMultiMatch const *mm, UString string, UMultiMatchHit *hit);
+
+/**
+ * Starts a new scan.
+ *
+ * @param mm Matcher.
+ * @return Scan.
+ */
+ULIB_INLINE
+UMultiMatchScan umultimatch_scan(UMultiMatch const *mm) {
+    UMultiMatchScan scan = ulib_struct_init;
+    scan._mm = mm;
+    return scan;
+}
+
+/**
+ * Feeds the next chunk of text to the scan.
+ *
+ * @param scan Scan.
+ * @param buf Chunk, which must stay valid until @func{umultimatch_scan_next} returns false.
+ * @param length Length of the chunk.
+ *
+ * @note Offsets of occurrences are relative to the start of the first chunk, and occurrences
+ *       spanning multiple chunks are found as well.
+ */
+ULIB_API
+void umultimatch_scan_feed(UMultiMatchScan *scan, void const *buf, size_t length);
+
+/**
+ * Reads the next chunk of text from a stream and feeds it to the scan.
+ *
+ * @param scan Scan.
+ * @param stream Input stream.
+ * @param buf Buffer that holds the chunk, which must stay valid until
+ *            @func{umultimatch_scan_next} returns false.
+ * @param size Size of the buffer.
+ * @param[out] read Number of bytes read, zero if the stream has been exhausted.
+ * @return Return code.
+ */
+ULIB_API
+ustream_ret umultimatch_scan_read(UMultiMatchScan *scan, UIStream *stream, void *buf, size_t size,
+                                  size_t *read);
+
+/**
+ * Returns the next occurrence of a pattern in the chunks fed to the scan.
+ *
+ * @param scan Scan.
+ * @param[out] hit Occurrence.
+ * @return True if an occurrence has been found, false if the current chunk has been exhausted.
+ *
+ * @note Occurrences are returned by increasing end offset, and by decreasing length
+ *       if they end at the same offset. Overlapping occurrences are all returned.
+ */
+ULIB_API
+bool umultimatch_scan_next(UMultiMatchScan *scan, UMultiMatchHit *hit);
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UMULTIMATCH_H
@@ -0,0 +1,222 @@
+/**
+ * A bit-packed vector of unsigned integers.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UPACKEDVEC_H
+#define UPACKEDVEC_H
+
+#include "uattrs.h"
+#include "unumber.h"
+#include "uutils.h"
+#include "uvec_builtin.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+ULIB_BEGIN_DECLS
+
+/**
+ * Bit-packed vector of @type{ulib_uint} elements.
+ *
+ * Elements are stored as fixed-width offsets from a frame of reference, using the minimum
+ * number of bits needed to represent the range of the elements. The bit width is chosen
+ * when the vector is built, after which the vector is immutable.
+ *
+ * Packed vectors built from sorted data store the differences between consecutive elements
+ * instead, which are usually much smaller than the elements themselves. In this mode, the
+ * absolute value of one every @val{UPACKEDVEC_BLOCK_SIZE} elements is stored separately,
+ * so that random access decodes a bounded number of differences.
+ */
+typedef struct UPackedVec {
+    /// @cond
+    uint64_t *_words;
+    ulib_uint *_anchors;
+    ulib_uint _count;
+    ulib_uint _base;
+    ulib_byte _bits;
+    /// @endcond
+} UPackedVec;
+
+/**
+ * @defgroup UPackedVec_constants UPackedVec constants
+ * @{
+ */
+
+/// Number of elements between absolute values in packed vectors built from sorted data.
+#ifndef UPACKEDVEC_BLOCK_SIZE
+#define UPACKEDVEC_BLOCK_SIZE 64
+#endif
+
+/// @}
+
+/**
+ * @defgroup UPackedVec_api UPackedVec API
+ * @{
+ */
+
+/**
+ * Initializes a new, empty packed vector.
+ *
+ * @return Initialized packed vector.
+ *
+ * @destructor{upackedvec_deinit}
+ */
+ULIB_CONST
+ULIB_INLINE
+UPackedVec upackedvec(void) {
+    UPackedVec vec = ulib_struct_init;
+    return vec;
+}
+
+/**
+ * Deinitializes a packed vector.
+ *
+ * @param vec Packed vector.
+ */
+ULIB_API
+void upackedvec_deinit(UPackedVec *vec);
+
+/**
+ * Packs the elements of the specified array, replacing the contents of the packed vector.
+ *
+ * @param vec Packed vector.
+ * @param array Array of elements.
+ * @param n Number of elements.
+ * @return Return code.
+ */
+ULIB_API
+uvec_ret upackedvec_build(UPackedVec *vec, ulib_uint const *array, ulib_uint n);
+
+/**
+ * Packs the elements of the specified sorted array by storing the differences
+ * between consecutive elements, replacing the contents of the packed vector.
+ *
+ * @param vec Packed vector.
+ * @param array Array of elements, sorted in ascending order.
+ * @param n Number of elements.
+ * @return @val{UVEC_OK} on success, @val{UVEC_NO} if the array is not sorted,
+ *         otherwise @val{UVEC_ERR}.
+ */
+ULIB_API
+uvec_ret upackedvec_build_sorted(UPackedVec *vec, ulib_uint const *array, ulib_uint n);
+
+/**
+ * Returns the number of elements in the packed vector.
+ *
+ * @param vec Packed vector.
+ * @return Number of elements.
+ */
+ULIB_PURE
+ULIB_INLINE
+ulib_uint upackedvec_count(UPackedVec const *vec) {
+    return vec->_count;
+}
+
+/**
+ * Returns the number of bits used to store each element of the packed vector.
+ *
+ * @param vec Packed vector.
+ * @return Number of bits.
+ */
+ULIB_PURE
+ULIB_INLINE
+unsigned upackedvec_bits(UPackedVec const *vec) {
+    return vec->_bits;
+}
+
+/**
+ * Checks whether the packed vector stores differences between consecutive elements.
+ *
+ * @param vec Packed vector.
+ * @return True if the vector has been built via @func{upackedvec_build_sorted},
+ *         false otherwise.
+ */
+ULIB_PURE
+ULIB_INLINE
+bool upackedvec_is_delta(UPackedVec const *vec) {
+    return vec->_anchors != NULL;
+}
+
+/**
+ * Returns the amount of memory used by the elements of the packed vector.
+ *
+ * @param vec Packed vector.
+ * @return Memory footprint (B).
+ */
+ULIB_API
+ULIB_PURE
+size_t upackedvec_memory(UPackedVec const *vec);
+
+/// @cond
+ULIB_PURE
+ULIB_INLINE
+uint64_t p_upackedvec_read(uint64_t const *words, size_t pos, unsigned bits) {
+    if (!bits) return 0;
+    size_t const w = pos / 64;
+    unsigned const off = (unsigned)(pos % 64);
+    // The trailing padding word allows reading the next word unconditionally.
+    uint64_t const v = (words[w] >> off) | ((words[w + 1] << 1) << (63 - off));
+    return v & (UINT64_MAX >> (64 - bits));
+}
+
+ULIB_API
+ULIB_PURE
+ulib_uint p_upackedvec_get_delta(UPackedVec const *vec, ulib_uint idx);
+/// @endcond
+
+/**
+ * Returns the element at the specified index.
+ *
+ * @param vec Packed vector.
+ * @param idx Index.
+ * @return Element at the specified index.
+ *
+ * @note This takes constant time, except for vectors built from sorted data, for which it
+ *       decodes up to @val{UPACKEDVEC_BLOCK_SIZE} differences, starting from the closest
+ *       preceding block anchor. Prefer @func{upackedvec_unpack} to access consecutive elements.
+ */
+ULIB_PURE
+ULIB_INLINE
+ulib_uint upackedvec_get(UPackedVec const *vec, ulib_uint idx) {
+    if (vec->_anchors) return p_upackedvec_get_delta(vec, idx);
+    return vec->_base + (ulib_uint)p_upackedvec_read(vec->_words, (size_t)idx * vec->_bits,
+                                                     vec->_bits);
+}
+
+/**
+ * Unpacks a range of elements into the specified array.
+ *
+ * @param vec Packed vector.
+ * @param start Range start index.
+ * @param n Number of elements.
+ * @param[out] array Array of at least `n` elements.
+ *
+ * @note This is much faster than retrieving elements one by one, especially for
+ *       packed vectors built from sorted data. On x86-64 CPUs supporting AVX2,
+ *       32-bit elements are decoded eight at a time.
+ */
+ULIB_API
+void upackedvec_unpack(UPackedVec const *vec, ulib_uint start, ulib_uint n, ulib_uint *array);
+
+/**
+ * Appends all the elements of the packed vector to the specified vector.
+ *
+ * @param vec Packed vector.
+ * @param dest Destination vector.
+ * @return Return code.
+ */
+ULIB_API
+uvec_ret upackedvec_to_uvec(UPackedVec const *vec, UVec(ulib_uint) *dest);
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UPACKEDVEC_H
@@ -0,0 +1,171 @@
+/**
+ * Work-stealing thread pool.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UPOOL_H
+#define UPOOL_H
+
+#include "uattrs.h"
+#include "ulib_ret.h"
+#include "unumber.h"
+
+ULIB_BEGIN_DECLS
+
+/**
+ * @defgroup pool Thread pool
+ * @{
+ */
+
+/**
+ * Thread pool.
+ *
+ * The pool owns a fixed set of worker threads, each with its own mutex-guarded task deque.
+ * Workers execute their own tasks in LIFO order, and steal tasks from the opposite end
+ * of the deques of other workers when they run out of work. Threads that wait
+ * for tasks to complete take part in their execution, and sleep once the remaining tasks
+ * are all running on other threads.
+ *
+ * @note If uLib is built without thread support (**ULIB_NO_THREADS**),
+ *       pools have no workers and all tasks are executed by the waiting thread.
+ */
+typedef struct UPool UPool;
+
+/**
+ * Group of tasks that can be waited upon.
+ */
+typedef struct UPoolGroup UPoolGroup;
+
+/**
+ * Task function.
+ *
+ * @param ctx Task context.
+ */
+typedef void (*upool_task_fn)(void *ctx);
+
+/**
+ * Range function, invoked on subranges by @func{upool_parallel_for}.
+ *
+ * @param ctx Context.
+ * @param start Start of the subrange.
+ * @param len Length of the subrange.
+ */
+typedef void (*upool_range_fn)(void *ctx, ulib_uint start, ulib_uint len);
+
+/**
+ * Creates a new thread pool.
+ *
+ * @param threads Number of worker threads. If zero, the number of available
+ *                processors, minus one to account for the calling thread.
+ * @return New thread pool, or NULL on error.
+ *
+ * @destructor{upool_free}
+ */
+ULIB_API
+UPool *upool_new(unsigned threads);
+
+/**
+ * Stops the workers of the specified pool and releases its resources.
+ *
+ * @param pool Thread pool.
+ *
+ * @warning All task groups must be joined before calling this function.
+ */
+ULIB_API
+void upool_free(UPool *pool);
+
+/**
+ * Returns the number of worker threads of the pool.
+ *
+ * @param pool Thread pool.
+ * @return Number of worker threads.
+ */
+ULIB_API
+ULIB_PURE
+unsigned upool_threads(UPool const *pool);
+
+/**
+ * Returns the number of processors available to the process.
+ *
+ * @return Number of processors.
+ */
+ULIB_API
+unsigned upool_processors(void);
+
+/**
+ * Creates a new task group.
+ *
+ * @param pool Thread pool that executes the tasks of the group.
+ * @return New task group, or NULL on error.
+ *
+ * @destructor{upool_group_free}
+ */
+ULIB_API
+UPoolGroup *upool_group_new(UPool *pool);
+
+/**
+ * Waits for all the tasks of the group to complete, then releases the group.
+ *
+ * @param group Task group.
+ */
+ULIB_API
+void upool_group_free(UPoolGroup *group);
+
+/**
+ * Schedules a new task within the specified group.
+ *
+ * @param group Task group.
+ * @param fn Task function.
+ * @param ctx Task context.
+ * @return Return code.
+ *
+ * @note Tasks may spawn further tasks within the same group.
+ */
+ULIB_API
+ulib_ret upool_group_spawn(UPoolGroup *group, upool_task_fn fn, void *ctx);
+
+/**
+ * Waits for all the tasks of the group, including the ones they spawned, to complete.
+ *
+ * @param group Task group.
+ *
+ * @note The calling thread executes pending tasks while it waits, and blocks
+ *       when the remaining ones are running on other threads.
+ */
+ULIB_API
+void upool_group_join(UPoolGroup *group);
+
+/**
+ * Invokes the specified function on subranges of `[start, start + len)`, in parallel.
+ *
+ * The range is recursively split in halves until subranges contain at most `grain` elements,
+ * so that idle workers can steal large chunks of work.
+ *
+ * @param pool Thread pool, or NULL to execute the loop on the calling thread.
+ * @param start Start of the range.
+ * @param len Length of the range.
+ * @param grain Maximum length of subranges. If zero, it is chosen based on the number
+ *              of workers.
+ * @param fn Function invoked on each subrange.
+ * @param ctx Context passed to the function.
+ * @return Return code. On error, no subrange has been processed.
+ *
+ * @note Subranges are disjoint, and cover the whole range. The function returns
+ *       once all of them have been processed. Subranges that cannot be scheduled
+ *       are processed by the thread that attempted to split them.
+ */
+ULIB_API
+ulib_ret upool_parallel_for(UPool *pool, ulib_uint start, ulib_uint len, ulib_uint grain,
+                            upool_range_fn fn, void *ctx);
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UPOOL_H
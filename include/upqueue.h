@@ -0,0 +1,514 @@
+/**
+ * A type-safe, generic C indexed priority queue.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UPQUEUE_H
+#define UPQUEUE_H
+
+#include "uattrs.h"
+#include "unumber.h"
+#include "uutils.h"
+#include "uvec.h"
+#include "uvec_builtin.h"
+
+ULIB_BEGIN_DECLS
+
+// Types
+
+/**
+ * References a specific priority queue type.
+ *
+ * @param T Priority queue type.
+ */
+#define UPQueue(T) ULIB_MACRO_CONCAT(UPQueue_, T)
+
+/**
+ * Generic indexed priority queue type.
+ *
+ * Elements are stored in a d-ary heap backed by a @type{UVec}, alongside a position index
+ * that maps each element handle to its heap slot. This allows updating the priority of an
+ * element, or removing it, in *O(log n)* given its handle.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{UPQueue(T)} macro to reference a specific priority queue type.
+ * @alias typedef struct UPQueue(T) UPQueue(T);
+ */
+
+/**
+ * Priority queue type forward declaration.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ */
+#define upqueue_decl(T) typedef struct UPQueue(T) UPQueue(T)
+
+/**
+ * @defgroup UPQueue_constants UPQueue constants
+ * @{
+ */
+
+/// Number of children of each node of the heap.
+#ifndef UPQUEUE_ARITY
+#define UPQUEUE_ARITY 4
+#endif
+
+/// Handle that does not reference any element.
+#define UPQUEUE_HANDLE_NONE ULIB_UINT_MAX
+
+/// @}
+
+#define P_UPQUEUE_FREE_FLAG (ULIB_UINT_MAX ^ (ULIB_UINT_MAX >> 1U))
+#define P_UPQueue_Entry(T) ULIB_MACRO_CONCAT(p_upqueue_entry_, T)
+
+/*
+ * Defines a new priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ */
+#define P_UPQUEUE_DEF_TYPE(T)                                                                      \
+    /** @cond */                                                                                   \
+    typedef struct p_upqueue_entry_##T {                                                           \
+        T item;                                                                                    \
+        ulib_uint handle;                                                                          \
+    } p_upqueue_entry_##T;                                                                         \
+    /** @endcond */
+
+/*
+ * Defines the priority queue struct, once its backing vector type has been declared.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ */
+#define P_UPQUEUE_DEF_STRUCT(T)                                                                    \
+    typedef struct UPQueue_##T {                                                                   \
+        /** @cond */                                                                               \
+        UVec(p_upqueue_entry_##T) _heap;                                                           \
+        UVec(ulib_uint) _pos;                                                                      \
+        ulib_uint _free;                                                                           \
+        /** @endcond */                                                                            \
+    } UPQueue_##T;
+
+/*
+ * Generates function declarations for the specified priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the declarations.
+ */
+#define P_UPQUEUE_DECL(T, ATTRS)                                                                   \
+    /** @cond */                                                                                   \
+    ATTRS uvec_ret upqueue_push_##T(UPQueue_##T *q, T item, ulib_uint *handle);                    \
+    ATTRS bool upqueue_pop_##T(UPQueue_##T *q, T *item, ulib_uint *handle);                        \
+    ATTRS void upqueue_update_priority_##T(UPQueue_##T *q, ulib_uint handle, T item);              \
+    ATTRS bool upqueue_remove_##T(UPQueue_##T *q, ulib_uint handle, T *item);                      \
+    /** @endcond */
+
+/*
+ * Generates inline function definitions for the specified priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_UPQUEUE_DEF_INLINE(T, ATTRS)                                                             \
+    /** @cond */                                                                                   \
+    ATTRS ULIB_INLINE UPQueue_##T upqueue_##T(void) {                                              \
+        UPQueue_##T q;                                                                             \
+        q._heap = uvec(p_upqueue_entry_##T);                                                       \
+        q._pos = uvec(ulib_uint);                                                                  \
+        q._free = 0;                                                                               \
+        return q;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void upqueue_deinit_##T(UPQueue_##T *q) {                                    \
+        uvec_deinit(p_upqueue_entry_##T, &q->_heap);                                               \
+        uvec_deinit(ulib_uint, &q->_pos);                                                          \
+        q->_free = 0;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void upqueue_clear_##T(UPQueue_##T *q) {                                     \
+        uvec_clear(p_upqueue_entry_##T, &q->_heap);                                                \
+        uvec_clear(ulib_uint, &q->_pos);                                                           \
+        q->_free = 0;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint upqueue_count_##T(UPQueue_##T const *q) {                \
+        return uvec_count(p_upqueue_entry_##T, &q->_heap);                                         \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T upqueue_top_##T(UPQueue_##T const *q) {                          \
+        return uvec_first(p_upqueue_entry_##T, &q->_heap).item;                                    \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint upqueue_top_handle_##T(UPQueue_##T const *q) {           \
+        return uvec_first(p_upqueue_entry_##T, &q->_heap).handle;                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE bool upqueue_contains_##T(UPQueue_##T const *q,                    \
+                                                          ulib_uint handle) {                      \
+        return handle < uvec_count(ulib_uint, &q->_pos) &&                                         \
+               !(uvec_get(ulib_uint, &q->_pos, handle) & P_UPQUEUE_FREE_FLAG);                     \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T upqueue_get_##T(UPQueue_##T const *q, ulib_uint handle) {        \
+        ulib_uint const i = uvec_get(ulib_uint, &q->_pos, handle);                                 \
+        return uvec_get(p_upqueue_entry_##T, &q->_heap, i).item;                                   \
+    }                                                                                              \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ * @param compare_func @ctype{(T, T) -> bool} Comparison function.
+ */
+#define P_UPQUEUE_IMPL(T, ATTRS, compare_func)                                                     \
+                                                                                                   \
+    ULIB_INLINE void p_upqueue_sift_up_##T(UPQueue_##T *q, ulib_uint i) {                          \
+        p_upqueue_entry_##T *heap = uvec_data(p_upqueue_entry_##T, &q->_heap);                     \
+        ulib_uint *pos = uvec_data(ulib_uint, &q->_pos);                                           \
+        p_upqueue_entry_##T e = heap[i];                                                           \
+                                                                                                   \
+        while (i) {                                                                                \
+            ulib_uint const p = (i - 1) / UPQUEUE_ARITY;                                           \
+            if (!compare_func(e.item, heap[p].item)) break;                                        \
+            heap[i] = heap[p];                                                                     \
+            pos[heap[i].handle] = i;                                                               \
+            i = p;                                                                                 \
+        }                                                                                          \
+                                                                                                   \
+        heap[i] = e;                                                                               \
+        pos[e.handle] = i;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_upqueue_sift_down_##T(UPQueue_##T *q, ulib_uint i) {                        \
+        p_upqueue_entry_##T *heap = uvec_data(p_upqueue_entry_##T, &q->_heap);                     \
+        ulib_uint *pos = uvec_data(ulib_uint, &q->_pos);                                           \
+        ulib_uint const count = uvec_count(p_upqueue_entry_##T, &q->_heap);                        \
+        p_upqueue_entry_##T e = heap[i];                                                           \
+                                                                                                   \
+        while (true) {                                                                             \
+            ulib_uint const first = i * UPQUEUE_ARITY + 1;                                         \
+            if (first >= count) break;                                                             \
+                                                                                                   \
+            ulib_uint const last = ulib_min(first + UPQUEUE_ARITY, count);                         \
+            ulib_uint best = first;                                                                \
+                                                                                                   \
+            for (ulib_uint c = first + 1; c < last; ++c) {                                         \
+                if (compare_func(heap[c].item, heap[best].item)) best = c;                         \
+            }                                                                                      \
+                                                                                                   \
+            if (!compare_func(heap[best].item, e.item)) break;                                     \
+            heap[i] = heap[best];                                                                  \
+            pos[heap[i].handle] = i;                                                               \
+            i = best;                                                                              \
+        }                                                                                          \
+                                                                                                   \
+        heap[i] = e;                                                                               \
+        pos[e.handle] = i;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_upqueue_sift_##T(UPQueue_##T *q, ulib_uint i) {                             \
+        p_upqueue_entry_##T *heap = uvec_data(p_upqueue_entry_##T, &q->_heap);                     \
+        if (i && compare_func(heap[i].item, heap[(i - 1) / UPQUEUE_ARITY].item)) {                 \
+            p_upqueue_sift_up_##T(q, i);                                                           \
+        } else {                                                                                   \
+            p_upqueue_sift_down_##T(q, i);                                                         \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE p_upqueue_entry_##T p_upqueue_remove_at_##T(UPQueue_##T *q, ulib_uint i) {         \
+        p_upqueue_entry_##T *heap = uvec_data(p_upqueue_entry_##T, &q->_heap);                     \
+        ulib_uint *pos = uvec_data(ulib_uint, &q->_pos);                                           \
+        p_upqueue_entry_##T const e = heap[i];                                                     \
+        p_upqueue_entry_##T last;                                                                  \
+                                                                                                   \
+        uvec_pop(p_upqueue_entry_##T, &q->_heap, &last);                                           \
+        pos[e.handle] = P_UPQUEUE_FREE_FLAG | q->_free;                                            \
+        q->_free = e.handle + 1;                                                                   \
+                                                                                                   \
+        if (i < uvec_count(p_upqueue_entry_##T, &q->_heap)) {                                      \
+            heap[i] = last;                                                                        \
+            pos[last.handle] = i;                                                                  \
+            p_upqueue_sift_##T(q, i);                                                              \
+        }                                                                                          \
+                                                                                                   \
+        return e;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret upqueue_push_##T(UPQueue_##T *q, T item, ulib_uint *handle) {                   \
+        ulib_uint const i = uvec_count(p_upqueue_entry_##T, &q->_heap);                            \
+        ulib_uint h;                                                                               \
+                                                                                                   \
+        if (q->_free) {                                                                            \
+            h = q->_free - 1;                                                                      \
+        } else {                                                                                   \
+            h = uvec_count(ulib_uint, &q->_pos);                                                   \
+            if (uvec_push(ulib_uint, &q->_pos, i)) return UVEC_ERR;                                \
+        }                                                                                          \
+                                                                                                   \
+        p_upqueue_entry_##T e;                                                                     \
+        e.item = item;                                                                             \
+        e.handle = h;                                                                              \
+                                                                                                   \
+        if (uvec_push(p_upqueue_entry_##T, &q->_heap, e)) {                                        \
+            if (!q->_free) uvec_pop(ulib_uint, &q->_pos, NULL);                                    \
+            return UVEC_ERR;                                                                       \
+        }                                                                                          \
+                                                                                                   \
+        if (q->_free) q->_free = uvec_get(ulib_uint, &q->_pos, h) & ~P_UPQUEUE_FREE_FLAG;          \
+                                                                                                   \
+        p_upqueue_sift_up_##T(q, i);                                                               \
+        if (handle) *handle = h;                                                                   \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS bool upqueue_pop_##T(UPQueue_##T *q, T *item, ulib_uint *handle) {                       \
+        if (!uvec_count(p_upqueue_entry_##T, &q->_heap)) return false;                             \
+        p_upqueue_entry_##T const e = p_upqueue_remove_at_##T(q, 0);                               \
+        if (item) *item = e.item;                                                                  \
+        if (handle) *handle = e.handle;                                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void upqueue_update_priority_##T(UPQueue_##T *q, ulib_uint handle, T item) {             \
+        ulib_uint const i = uvec_get(ulib_uint, &q->_pos, handle);                                 \
+        uvec_data(p_upqueue_entry_##T, &q->_heap)[i].item = item;                                  \
+        p_upqueue_sift_##T(q, i);                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS bool upqueue_remove_##T(UPQueue_##T *q, ulib_uint handle, T *item) {                     \
+        if (!upqueue_contains_##T(q, handle)) return false;                                        \
+        ulib_uint const i = uvec_get(ulib_uint, &q->_pos, handle);                                 \
+        p_upqueue_entry_##T const e = p_upqueue_remove_at_##T(q, i);                               \
+        if (item) *item = e.item;                                                                  \
+        return true;                                                                               \
+    }
+
+/**
+ * @defgroup UPQueue_definitions UPQueue type definitions
+ * @{
+ */
+
+/**
+ * Declares a new priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ *
+ * @note This also declares the vector type backing the heap.
+ */
+#define UPQUEUE_DECL(T)                                                                            \
+    P_UPQUEUE_DEF_TYPE(T)                                                                          \
+    UVEC_DECL(P_UPQueue_Entry(T))                                                                  \
+    P_UPQUEUE_DEF_STRUCT(T)                                                                        \
+    P_UPQUEUE_DECL(T, ulib_unused)                                                                 \
+    P_UPQUEUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Declares a new priority queue type, prepending a specifier to the generated declarations.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ * @param SPEC @ctype{specifier} Specifier.
+ */
+#define UPQUEUE_DECL_SPEC(T, SPEC)                                                                 \
+    P_UPQUEUE_DEF_TYPE(T)                                                                          \
+    UVEC_DECL_SPEC(P_UPQueue_Entry(T), SPEC)                                                       \
+    P_UPQUEUE_DEF_STRUCT(T)                                                                        \
+    P_UPQUEUE_DECL(T, SPEC ulib_unused)                                                            \
+    P_UPQUEUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Implements a previously declared priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ * @param compare_func @ctype{(T, T) -> bool} Comparison function or expression,
+ *                     returning true if the first element has higher priority than the second.
+ *
+ * @note Passing @func{ulib_lt} results in a min-priority queue, while @func{ulib_gt}
+ *       results in a max-priority queue.
+ */
+#define UPQUEUE_IMPL(T, compare_func)                                                              \
+    UVEC_IMPL(P_UPQueue_Entry(T))                                                                  \
+    P_UPQUEUE_IMPL(T, ulib_unused, compare_func)
+
+/**
+ * Defines a new static priority queue type.
+ *
+ * @param T @ctype{symbol} Priority queue type.
+ * @param compare_func @ctype{(T, T) -> bool} Comparison function or expression,
+ *                     returning true if the first element has higher priority than the second.
+ */
+#define UPQUEUE_INIT(T, compare_func)                                                              \
+    P_UPQUEUE_DEF_TYPE(T)                                                                          \
+    UVEC_INIT(P_UPQueue_Entry(T))                                                                  \
+    P_UPQUEUE_DEF_STRUCT(T)                                                                        \
+    P_UPQUEUE_DECL(T, ULIB_INLINE ulib_unused)                                                     \
+    P_UPQUEUE_DEF_INLINE(T, ulib_unused)                                                           \
+    P_UPQUEUE_IMPL(T, ULIB_INLINE ulib_unused, compare_func)
+
+/// @}
+
+/**
+ * @defgroup UPQueue_api UPQueue API
+ * @{
+ */
+
+/**
+ * Initializes a new priority queue.
+ *
+ * @param T Priority queue type.
+ * @return Initialized priority queue instance.
+ *
+ * @destructor{upqueue_deinit}
+ * @alias UPQueue(T) upqueue(symbol T);
+ */
+#define upqueue(T) ULIB_MACRO_CONCAT(upqueue_, T)()
+
+/**
+ * De-initializes a priority queue previously initialized via @func{upqueue(T)}.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue to deinitialize.
+ *
+ * @alias void upqueue_deinit(symbol T, UPQueue(T) *q);
+ */
+#define upqueue_deinit(T, q) ULIB_MACRO_CONCAT(upqueue_deinit_, T)(q)
+
+/**
+ * Removes all the elements in the priority queue, invalidating all handles.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ *
+ * @alias void upqueue_clear(symbol T, UPQueue(T) *q);
+ */
+#define upqueue_clear(T, q) ULIB_MACRO_CONCAT(upqueue_clear_, T)(q)
+
+/**
+ * Returns the number of elements in the priority queue.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @return Number of elements.
+ *
+ * @alias ulib_uint upqueue_count(symbol T, UPQueue(T) const *q);
+ */
+#define upqueue_count(T, q) ULIB_MACRO_CONCAT(upqueue_count_, T)(q)
+
+/**
+ * Returns the element with the highest priority.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @return Element with the highest priority.
+ *
+ * @warning Calling this function on an empty priority queue results in undefined behavior.
+ * @alias T upqueue_top(symbol T, UPQueue(T) const *q);
+ */
+#define upqueue_top(T, q) ULIB_MACRO_CONCAT(upqueue_top_, T)(q)
+
+/**
+ * Returns the handle of the element with the highest priority.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @return Handle of the element with the highest priority.
+ *
+ * @warning Calling this function on an empty priority queue results in undefined behavior.
+ * @alias ulib_uint upqueue_top_handle(symbol T, UPQueue(T) const *q);
+ */
+#define upqueue_top_handle(T, q) ULIB_MACRO_CONCAT(upqueue_top_handle_, T)(q)
+
+/**
+ * Checks whether the specified handle references an element in the priority queue.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @param handle Element handle.
+ * @return True if the handle is valid, false otherwise.
+ *
+ * @alias bool upqueue_contains(symbol T, UPQueue(T) const *q, ulib_uint handle);
+ */
+#define upqueue_contains(T, q, handle) ULIB_MACRO_CONCAT(upqueue_contains_, T)(q, handle)
+
+/**
+ * Returns the element referenced by the specified handle.
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @param handle Element handle.
+ * @return Element referenced by the handle.
+ *
+ * @warning Passing an invalid handle results in undefined behavior.
+ * @alias T upqueue_get(symbol T, UPQueue(T) const *q, ulib_uint handle);
+ */
+#define upqueue_get(T, q, handle) ULIB_MACRO_CONCAT(upqueue_get_, T)(q, handle)
+
+/**
+ * Pushes an element in the priority queue.
+ * Average performance: *O(log n)*
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @param item Element to push.
+ * @param[out] handle Handle of the pushed element.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note Handles are stable until the element is popped or removed,
+ *       after which they may be reused by subsequent pushes.
+ * @alias uvec_ret upqueue_push(symbol T, UPQueue(T) *q, T item, ulib_uint *handle);
+ */
+#define upqueue_push(T, q, item, handle) ULIB_MACRO_CONCAT(upqueue_push_, T)(q, item, handle)
+
+/**
+ * Pops the element with the highest priority.
+ * Average performance: *O(log n)*
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @param[out] item Popped element.
+ * @param[out] handle Handle of the popped element.
+ * @return True if an element was popped, false if the priority queue was empty.
+ *
+ * @alias bool upqueue_pop(symbol T, UPQueue(T) *q, T *item, ulib_uint *handle);
+ */
+#define upqueue_pop(T, q, item, handle) ULIB_MACRO_CONCAT(upqueue_pop_, T)(q, item, handle)
+
+/**
+ * Replaces the element referenced by the specified handle, updating its priority.
+ * Average performance: *O(log n)*
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @param handle Element handle.
+ * @param item New element.
+ *
+ * @warning Passing an invalid handle results in undefined behavior.
+ * @alias void upqueue_update_priority(symbol T, UPQueue(T) *q, ulib_uint handle, T item);
+ */
+#define upqueue_update_priority(T, q, handle, item)                                                \
+    ULIB_MACRO_CONCAT(upqueue_update_priority_, T)(q, handle, item)
+
+/**
+ * Removes the element referenced by the specified handle.
+ * Average performance: *O(log n)*
+ *
+ * @param T Priority queue type.
+ * @param q Priority queue instance.
+ * @param handle Element handle.
+ * @param[out] item Removed element.
+ * @return True if the element was removed, false if the handle was invalid.
+ *
+ * @alias bool upqueue_remove(symbol T, UPQueue(T) *q, ulib_uint handle, T *item);
+ */
+#define upqueue_remove(T, q, handle, item) ULIB_MACRO_CONCAT(upqueue_remove_, T)(q, handle, item)
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UPQUEUE_H
@@ -0,0 +1,703 @@
+/**
+ * Type-safe, generic C lock-free bounded queues.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UQUEUE_H
+#define UQUEUE_H
+
+#include "ualloc.h"
+#include "uattrs.h"
+#include "unumber.h"
+#include "uutils.h"
+#include "uvec.h"
+
+#ifdef __cplusplus
+#include <atomic>
+#define P_UQueue_Atomic(T) std::atomic<T>
+#define p_uqueue_init(obj, val) std::atomic_init(obj, val)
+#define p_uqueue_load(obj, order) std::atomic_load_explicit(obj, std::memory_order_##order)
+#define p_uqueue_store(obj, val, order)                                                            \
+    std::atomic_store_explicit(obj, val, std::memory_order_##order)
+#define p_uqueue_cas(obj, exp, val)                                                                \
+    std::atomic_compare_exchange_weak_explicit(obj, exp, val, std::memory_order_relaxed,           \
+                                               std::memory_order_relaxed)
+#elif !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define P_UQueue_Atomic(T) _Atomic(T)
+#define p_uqueue_init(obj, val) atomic_init(obj, val)
+#define p_uqueue_load(obj, order) atomic_load_explicit(obj, memory_order_##order)
+#define p_uqueue_store(obj, val, order) atomic_store_explicit(obj, val, memory_order_##order)
+#define p_uqueue_cas(obj, exp, val)                                                                \
+    atomic_compare_exchange_weak_explicit(obj, exp, val, memory_order_relaxed,                     \
+                                          memory_order_relaxed)
+#endif
+
+#ifdef P_UQueue_Atomic
+
+ULIB_BEGIN_DECLS
+
+// Types
+
+/**
+ * References a specific single-producer, single-consumer queue type.
+ *
+ * @param T Queue type.
+ */
+#define USpscQueue(T) ULIB_MACRO_CONCAT(USpscQueue_, T)
+
+/**
+ * Generic lock-free bounded single-producer, single-consumer queue type.
+ *
+ * One thread may push elements while another thread pops them, without locking.
+ * The producer and consumer indices live on separate cache lines,
+ * and each side caches the index of the other to minimize cache line transfers.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{USpscQueue(T)} macro to reference a specific queue type.
+ * @alias typedef struct USpscQueue(T) USpscQueue(T);
+ */
+
+/**
+ * References a specific multi-producer, multi-consumer queue type.
+ *
+ * @param T Queue type.
+ */
+#define UMpmcQueue(T) ULIB_MACRO_CONCAT(UMpmcQueue_, T)
+
+/**
+ * Generic lock-free bounded multi-producer, multi-consumer queue type.
+ *
+ * Any number of threads may concurrently push and pop elements. Each slot carries
+ * a sequence number that tells producers and consumers whether it is ready
+ * to be written or read, so that contention is limited to the head and tail indices,
+ * which live on separate cache lines.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{UMpmcQueue(T)} macro to reference a specific queue type.
+ * @alias typedef struct UMpmcQueue(T) UMpmcQueue(T);
+ */
+
+/*
+ * Defines a new single-producer, single-consumer queue struct.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define P_USPSC_QUEUE_DEF_TYPE(T)                                                                  \
+    typedef struct USpscQueue_##T {                                                                \
+        /** @cond */                                                                               \
+        T *_data;                                                                                  \
+        ulib_uint _mask;                                                                           \
+        ulib_byte _pad0[UVEC_CACHE_LINE_SIZE - sizeof(T *) - sizeof(ulib_uint)];                   \
+        P_UQueue_Atomic(ulib_uint) _head;                                                          \
+        ulib_uint _cached_tail;                                                                    \
+        ulib_byte _pad1[UVEC_CACHE_LINE_SIZE - 2 * sizeof(ulib_uint)];                             \
+        P_UQueue_Atomic(ulib_uint) _tail;                                                          \
+        ulib_uint _cached_head;                                                                    \
+        ulib_byte _pad2[UVEC_CACHE_LINE_SIZE - 2 * sizeof(ulib_uint)];                             \
+        /** @endcond */                                                                            \
+    } USpscQueue_##T;
+
+/*
+ * Generates function declarations for the specified single-producer, single-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the declarations.
+ */
+#define P_USPSC_QUEUE_DECL(T, ATTRS)                                                               \
+    /** @cond */                                                                                   \
+    ATTRS uvec_ret uspsc_queue_init_##T(USpscQueue_##T *q, ulib_uint size);                        \
+    ATTRS void uspsc_queue_deinit_##T(USpscQueue_##T *q);                                          \
+    ATTRS ulib_uint uspsc_queue_push_array_##T(USpscQueue_##T *q, T const *items, ulib_uint n);    \
+    ATTRS ulib_uint uspsc_queue_pop_array_##T(USpscQueue_##T *q, T *items, ulib_uint n);           \
+    /** @endcond */
+
+/*
+ * Generates inline function definitions for the specified single-producer, single-consumer
+ * queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_USPSC_QUEUE_DEF_INLINE(T, ATTRS)                                                         \
+    /** @cond */                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint uspsc_queue_size_##T(USpscQueue_##T const *q) {          \
+        return q->_mask + 1;                                                                       \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE ulib_uint uspsc_queue_count_##T(USpscQueue_##T *q) {                         \
+        ulib_uint const head = p_uqueue_load(&q->_head, acquire);                                  \
+        return (ulib_uint)(p_uqueue_load(&q->_tail, acquire) - head);                              \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool uspsc_queue_push_##T(USpscQueue_##T *q, T item) {                       \
+        ulib_uint const tail = p_uqueue_load(&q->_tail, relaxed);                                  \
+        if ((ulib_uint)(tail - q->_cached_head) > q->_mask) {                                      \
+            q->_cached_head = p_uqueue_load(&q->_head, acquire);                                   \
+            if ((ulib_uint)(tail - q->_cached_head) > q->_mask) return false;                      \
+        }                                                                                          \
+        q->_data[tail & q->_mask] = item;                                                          \
+        p_uqueue_store(&q->_tail, (ulib_uint)(tail + 1), release);                                 \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool uspsc_queue_pop_##T(USpscQueue_##T *q, T *item) {                       \
+        ulib_uint const head = p_uqueue_load(&q->_head, relaxed);                                  \
+        if (head == q->_cached_tail) {                                                             \
+            q->_cached_tail = p_uqueue_load(&q->_tail, acquire);                                   \
+            if (head == q->_cached_tail) return false;                                             \
+        }                                                                                          \
+        if (item) *item = q->_data[head & q->_mask];                                               \
+        p_uqueue_store(&q->_head, (ulib_uint)(head + 1), release);                                 \
+        return true;                                                                               \
+    }                                                                                              \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified single-producer, single-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_USPSC_QUEUE_IMPL(T, ATTRS)                                                               \
+                                                                                                   \
+    ATTRS uvec_ret uspsc_queue_init_##T(USpscQueue_##T *q, ulib_uint size) {                       \
+        if (size > (ULIB_UINT_MAX >> 1U) + 1U) return UVEC_ERR;                                    \
+        size = size < 2 ? 2 : ulib_uint_ceil2(size);                                               \
+        q->_data = (T *)ulib_alloc_array(q->_data, size);                                          \
+        if (!q->_data) return UVEC_ERR;                                                            \
+        q->_mask = size - 1;                                                                       \
+        p_uqueue_init(&q->_head, (ulib_uint)0);                                                    \
+        p_uqueue_init(&q->_tail, (ulib_uint)0);                                                    \
+        q->_cached_head = q->_cached_tail = 0;                                                     \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void uspsc_queue_deinit_##T(USpscQueue_##T *q) {                                         \
+        ulib_free(q->_data);                                                                       \
+        q->_data = NULL;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint uspsc_queue_push_array_##T(USpscQueue_##T *q, T const *items, ulib_uint n) {   \
+        ulib_uint const tail = p_uqueue_load(&q->_tail, relaxed);                                  \
+        ulib_uint avail = q->_mask + 1 - (ulib_uint)(tail - q->_cached_head);                      \
+        if (avail < n) {                                                                           \
+            q->_cached_head = p_uqueue_load(&q->_head, acquire);                                   \
+            avail = q->_mask + 1 - (ulib_uint)(tail - q->_cached_head);                            \
+            if (avail < n) n = avail;                                                              \
+        }                                                                                          \
+        for (ulib_uint i = 0; i < n; ++i) {                                                        \
+            q->_data[(tail + i) & q->_mask] = items[i];                                            \
+        }                                                                                          \
+        if (n) p_uqueue_store(&q->_tail, (ulib_uint)(tail + n), release);                          \
+        return n;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint uspsc_queue_pop_array_##T(USpscQueue_##T *q, T *items, ulib_uint n) {          \
+        ulib_uint const head = p_uqueue_load(&q->_head, relaxed);                                  \
+        ulib_uint avail = (ulib_uint)(q->_cached_tail - head);                                     \
+        if (avail < n) {                                                                           \
+            q->_cached_tail = p_uqueue_load(&q->_tail, acquire);                                   \
+            avail = (ulib_uint)(q->_cached_tail - head);                                           \
+            if (avail < n) n = avail;                                                              \
+        }                                                                                          \
+        if (items) {                                                                               \
+            for (ulib_uint i = 0; i < n; ++i) {                                                    \
+                items[i] = q->_data[(head + i) & q->_mask];                                        \
+            }                                                                                      \
+        }                                                                                          \
+        if (n) p_uqueue_store(&q->_head, (ulib_uint)(head + n), release);                          \
+        return n;                                                                                  \
+    }
+
+/*
+ * Defines a new multi-producer, multi-consumer queue struct.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define P_UMPMC_QUEUE_DEF_TYPE(T)                                                                  \
+    /** @cond */                                                                                   \
+    typedef struct p_umpmc_cell_##T {                                                              \
+        P_UQueue_Atomic(ulib_uint) seq;                                                            \
+        T item;                                                                                    \
+    } p_umpmc_cell_##T;                                                                            \
+    /** @endcond */                                                                                \
+                                                                                                   \
+    typedef struct UMpmcQueue_##T {                                                                \
+        /** @cond */                                                                               \
+        p_umpmc_cell_##T *_cells;                                                                  \
+        ulib_uint _mask;                                                                           \
+        ulib_byte _pad0[UVEC_CACHE_LINE_SIZE - sizeof(void *) - sizeof(ulib_uint)];                \
+        P_UQueue_Atomic(ulib_uint) _head;                                                          \
+        ulib_byte _pad1[UVEC_CACHE_LINE_SIZE - sizeof(ulib_uint)];                                 \
+        P_UQueue_Atomic(ulib_uint) _tail;                                                          \
+        ulib_byte _pad2[UVEC_CACHE_LINE_SIZE - sizeof(ulib_uint)];                                 \
+        /** @endcond */                                                                            \
+    } UMpmcQueue_##T;
+
+/*
+ * Generates function declarations for the specified multi-producer, multi-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the declarations.
+ */
+#define P_UMPMC_QUEUE_DECL(T, ATTRS)                                                               \
+    /** @cond */                                                                                   \
+    ATTRS uvec_ret umpmc_queue_init_##T(UMpmcQueue_##T *q, ulib_uint size);                        \
+    ATTRS void umpmc_queue_deinit_##T(UMpmcQueue_##T *q);                                          \
+    ATTRS ulib_uint umpmc_queue_push_array_##T(UMpmcQueue_##T *q, T const *items, ulib_uint n);    \
+    ATTRS ulib_uint umpmc_queue_pop_array_##T(UMpmcQueue_##T *q, T *items, ulib_uint n);           \
+    /** @endcond */
+
+/*
+ * Generates inline function definitions for the specified multi-producer, multi-consumer
+ * queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_UMPMC_QUEUE_DEF_INLINE(T, ATTRS)                                                         \
+    /** @cond */                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint umpmc_queue_size_##T(UMpmcQueue_##T const *q) {          \
+        return q->_mask + 1;                                                                       \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE ulib_uint umpmc_queue_count_##T(UMpmcQueue_##T *q) {                         \
+        ulib_uint const head = p_uqueue_load(&q->_head, acquire);                                  \
+        ulib_uint const count = (ulib_uint)(p_uqueue_load(&q->_tail, acquire) - head);             \
+        return count > q->_mask + 1 ? 0 : count;                                                   \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool umpmc_queue_push_##T(UMpmcQueue_##T *q, T item) {                       \
+        ulib_uint pos = p_uqueue_load(&q->_tail, relaxed);                                         \
+        p_umpmc_cell_##T *cell;                                                                    \
+        for (;;) {                                                                                 \
+            cell = q->_cells + (pos & q->_mask);                                                   \
+            ulib_int const diff = (ulib_int)(p_uqueue_load(&cell->seq, acquire) - pos);            \
+            if (diff == 0) {                                                                       \
+                if (p_uqueue_cas(&q->_tail, &pos, (ulib_uint)(pos + 1))) break;                    \
+            } else if (diff < 0) {                                                                 \
+                return false;                                                                      \
+            } else {                                                                               \
+                pos = p_uqueue_load(&q->_tail, relaxed);                                           \
+            }                                                                                      \
+        }                                                                                          \
+        cell->item = item;                                                                         \
+        p_uqueue_store(&cell->seq, (ulib_uint)(pos + 1), release);                                 \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool umpmc_queue_pop_##T(UMpmcQueue_##T *q, T *item) {                       \
+        ulib_uint pos = p_uqueue_load(&q->_head, relaxed);                                         \
+        p_umpmc_cell_##T *cell;                                                                    \
+        for (;;) {                                                                                 \
+            cell = q->_cells + (pos & q->_mask);                                                   \
+            ulib_int const diff = (ulib_int)(p_uqueue_load(&cell->seq, acquire) - (pos + 1));      \
+            if (diff == 0) {                                                                       \
+                if (p_uqueue_cas(&q->_head, &pos, (ulib_uint)(pos + 1))) break;                    \
+            } else if (diff < 0) {                                                                 \
+                return false;                                                                      \
+            } else {                                                                               \
+                pos = p_uqueue_load(&q->_head, relaxed);                                           \
+            }                                                                                      \
+        }                                                                                          \
+        if (item) *item = cell->item;                                                              \
+        p_uqueue_store(&cell->seq, (ulib_uint)(pos + q->_mask + 1), release);                      \
+        return true;                                                                               \
+    }                                                                                              \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified multi-producer, multi-consumer queue type.
+ *
+ * Batch operations claim a run of consecutive ready slots with a single compare-and-swap
+ * of the relevant index, then fill or drain them without further contention.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_UMPMC_QUEUE_IMPL(T, ATTRS)                                                               \
+                                                                                                   \
+    ATTRS uvec_ret umpmc_queue_init_##T(UMpmcQueue_##T *q, ulib_uint size) {                       \
+        if (size > (ULIB_UINT_MAX >> 2U) + 1U) return UVEC_ERR;                                    \
+        size = size < 2 ? 2 : ulib_uint_ceil2(size);                                               \
+        q->_cells = (p_umpmc_cell_##T *)ulib_alloc_array(q->_cells, size);                         \
+        if (!q->_cells) return UVEC_ERR;                                                           \
+        for (ulib_uint i = 0; i < size; ++i) {                                                     \
+            p_uqueue_init(&q->_cells[i].seq, i);                                                   \
+        }                                                                                          \
+        q->_mask = size - 1;                                                                       \
+        p_uqueue_init(&q->_head, (ulib_uint)0);                                                    \
+        p_uqueue_init(&q->_tail, (ulib_uint)0);                                                    \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void umpmc_queue_deinit_##T(UMpmcQueue_##T *q) {                                         \
+        ulib_free(q->_cells);                                                                      \
+        q->_cells = NULL;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint umpmc_queue_push_array_##T(UMpmcQueue_##T *q, T const *items, ulib_uint n) {   \
+        if (!n) return 0;                                                                          \
+        ulib_uint pos = p_uqueue_load(&q->_tail, relaxed);                                         \
+        ulib_uint k;                                                                               \
+        for (;;) {                                                                                 \
+            for (k = 0; k < n; ++k) {                                                              \
+                p_umpmc_cell_##T *cell = q->_cells + ((pos + k) & q->_mask);                       \
+                if (p_uqueue_load(&cell->seq, acquire) != (ulib_uint)(pos + k)) break;             \
+            }                                                                                      \
+            if (!k) {                                                                              \
+                p_umpmc_cell_##T *cell = q->_cells + (pos & q->_mask);                             \
+                ulib_int const diff = (ulib_int)(p_uqueue_load(&cell->seq, acquire) - pos);        \
+                if (diff < 0) return 0;                                                            \
+                pos = p_uqueue_load(&q->_tail, relaxed);                                           \
+                continue;                                                                          \
+            }                                                                                      \
+            if (p_uqueue_cas(&q->_tail, &pos, (ulib_uint)(pos + k))) break;                        \
+        }                                                                                          \
+        for (ulib_uint i = 0; i < k; ++i) {                                                        \
+            p_umpmc_cell_##T *cell = q->_cells + ((pos + i) & q->_mask);                           \
+            cell->item = items[i];                                                                 \
+            p_uqueue_store(&cell->seq, (ulib_uint)(pos + i + 1), release);                         \
+        }                                                                                          \
+        return k;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint umpmc_queue_pop_array_##T(UMpmcQueue_##T *q, T *items, ulib_uint n) {          \
+        if (!n) return 0;                                                                          \
+        ulib_uint pos = p_uqueue_load(&q->_head, relaxed);                                         \
+        ulib_uint k;                                                                               \
+        for (;;) {                                                                                 \
+            for (k = 0; k < n; ++k) {                                                              \
+                p_umpmc_cell_##T *cell = q->_cells + ((pos + k) & q->_mask);                       \
+                if (p_uqueue_load(&cell->seq, acquire) != (ulib_uint)(pos + k + 1)) break;         \
+            }                                                                                      \
+            if (!k) {                                                                              \
+                p_umpmc_cell_##T *cell = q->_cells + (pos & q->_mask);                             \
+                ulib_int const diff = (ulib_int)(p_uqueue_load(&cell->seq, acquire) - (pos + 1));  \
+                if (diff < 0) return 0;                                                            \
+                pos = p_uqueue_load(&q->_head, relaxed);                                           \
+                continue;                                                                          \
+            }                                                                                      \
+            if (p_uqueue_cas(&q->_head, &pos, (ulib_uint)(pos + k))) break;                        \
+        }                                                                                          \
+        for (ulib_uint i = 0; i < k; ++i) {                                                        \
+            p_umpmc_cell_##T *cell = q->_cells + ((pos + i) & q->_mask);                           \
+            if (items) items[i] = cell->item;                                                      \
+            p_uqueue_store(&cell->seq, (ulib_uint)(pos + i + q->_mask + 1), release);              \
+        }                                                                                          \
+        return k;                                                                                  \
+    }
+
+/**
+ * @defgroup UQueue_definitions Lock-free queue type definitions
+ * @{
+ */
+
+/**
+ * Declares a new single-producer, single-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define USPSC_QUEUE_DECL(T)                                                                        \
+    P_USPSC_QUEUE_DEF_TYPE(T)                                                                      \
+    P_USPSC_QUEUE_DECL(T, ulib_unused)                                                             \
+    P_USPSC_QUEUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Declares a new single-producer, single-consumer queue type,
+ * prepending a specifier to the generated declarations.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param SPEC @ctype{specifier} Specifier.
+ */
+#define USPSC_QUEUE_DECL_SPEC(T, SPEC)                                                             \
+    P_USPSC_QUEUE_DEF_TYPE(T)                                                                      \
+    P_USPSC_QUEUE_DECL(T, SPEC ulib_unused)                                                        \
+    P_USPSC_QUEUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Implements a previously declared single-producer, single-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define USPSC_QUEUE_IMPL(T) P_USPSC_QUEUE_IMPL(T, ulib_unused)
+
+/**
+ * Defines a new static single-producer, single-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define USPSC_QUEUE_INIT(T)                                                                        \
+    P_USPSC_QUEUE_DEF_TYPE(T)                                                                      \
+    P_USPSC_QUEUE_DECL(T, ULIB_INLINE ulib_unused)                                                 \
+    P_USPSC_QUEUE_DEF_INLINE(T, ulib_unused)                                                       \
+    P_USPSC_QUEUE_IMPL(T, ULIB_INLINE ulib_unused)
+
+/**
+ * Declares a new multi-producer, multi-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define UMPMC_QUEUE_DECL(T)                                                                        \
+    P_UMPMC_QUEUE_DEF_TYPE(T)                                                                      \
+    P_UMPMC_QUEUE_DECL(T, ulib_unused)                                                             \
+    P_UMPMC_QUEUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Declares a new multi-producer, multi-consumer queue type,
+ * prepending a specifier to the generated declarations.
+ *
+ * @param T @ctype{symbol} Queue type.
+ * @param SPEC @ctype{specifier} Specifier.
+ */
+#define UMPMC_QUEUE_DECL_SPEC(T, SPEC)                                                             \
+    P_UMPMC_QUEUE_DEF_TYPE(T)                                                                      \
+    P_UMPMC_QUEUE_DECL(T, SPEC ulib_unused)                                                        \
+    P_UMPMC_QUEUE_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Implements a previously declared multi-producer, multi-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define UMPMC_QUEUE_IMPL(T) P_UMPMC_QUEUE_IMPL(T, ulib_unused)
+
+/**
+ * Defines a new static multi-producer, multi-consumer queue type.
+ *
+ * @param T @ctype{symbol} Queue type.
+ */
+#define UMPMC_QUEUE_INIT(T)                                                                        \
+    P_UMPMC_QUEUE_DEF_TYPE(T)                                                                      \
+    P_UMPMC_QUEUE_DECL(T, ULIB_INLINE ulib_unused)                                                 \
+    P_UMPMC_QUEUE_DEF_INLINE(T, ulib_unused)                                                       \
+    P_UMPMC_QUEUE_IMPL(T, ULIB_INLINE ulib_unused)
+
+/// @}
+
+/**
+ * @defgroup USpscQueue_api USpscQueue API
+ * @{
+ */
+
+/**
+ * Initializes a new single-producer, single-consumer queue.
+ *
+ * @param T Queue type.
+ * @param q Queue to initialize.
+ * @param size Maximum number of elements, rounded up to the next power of two.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @destructor{uspsc_queue_deinit}
+ * @alias uvec_ret uspsc_queue_init(symbol T, USpscQueue(T) *q, ulib_uint size);
+ */
+#define uspsc_queue_init(T, q, size) ULIB_MACRO_CONCAT(uspsc_queue_init_, T)(q, size)
+
+/**
+ * De-initializes a queue previously initialized via @func{uspsc_queue_init}.
+ *
+ * @param T Queue type.
+ * @param q Queue to deinitialize.
+ *
+ * @alias void uspsc_queue_deinit(symbol T, USpscQueue(T) *q);
+ */
+#define uspsc_queue_deinit(T, q) ULIB_MACRO_CONCAT(uspsc_queue_deinit_, T)(q)
+
+/**
+ * Returns the maximum number of elements the queue can hold.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @return Maximum number of elements.
+ *
+ * @alias ulib_uint uspsc_queue_size(symbol T, USpscQueue(T) const *q);
+ */
+#define uspsc_queue_size(T, q) ULIB_MACRO_CONCAT(uspsc_queue_size_, T)(q)
+
+/**
+ * Returns the number of elements in the queue.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @return Number of elements.
+ *
+ * @note The result may be outdated by the time it is returned if the queue is in use.
+ * @alias ulib_uint uspsc_queue_count(symbol T, USpscQueue(T) *q);
+ */
+#define uspsc_queue_count(T, q) ULIB_MACRO_CONCAT(uspsc_queue_count_, T)(q)
+
+/**
+ * Pushes an element at the back of the queue. Must only be called by the producer thread.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param item Element to push.
+ * @return True if the element was pushed, false if the queue was full.
+ *
+ * @alias bool uspsc_queue_push(symbol T, USpscQueue(T) *q, T item);
+ */
+#define uspsc_queue_push(T, q, item) ULIB_MACRO_CONCAT(uspsc_queue_push_, T)(q, item)
+
+/**
+ * Pops the element at the front of the queue. Must only be called by the consumer thread.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param[out] item Popped element.
+ * @return True if an element was popped, false if the queue was empty.
+ *
+ * @alias bool uspsc_queue_pop(symbol T, USpscQueue(T) *q, T *item);
+ */
+#define uspsc_queue_pop(T, q, item) ULIB_MACRO_CONCAT(uspsc_queue_pop_, T)(q, item)
+
+/**
+ * Pushes up to `n` elements at the back of the queue, publishing them at once.
+ * Must only be called by the producer thread.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param items Elements to push.
+ * @param n Number of elements to push.
+ * @return Number of pushed elements, which is less than `n` if the queue became full.
+ *
+ * @alias ulib_uint uspsc_queue_push_array(symbol T, USpscQueue(T) *q, T const *items,
+ *                                         ulib_uint n);
+ */
+#define uspsc_queue_push_array(T, q, items, n)                                                     \
+    ULIB_MACRO_CONCAT(uspsc_queue_push_array_, T)(q, items, n)
+
+/**
+ * Pops up to `n` elements from the front of the queue at once.
+ * Must only be called by the consumer thread.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param[out] items Popped elements, or NULL to discard them.
+ * @param n Maximum number of elements to pop.
+ * @return Number of popped elements.
+ *
+ * @alias ulib_uint uspsc_queue_pop_array(symbol T, USpscQueue(T) *q, T *items, ulib_uint n);
+ */
+#define uspsc_queue_pop_array(T, q, items, n)                                                      \
+    ULIB_MACRO_CONCAT(uspsc_queue_pop_array_, T)(q, items, n)
+
+/// @}
+
+/**
+ * @defgroup UMpmcQueue_api UMpmcQueue API
+ * @{
+ */
+
+/**
+ * Initializes a new multi-producer, multi-consumer queue.
+ *
+ * @param T Queue type.
+ * @param q Queue to initialize.
+ * @param size Maximum number of elements, rounded up to the next power of two.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @destructor{umpmc_queue_deinit}
+ * @alias uvec_ret umpmc_queue_init(symbol T, UMpmcQueue(T) *q, ulib_uint size);
+ */
+#define umpmc_queue_init(T, q, size) ULIB_MACRO_CONCAT(umpmc_queue_init_, T)(q, size)
+
+/**
+ * De-initializes a queue previously initialized via @func{umpmc_queue_init}.
+ *
+ * @param T Queue type.
+ * @param q Queue to deinitialize.
+ *
+ * @alias void umpmc_queue_deinit(symbol T, UMpmcQueue(T) *q);
+ */
+#define umpmc_queue_deinit(T, q) ULIB_MACRO_CONCAT(umpmc_queue_deinit_, T)(q)
+
+/**
+ * Returns the maximum number of elements the queue can hold.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @return Maximum number of elements.
+ *
+ * @alias ulib_uint umpmc_queue_size(symbol T, UMpmcQueue(T) const *q);
+ */
+#define umpmc_queue_size(T, q) ULIB_MACRO_CONCAT(umpmc_queue_size_, T)(q)
+
+/**
+ * Returns the number of elements in the queue.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @return Number of elements.
+ *
+ * @note The result may be outdated by the time it is returned if the queue is in use.
+ * @alias ulib_uint umpmc_queue_count(symbol T, UMpmcQueue(T) *q);
+ */
+#define umpmc_queue_count(T, q) ULIB_MACRO_CONCAT(umpmc_queue_count_, T)(q)
+
+/**
+ * Pushes an element at the back of the queue.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param item Element to push.
+ * @return True if the element was pushed, false if the queue was full.
+ *
+ * @alias bool umpmc_queue_push(symbol T, UMpmcQueue(T) *q, T item);
+ */
+#define umpmc_queue_push(T, q, item) ULIB_MACRO_CONCAT(umpmc_queue_push_, T)(q, item)
+
+/**
+ * Pops the element at the front of the queue.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param[out] item Popped element.
+ * @return True if an element was popped, false if the queue was empty.
+ *
+ * @alias bool umpmc_queue_pop(symbol T, UMpmcQueue(T) *q, T *item);
+ */
+#define umpmc_queue_pop(T, q, item) ULIB_MACRO_CONCAT(umpmc_queue_pop_, T)(q, item)
+
+/**
+ * Pushes up to `n` elements at the back of the queue, reserving their slots at once.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param items Elements to push.
+ * @param n Number of elements to push.
+ * @return Number of pushed elements, which is less than `n` if the queue became full.
+ *
+ * @alias ulib_uint umpmc_queue_push_array(symbol T, UMpmcQueue(T) *q, T const *items,
+ *                                         ulib_uint n);
+ */
+#define umpmc_queue_push_array(T, q, items, n)                                                     \
+    ULIB_MACRO_CONCAT(umpmc_queue_push_array_, T)(q, items, n)
+
+/**
+ * Pops up to `n` elements from the front of the queue, claiming their slots at once.
+ *
+ * @param T Queue type.
+ * @param q Queue instance.
+ * @param[out] items Popped elements, or NULL to discard them.
+ * @param n Maximum number of elements to pop.
+ * @return Number of popped elements.
+ *
+ * @alias ulib_uint umpmc_queue_pop_array(symbol T, UMpmcQueue(T) *q, T *items, ulib_uint n);
+ */
+#define umpmc_queue_pop_array(T, q, items, n)                                                      \
+    ULIB_MACRO_CONCAT(umpmc_queue_pop_array_, T)(q, items, n)
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // P_UQueue_Atomic
+
+#endif // UQUEUE_H
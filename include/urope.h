@@ -0,0 +1,218 @@
+/**
+ * A rope of immutable string chunks.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UROPE_H
+#define UROPE_H
+
+#include "uattrs.h"
+#include "ulib_ret.h"
+#include "ustream.h"
+#include "ustring.h"
+#include "uutils.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+ULIB_BEGIN_DECLS
+
+/// @cond
+struct p_urope_node;
+/// @endcond
+
+/**
+ * A rope, or cord: a string represented as a balanced tree of immutable @type{UString} chunks.
+ *
+ * Ropes support concatenation, extraction of substrings and random access in logarithmic time,
+ * without ever copying their chunks. Their nodes are reference counted and shared
+ * between ropes, so duplicating a rope is a constant time operation.
+ *
+ * @note Ropes are not thread-safe, even when only reading: duplicating or deinitializing
+ *       ropes that share nodes from multiple threads requires external synchronization.
+ */
+typedef struct URope {
+    /// @cond
+    struct p_urope_node *_root;
+    /// @endcond
+} URope;
+
+/**
+ * @defgroup URope_constants URope constants
+ * @{
+ */
+
+/// Chunks whose combined length does not exceed this value are merged on concatenation.
+#ifndef UROPE_MERGE_SIZE
+#define UROPE_MERGE_SIZE 128
+#endif
+
+/// @}
+
+/**
+ * @defgroup URope URope API
+ * @{
+ */
+
+/**
+ * Initializes a new, empty rope.
+ *
+ * @return Initialized rope.
+ *
+ * @destructor{urope_deinit}
+ */
+ULIB_CONST
+ULIB_INLINE
+URope urope(void) {
+    URope rope = ulib_struct_init;
+    return rope;
+}
+
+/**
+ * Deinitializes a rope.
+ *
+ * @param rope Rope.
+ */
+ULIB_API
+void urope_deinit(URope *rope);
+
+/**
+ * Duplicates the specified rope.
+ *
+ * @param rope Rope.
+ * @return Duplicated rope, sharing the chunks of the original.
+ *
+ * @destructor{urope_deinit}
+ */
+ULIB_API
+URope urope_dup(URope const *rope);
+
+/**
+ * Returns the length of the rope.
+ *
+ * @param rope Rope.
+ * @return Length.
+ */
+ULIB_API
+ULIB_PURE
+size_t urope_length(URope const *rope);
+
+/**
+ * Checks whether the rope is empty.
+ *
+ * @param rope Rope.
+ * @return True if the rope is empty, false otherwise.
+ */
+ULIB_PURE
+ULIB_INLINE
+bool urope_is_empty(URope const *rope) {
+    return rope->_root == NULL;
+}
+
+/**
+ * Appends a string to the rope.
+ *
+ * @param rope Rope.
+ * @param string String.
+ * @return Return code.
+ *
+ * @note The rope takes ownership of the string, even in case of failure.
+ *       Strings that you do not own, such as those returned by @func{ustring_wrap},
+ *       should be appended via @func{urope_append_buf}.
+ */
+ULIB_API
+ulib_ret urope_append_ustring(URope *rope, UString string);
+
+/**
+ * Appends a copy of the specified buffer to the rope.
+ *
+ * @param rope Rope.
+ * @param buf Buffer.
+ * @param length Length of the buffer.
+ * @return Return code.
+ */
+ULIB_API
+ulib_ret urope_append_buf(URope *rope, char const *buf, size_t length);
+
+/**
+ * Appends a rope to another rope.
+ *
+ * @param rope Rope.
+ * @param other Rope to append, can be equal to `rope`.
+ * @return Return code.
+ */
+ULIB_API
+ulib_ret urope_append(URope *rope, URope const *other);
+
+/**
+ * Returns a new rope spanning the specified range of the rope.
+ *
+ * @param rope Rope.
+ * @param start Range start index.
+ * @param length Range length.
+ * @param[out] range Rope spanning the range.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if the range exceeds the length of the rope,
+ *         otherwise @val{ULIB_ERR_MEM}.
+ *
+ * @destructor{urope_deinit}
+ */
+ULIB_API
+ulib_ret urope_range(URope const *rope, size_t start, size_t length, URope *range);
+
+/**
+ * Returns the character at the specified index.
+ *
+ * @param rope Rope.
+ * @param idx Index, must be lower than the length of the rope.
+ * @return Character.
+ */
+ULIB_API
+ULIB_PURE
+char urope_char_at(URope const *rope, size_t idx);
+
+/**
+ * Returns the number of chunks in the rope.
+ *
+ * @param rope Rope.
+ * @return Number of chunks.
+ */
+ULIB_API
+ULIB_PURE
+size_t urope_chunk_count(URope const *rope);
+
+/**
+ * Copies the contents of the rope into a new string.
+ *
+ * @param rope Rope.
+ * @return String, or @val{ustring_null} on allocation failure, or if the rope is too long
+ *         to be stored in a single string.
+ *
+ * @destructor{ustring_deinit}
+ */
+ULIB_API
+UString urope_to_ustring(URope const *rope);
+
+/**
+ * Writes the contents of the rope into the specified stream.
+ *
+ * @param rope Rope.
+ * @param stream Output stream.
+ * @param[out] written Number of bytes written.
+ * @return Return code.
+ *
+ * @note Chunks are written in batches via @func{uostream_writev}, therefore the contents
+ *       of the rope are never copied into a contiguous buffer.
+ */
+ULIB_API
+ustream_ret urope_write(URope const *rope, UOStream *stream, size_t *written);
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UROPE_H
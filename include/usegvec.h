@@ -0,0 +1,480 @@
+/**
+ * A type-safe, generic C segmented vector.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef USEGVEC_H
+#define USEGVEC_H
+
+#include "ualloc.h"
+#include "uattrs.h"
+#include "unumber.h"
+#include "uutils.h"
+#include "uvec.h"
+#include <limits.h>
+#include <string.h>
+
+ULIB_BEGIN_DECLS
+
+// Types
+
+/**
+ * References a specific segmented vector type.
+ *
+ * @param T Segmented vector type.
+ */
+#define USegVec(T) ULIB_MACRO_CONCAT(USegVec_, T)
+
+/**
+ * Generic segmented vector type.
+ *
+ * Elements are stored in a sequence of segments whose sizes grow exponentially, so that
+ * the segment and offset of any index can be computed in *O(1)*. Growing the vector allocates
+ * a new segment rather than reallocating existing storage: elements are never moved,
+ * and pointers to them remain valid until they are popped or the vector is deinitialized.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{USegVec(T)} macro to reference a specific segmented vector type.
+ * @alias typedef struct USegVec(T) USegVec(T);
+ */
+
+/**
+ * Segmented vector type forward declaration.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ */
+#define usegvec_decl(T) typedef struct USegVec(T) USegVec(T)
+
+/**
+ * @defgroup USegVec_constants USegVec constants
+ * @{
+ */
+
+/// Base two logarithm of the size of the first segment.
+#ifndef USEGVEC_FIRST_SEGMENT_EXP
+#define USEGVEC_FIRST_SEGMENT_EXP 4
+#endif
+
+/// Maximum number of elements a segmented vector can hold.
+#define USEGVEC_MAX_COUNT (ULIB_UINT_MAX - P_USEGVEC_FIRST_SIZE + 1U)
+
+/// @}
+
+#define P_USEGVEC_FIRST_SIZE ((ulib_uint)1 << USEGVEC_FIRST_SEGMENT_EXP)
+#define P_USEGVEC_SEGMENTS (sizeof(ulib_uint) * CHAR_BIT - USEGVEC_FIRST_SEGMENT_EXP)
+
+/*
+ * Segment holding the element at the specified index.
+ * Segment k holds 2^(k + FIRST_SEGMENT_EXP) elements, starting at index 2^(k + EXP) - 2^EXP.
+ */
+#define p_usegvec_segment(i)                                                                       \
+    (ulib_uint_log2((i) + P_USEGVEC_FIRST_SIZE) - USEGVEC_FIRST_SEGMENT_EXP)
+#define p_usegvec_segment_size(k) ((ulib_uint)P_USEGVEC_FIRST_SIZE << (k))
+#define p_usegvec_segment_start(k) (p_usegvec_segment_size(k) - P_USEGVEC_FIRST_SIZE)
+
+/*
+ * Defines a new segmented vector struct.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ */
+#define P_USEGVEC_DEF_TYPE(T)                                                                      \
+    typedef struct USegVec_##T {                                                                   \
+        /** @cond */                                                                               \
+        T *_seg[P_USEGVEC_SEGMENTS];                                                               \
+        ulib_uint _count;                                                                          \
+        ulib_uint _segcount;                                                                       \
+        /** @endcond */                                                                            \
+    } USegVec_##T;                                                                                 \
+                                                                                                   \
+    /** @cond */                                                                                   \
+    typedef struct USegVec_Loop_##T {                                                              \
+        T *item;                                                                                   \
+        T *end;                                                                                    \
+        T *const *seg;                                                                             \
+        ulib_uint i;                                                                               \
+        ulib_uint count;                                                                           \
+    } USegVec_Loop_##T;                                                                            \
+    /** @endcond */
+
+/*
+ * Generates function declarations for the specified segmented vector type.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ * @param ATTRS @ctype{attributes} Attributes of the declarations.
+ */
+#define P_USEGVEC_DECL(T, ATTRS)                                                                   \
+    /** @cond */                                                                                   \
+    ATTRS void usegvec_deinit_##T(USegVec_##T *vec);                                               \
+    ATTRS uvec_ret usegvec_reserve_##T(USegVec_##T *vec, ulib_uint size);                          \
+    ATTRS uvec_ret usegvec_push_##T(USegVec_##T *vec, T item);                                     \
+    ATTRS uvec_ret usegvec_append_array_##T(USegVec_##T *vec, T const *array, ulib_uint n);        \
+    /** @endcond */
+
+/*
+ * Generates inline function definitions for the specified segmented vector type.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_USEGVEC_DEF_INLINE(T, ATTRS)                                                             \
+    /** @cond */                                                                                   \
+    ATTRS ULIB_INLINE USegVec_##T usegvec_##T(void) {                                              \
+        USegVec_##T vec = ulib_struct_init;                                                        \
+        return vec;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint usegvec_count_##T(USegVec_##T const *vec) {              \
+        return vec->_count;                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint usegvec_size_##T(USegVec_##T const *vec) {               \
+        return vec->_segcount ? p_usegvec_segment_start(vec->_segcount) : 0;                       \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T *usegvec_get_ref_##T(USegVec_##T const *vec, ulib_uint idx) {    \
+        ulib_uint const k = p_usegvec_segment(idx);                                                \
+        return vec->_seg[k] + (idx - p_usegvec_segment_start(k));                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T usegvec_get_##T(USegVec_##T const *vec, ulib_uint idx) {         \
+        return *usegvec_get_ref_##T(vec, idx);                                                     \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void usegvec_set_##T(USegVec_##T *vec, ulib_uint idx, T item) {              \
+        *usegvec_get_ref_##T(vec, idx) = item;                                                     \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE T usegvec_last_##T(USegVec_##T const *vec) {                       \
+        return usegvec_get_##T(vec, vec->_count - 1);                                              \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool usegvec_pop_##T(USegVec_##T *vec, T *item) {                            \
+        if (!vec->_count) return false;                                                            \
+        --vec->_count;                                                                             \
+        if (item) *item = usegvec_get_##T(vec, vec->_count);                                       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void usegvec_clear_##T(USegVec_##T *vec) {                                   \
+        vec->_count = 0;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE USegVec_Loop_##T p_usegvec_loop_init_##T(USegVec_##T const *vec) { \
+        T *const first = vec->_seg[0];                                                             \
+        T *const end = first ? first + P_USEGVEC_FIRST_SIZE : NULL;                                \
+        USegVec_Loop_##T loop = { first, end, vec->_seg, 0, vec->_count };                         \
+        return loop;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void p_usegvec_loop_next_##T(USegVec_Loop_##T *loop) {                       \
+        if (++loop->i == loop->count) return;                                                      \
+        if (++loop->item != loop->end) return;                                                     \
+        loop->item = *(++loop->seg);                                                               \
+        loop->end = loop->item + loop->i + P_USEGVEC_FIRST_SIZE;                                   \
+    }                                                                                              \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified segmented vector type.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ */
+#define P_USEGVEC_IMPL(T, ATTRS)                                                                   \
+                                                                                                   \
+    ATTRS void usegvec_deinit_##T(USegVec_##T *vec) {                                              \
+        for (ulib_uint k = 0; k < vec->_segcount; ++k) {                                           \
+            ulib_free(vec->_seg[k]);                                                               \
+            vec->_seg[k] = NULL;                                                                   \
+        }                                                                                          \
+        vec->_count = vec->_segcount = 0;                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret usegvec_reserve_##T(USegVec_##T *vec, ulib_uint size) {                         \
+        if (size > USEGVEC_MAX_COUNT) return UVEC_ERR;                                             \
+        if (size <= usegvec_size_##T(vec)) return UVEC_OK;                                         \
+                                                                                                   \
+        ulib_uint const last = p_usegvec_segment(size - 1);                                        \
+                                                                                                   \
+        for (ulib_uint k = vec->_segcount; k <= last; ++k) {                                       \
+            T *seg = (T *)ulib_alloc_array(seg, p_usegvec_segment_size(k));                        \
+            if (!seg) return UVEC_ERR;                                                             \
+            vec->_seg[k] = seg;                                                                    \
+            vec->_segcount = k + 1;                                                                \
+        }                                                                                          \
+                                                                                                   \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret usegvec_push_##T(USegVec_##T *vec, T item) {                                    \
+        if (vec->_count == usegvec_size_##T(vec) &&                                                \
+            usegvec_reserve_##T(vec, vec->_count + 1)) {                                           \
+            return UVEC_ERR;                                                                       \
+        }                                                                                          \
+        *usegvec_get_ref_##T(vec, vec->_count++) = item;                                           \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret usegvec_append_array_##T(USegVec_##T *vec, T const *array, ulib_uint n) {       \
+        if (n > USEGVEC_MAX_COUNT - vec->_count) return UVEC_ERR;                                  \
+        if (usegvec_reserve_##T(vec, vec->_count + n)) return UVEC_ERR;                            \
+                                                                                                   \
+        while (n) {                                                                                \
+            ulib_uint const k = p_usegvec_segment(vec->_count);                                    \
+            ulib_uint const off = vec->_count - p_usegvec_segment_start(k);                        \
+            ulib_uint const len = ulib_min(n, p_usegvec_segment_size(k) - off);                    \
+            memcpy(vec->_seg[k] + off, array, len * sizeof(T));                                    \
+            vec->_count += len;                                                                    \
+            array += len;                                                                          \
+            n -= len;                                                                              \
+        }                                                                                          \
+                                                                                                   \
+        return UVEC_OK;                                                                            \
+    }
+
+/**
+ * @defgroup USegVec_definitions USegVec type definitions
+ * @{
+ */
+
+/**
+ * Declares a new segmented vector type.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ */
+#define USEGVEC_DECL(T)                                                                            \
+    P_USEGVEC_DEF_TYPE(T)                                                                          \
+    P_USEGVEC_DECL(T, ulib_unused)                                                                 \
+    P_USEGVEC_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Declares a new segmented vector type, prepending a specifier to the generated declarations.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ * @param SPEC @ctype{specifier} Specifier.
+ */
+#define USEGVEC_DECL_SPEC(T, SPEC)                                                                 \
+    P_USEGVEC_DEF_TYPE(T)                                                                          \
+    P_USEGVEC_DECL(T, SPEC ulib_unused)                                                            \
+    P_USEGVEC_DEF_INLINE(T, ulib_unused)
+
+/**
+ * Implements a previously declared segmented vector type.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ */
+#define USEGVEC_IMPL(T) P_USEGVEC_IMPL(T, ulib_unused)
+
+/**
+ * Defines a new static segmented vector type.
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ */
+#define USEGVEC_INIT(T)                                                                            \
+    P_USEGVEC_DEF_TYPE(T)                                                                          \
+    P_USEGVEC_DECL(T, ULIB_INLINE ulib_unused)                                                     \
+    P_USEGVEC_DEF_INLINE(T, ulib_unused)                                                           \
+    P_USEGVEC_IMPL(T, ULIB_INLINE ulib_unused)
+
+/// @}
+
+/**
+ * @defgroup USegVec_api USegVec API
+ * @{
+ */
+
+/**
+ * Initializes a new segmented vector.
+ *
+ * @param T Segmented vector type.
+ * @return Initialized segmented vector instance.
+ *
+ * @destructor{usegvec_deinit}
+ * @alias USegVec(T) usegvec(symbol T);
+ */
+#define usegvec(T) ULIB_MACRO_CONCAT(usegvec_, T)()
+
+/**
+ * De-initializes a segmented vector previously initialized via @func{usegvec(T)}.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector to deinitialize.
+ *
+ * @alias void usegvec_deinit(symbol T, USegVec(T) *vec);
+ */
+#define usegvec_deinit(T, vec) ULIB_MACRO_CONCAT(usegvec_deinit_, T)(vec)
+
+/**
+ * Returns the number of elements in the segmented vector.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @return Number of elements.
+ *
+ * @alias ulib_uint usegvec_count(symbol T, USegVec(T) const *vec);
+ */
+#define usegvec_count(T, vec) ULIB_MACRO_CONCAT(usegvec_count_, T)(vec)
+
+/**
+ * Returns the number of elements the segmented vector can hold without allocating.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @return Maximum number of elements.
+ *
+ * @alias ulib_uint usegvec_size(symbol T, USegVec(T) const *vec);
+ */
+#define usegvec_size(T, vec) ULIB_MACRO_CONCAT(usegvec_size_, T)(vec)
+
+/**
+ * Ensures the segmented vector can hold at least as many elements as `size`.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param size Number of elements the segmented vector should be able to hold.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret usegvec_reserve(symbol T, USegVec(T) *vec, ulib_uint size);
+ */
+#define usegvec_reserve(T, vec, size) ULIB_MACRO_CONCAT(usegvec_reserve_, T)(vec, size)
+
+/**
+ * Returns the element at the specified index.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param idx Index.
+ * @return Element at the specified index.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias T usegvec_get(symbol T, USegVec(T) const *vec, ulib_uint idx);
+ */
+#define usegvec_get(T, vec, idx) ULIB_MACRO_CONCAT(usegvec_get_, T)(vec, idx)
+
+/**
+ * Returns a pointer to the element at the specified index.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param idx Index.
+ * @return Pointer to the element at the specified index.
+ *
+ * @note The pointer remains valid until the element is popped, the vector is cleared,
+ *       or the vector is deinitialized. Pushing elements never invalidates it.
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias T *usegvec_get_ref(symbol T, USegVec(T) const *vec, ulib_uint idx);
+ */
+#define usegvec_get_ref(T, vec, idx) ULIB_MACRO_CONCAT(usegvec_get_ref_, T)(vec, idx)
+
+/**
+ * Replaces the element at the specified index.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param idx Index.
+ * @param item Replacement element.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias void usegvec_set(symbol T, USegVec(T) *vec, ulib_uint idx, T item);
+ */
+#define usegvec_set(T, vec, idx, item) ULIB_MACRO_CONCAT(usegvec_set_, T)(vec, idx, item)
+
+/**
+ * Returns the last element in the segmented vector.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @return Last element.
+ *
+ * @warning Calling this function on an empty segmented vector results in undefined behavior.
+ * @alias T usegvec_last(symbol T, USegVec(T) const *vec);
+ */
+#define usegvec_last(T, vec) ULIB_MACRO_CONCAT(usegvec_last_, T)(vec)
+
+/**
+ * Pushes the specified element to the top of the segmented vector (last element).
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param item Element to push.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note Existing elements are never moved.
+ * @alias uvec_ret usegvec_push(symbol T, USegVec(T) *vec, T item);
+ */
+#define usegvec_push(T, vec, item) ULIB_MACRO_CONCAT(usegvec_push_, T)(vec, item)
+
+/**
+ * Appends the specified array to the segmented vector.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param array Array to append.
+ * @param n Number of elements to append.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret usegvec_append_array(symbol T, USegVec(T) *vec, T const *array, ulib_uint n);
+ */
+#define usegvec_append_array(T, vec, array, n)                                                     \
+    ULIB_MACRO_CONCAT(usegvec_append_array_, T)(vec, array, n)
+
+/**
+ * Removes and returns the element at the top of the segmented vector (last element).
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ * @param[out] item Removed element.
+ * @return True if an element was removed, false if the segmented vector was empty.
+ *
+ * @note Segments are retained, and reused by subsequent pushes.
+ * @alias bool usegvec_pop(symbol T, USegVec(T) *vec, T *item);
+ */
+#define usegvec_pop(T, vec, item) ULIB_MACRO_CONCAT(usegvec_pop_, T)(vec, item)
+
+/**
+ * Removes all the elements in the segmented vector, retaining its segments.
+ *
+ * @param T Segmented vector type.
+ * @param vec Segmented vector instance.
+ *
+ * @alias void usegvec_clear(symbol T, USegVec(T) *vec);
+ */
+#define usegvec_clear(T, vec) ULIB_MACRO_CONCAT(usegvec_clear_, T)(vec)
+
+// clang-format off
+
+/**
+ * Iterates over the segmented vector, executing the specified code block for each element.
+ *
+ * Usage example:
+ * @code
+ * usegvec_foreach (ulib_int, vec, entry) {
+ *     ulib_uint index = entry.i;
+ *     ulib_int item = *entry.item;
+ *     ...
+ * }
+ * @endcode
+ *
+ * @param T @ctype{symbol} Segmented vector type.
+ * @param vec @ctype{#USegVec(T) *} Segmented vector instance.
+ * @param enum_name @ctype{symbol} Name of the variable holding the current item and its index.
+ */
+#define usegvec_foreach(T, vec, enum_name)                                                         \
+    for (ULIB_MACRO_CONCAT(USegVec_Loop_, T) enum_name =                                           \
+         ULIB_MACRO_CONCAT(p_usegvec_loop_init_, T)(vec);                                          \
+         enum_name.i != enum_name.count;                                                           \
+         ULIB_MACRO_CONCAT(p_usegvec_loop_next_, T)(&enum_name))
+
+// clang-format on
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // USEGVEC_H
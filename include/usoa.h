@@ -0,0 +1,405 @@
+/**
+ * A type-safe, generic C struct-of-arrays vector.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef USOA_H
+#define USOA_H
+
+#include "ualloc.h"
+#include "uattrs.h"
+#include "unumber.h"
+#include "uutils.h"
+#include "uvec.h"
+
+ULIB_BEGIN_DECLS
+
+// Types
+
+/**
+ * Generic struct-of-arrays vector type.
+ *
+ * Each field of the records stored in the vector is kept in its own array (column),
+ * and all columns share the same count and capacity. Scanning a single field
+ * only touches the memory of its column, and columns can be passed as plain arrays
+ * to vectorized routines.
+ *
+ * @note This is a placeholder for documentation purposes. Struct-of-arrays types are
+ *       referenced by the name passed to @func{USOA_INIT}.
+ * @alias typedef struct Name Name;
+ */
+
+/**
+ * References the record type of a specific struct-of-arrays type.
+ *
+ * @param Name Struct-of-arrays type.
+ */
+#define USoaRow(Name) ULIB_MACRO_CONCAT(Name, _Row)
+
+/**
+ * Record type of a struct-of-arrays vector, holding one member per column.
+ *
+ * @note This is a placeholder for documentation purposes. You should use the
+ *       @func{USoaRow(Name)} macro to reference a specific record type.
+ * @alias typedef struct USoaRow(Name) USoaRow(Name);
+ */
+
+/**
+ * @defgroup USoa_constants USoa constants
+ * @{
+ */
+
+/// Maximum number of fields of a struct-of-arrays type.
+#define USOA_MAX_FIELDS 16
+
+/// @}
+
+// Invokes M(type, field) for each (type, field) pair.
+#define P_USOA_NARGS(...)                                                                          \
+    P_USOA_NARGS_N(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define P_USOA_NARGS_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N,   \
+                       ...)                                                                        \
+    N
+#define P_USOA_FOREACH(M, ...)                                                                     \
+    ULIB_MACRO_CONCAT(P_USOA_FOREACH_, P_USOA_NARGS(__VA_ARGS__))(M, __VA_ARGS__)
+#define P_USOA_FOREACH_1(M, a) M a
+#define P_USOA_FOREACH_2(M, a, ...) M a P_USOA_FOREACH_1(M, __VA_ARGS__)
+#define P_USOA_FOREACH_3(M, a, ...) M a P_USOA_FOREACH_2(M, __VA_ARGS__)
+#define P_USOA_FOREACH_4(M, a, ...) M a P_USOA_FOREACH_3(M, __VA_ARGS__)
+#define P_USOA_FOREACH_5(M, a, ...) M a P_USOA_FOREACH_4(M, __VA_ARGS__)
+#define P_USOA_FOREACH_6(M, a, ...) M a P_USOA_FOREACH_5(M, __VA_ARGS__)
+#define P_USOA_FOREACH_7(M, a, ...) M a P_USOA_FOREACH_6(M, __VA_ARGS__)
+#define P_USOA_FOREACH_8(M, a, ...) M a P_USOA_FOREACH_7(M, __VA_ARGS__)
+#define P_USOA_FOREACH_9(M, a, ...) M a P_USOA_FOREACH_8(M, __VA_ARGS__)
+#define P_USOA_FOREACH_10(M, a, ...) M a P_USOA_FOREACH_9(M, __VA_ARGS__)
+#define P_USOA_FOREACH_11(M, a, ...) M a P_USOA_FOREACH_10(M, __VA_ARGS__)
+#define P_USOA_FOREACH_12(M, a, ...) M a P_USOA_FOREACH_11(M, __VA_ARGS__)
+#define P_USOA_FOREACH_13(M, a, ...) M a P_USOA_FOREACH_12(M, __VA_ARGS__)
+#define P_USOA_FOREACH_14(M, a, ...) M a P_USOA_FOREACH_13(M, __VA_ARGS__)
+#define P_USOA_FOREACH_15(M, a, ...) M a P_USOA_FOREACH_14(M, __VA_ARGS__)
+#define P_USOA_FOREACH_16(M, a, ...) M a P_USOA_FOREACH_15(M, __VA_ARGS__)
+
+#define P_USOA_ROW_FIELD(type, field) type field;
+#define P_USOA_COLUMN_FIELD(type, field) type *field;
+#define P_USOA_COLUMN_FREE(type, field)                                                            \
+    ulib_free(soa->field);                                                                         \
+    soa->field = NULL;
+#define P_USOA_COLUMN_REALLOC(type, field)                                                         \
+    {                                                                                              \
+        type *col = (type *)ulib_realloc_array(soa->field, size);                                  \
+        if (!col) return UVEC_ERR;                                                                 \
+        soa->field = col;                                                                          \
+    }
+#define P_USOA_COLUMN_STORE(type, field) soa->field[idx] = row.field;
+#define P_USOA_COLUMN_LOAD(type, field) row.field = soa->field[idx];
+
+/*
+ * Defines a new struct-of-arrays struct.
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ... @ctype{(type, field)} Fields.
+ */
+#define P_USOA_DEF_TYPE(Name, ...)                                                                 \
+    typedef struct Name##_Row {                                                                    \
+        P_USOA_FOREACH(P_USOA_ROW_FIELD, __VA_ARGS__)                                              \
+    } Name##_Row;                                                                                  \
+                                                                                                   \
+    typedef struct Name {                                                                          \
+        /** @cond */                                                                               \
+        P_USOA_FOREACH(P_USOA_COLUMN_FIELD, __VA_ARGS__)                                           \
+        ulib_uint _count;                                                                          \
+        ulib_uint _size;                                                                           \
+        /** @endcond */                                                                            \
+    } Name;
+
+/*
+ * Generates function declarations for the specified struct-of-arrays type.
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ATTRS @ctype{attributes} Attributes of the declarations.
+ */
+#define P_USOA_DECL(Name, ATTRS)                                                                   \
+    /** @cond */                                                                                   \
+    ATTRS void usoa_deinit_##Name(Name *soa);                                                      \
+    ATTRS uvec_ret usoa_reserve_##Name(Name *soa, ulib_uint size);                                 \
+    /** @endcond */
+
+/*
+ * Generates inline function definitions for the specified struct-of-arrays type.
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ * @param ... @ctype{(type, field)} Fields.
+ */
+#define P_USOA_DEF_INLINE(Name, ATTRS, ...)                                                        \
+    /** @cond */                                                                                   \
+    ATTRS ULIB_INLINE Name usoa_##Name(void) {                                                     \
+        Name soa = ulib_struct_init;                                                               \
+        return soa;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint usoa_count_##Name(Name const *soa) {                     \
+        return soa->_count;                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint usoa_size_##Name(Name const *soa) {                      \
+        return soa->_size;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void usoa_clear_##Name(Name *soa) {                                          \
+        soa->_count = 0;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_PURE ULIB_INLINE Name##_Row usoa_get_##Name(Name const *soa, ulib_uint idx) {       \
+        Name##_Row row;                                                                            \
+        P_USOA_FOREACH(P_USOA_COLUMN_LOAD, __VA_ARGS__)                                            \
+        return row;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void usoa_set_##Name(Name *soa, ulib_uint idx, Name##_Row row) {             \
+        P_USOA_FOREACH(P_USOA_COLUMN_STORE, __VA_ARGS__)                                           \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE uvec_ret usoa_push_##Name(Name *soa, Name##_Row row) {                       \
+        if (soa->_count == soa->_size && usoa_reserve_##Name(soa, soa->_count + 1)) {              \
+            return UVEC_ERR;                                                                       \
+        }                                                                                          \
+        ulib_uint const idx = soa->_count++;                                                       \
+        P_USOA_FOREACH(P_USOA_COLUMN_STORE, __VA_ARGS__)                                           \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE bool usoa_pop_##Name(Name *soa, Name##_Row *item) {                          \
+        if (!soa->_count) return false;                                                            \
+        soa->_count--;                                                                             \
+        if (item) *item = usoa_get_##Name(soa, soa->_count);                                       \
+        return true;                                                                               \
+    }                                                                                              \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified struct-of-arrays type.
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ATTRS @ctype{attributes} Attributes of the definitions.
+ * @param ... @ctype{(type, field)} Fields.
+ */
+#define P_USOA_IMPL(Name, ATTRS, ...)                                                              \
+                                                                                                   \
+    ATTRS void usoa_deinit_##Name(Name *soa) {                                                     \
+        P_USOA_FOREACH(P_USOA_COLUMN_FREE, __VA_ARGS__)                                            \
+        soa->_count = soa->_size = 0;                                                              \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret usoa_reserve_##Name(Name *soa, ulib_uint size) {                                \
+        if (size <= soa->_size) return UVEC_OK;                                                    \
+        if (size > (ULIB_UINT_MAX >> 1U) + 1U) return UVEC_ERR;                                    \
+        size = ulib_uint_ceil2(size);                                                              \
+        /* Columns that were already grown are kept if a later one fails. */                       \
+        P_USOA_FOREACH(P_USOA_COLUMN_REALLOC, __VA_ARGS__)                                         \
+        soa->_size = size;                                                                         \
+        return UVEC_OK;                                                                            \
+    }
+
+/**
+ * @defgroup USoa_definitions USoa type definitions
+ * @{
+ */
+
+/**
+ * Declares a new struct-of-arrays type.
+ *
+ * Usage example:
+ * @code
+ * USOA_DECL(Particles, (float, x), (float, y), (ulib_uint, id))
+ * @endcode
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ... @ctype{(type, field)} Fields, up to @val{USOA_MAX_FIELDS}.
+ */
+#define USOA_DECL(Name, ...)                                                                       \
+    P_USOA_DEF_TYPE(Name, __VA_ARGS__)                                                             \
+    P_USOA_DECL(Name, ulib_unused)                                                                 \
+    P_USOA_DEF_INLINE(Name, ulib_unused, __VA_ARGS__)
+
+/**
+ * Declares a new struct-of-arrays type, prepending a specifier to the generated declarations.
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param SPEC @ctype{specifier} Specifier.
+ * @param ... @ctype{(type, field)} Fields, up to @val{USOA_MAX_FIELDS}.
+ */
+#define USOA_DECL_SPEC(Name, SPEC, ...)                                                            \
+    P_USOA_DEF_TYPE(Name, __VA_ARGS__)                                                             \
+    P_USOA_DECL(Name, SPEC ulib_unused)                                                            \
+    P_USOA_DEF_INLINE(Name, ulib_unused, __VA_ARGS__)
+
+/**
+ * Implements a previously declared struct-of-arrays type.
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ... @ctype{(type, field)} Fields, which must match those of the declaration.
+ */
+#define USOA_IMPL(Name, ...) P_USOA_IMPL(Name, ulib_unused, __VA_ARGS__)
+
+/**
+ * Defines a new static struct-of-arrays type.
+ *
+ * Usage example:
+ * @code
+ * USOA_INIT(Particles, (float, x), (float, y), (ulib_uint, id))
+ * @endcode
+ *
+ * @param Name @ctype{symbol} Struct-of-arrays type.
+ * @param ... @ctype{(type, field)} Fields, up to @val{USOA_MAX_FIELDS}.
+ */
+#define USOA_INIT(Name, ...)                                                                       \
+    P_USOA_DEF_TYPE(Name, __VA_ARGS__)                                                             \
+    P_USOA_DECL(Name, ULIB_INLINE ulib_unused)                                                     \
+    P_USOA_DEF_INLINE(Name, ulib_unused, __VA_ARGS__)                                              \
+    P_USOA_IMPL(Name, ULIB_INLINE ulib_unused, __VA_ARGS__)
+
+/// @}
+
+/**
+ * @defgroup USoa_api USoa API
+ * @{
+ */
+
+/**
+ * Initializes a new struct-of-arrays vector.
+ *
+ * @param Name Struct-of-arrays type.
+ * @return Initialized struct-of-arrays instance.
+ *
+ * @destructor{usoa_deinit}
+ * @alias Name usoa(symbol Name);
+ */
+#define usoa(Name) ULIB_MACRO_CONCAT(usoa_, Name)()
+
+/**
+ * De-initializes a struct-of-arrays vector previously initialized via @func{usoa(Name)}.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays vector to deinitialize.
+ *
+ * @alias void usoa_deinit(symbol Name, Name *soa);
+ */
+#define usoa_deinit(Name, soa) ULIB_MACRO_CONCAT(usoa_deinit_, Name)(soa)
+
+/**
+ * Returns the number of records in the struct-of-arrays vector.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @return Number of records.
+ *
+ * @alias ulib_uint usoa_count(symbol Name, Name const *soa);
+ */
+#define usoa_count(Name, soa) ULIB_MACRO_CONCAT(usoa_count_, Name)(soa)
+
+/**
+ * Returns the number of records the struct-of-arrays vector can hold without reallocating.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @return Maximum number of records.
+ *
+ * @alias ulib_uint usoa_size(symbol Name, Name const *soa);
+ */
+#define usoa_size(Name, soa) ULIB_MACRO_CONCAT(usoa_size_, Name)(soa)
+
+/**
+ * Ensures the struct-of-arrays vector can hold at least as many records as `size`.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @param size Number of records the vector should be able to hold.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret usoa_reserve(symbol Name, Name *soa, ulib_uint size);
+ */
+#define usoa_reserve(Name, soa, size) ULIB_MACRO_CONCAT(usoa_reserve_, Name)(soa, size)
+
+/**
+ * Removes all the records in the struct-of-arrays vector.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ *
+ * @alias void usoa_clear(symbol Name, Name *soa);
+ */
+#define usoa_clear(Name, soa) ULIB_MACRO_CONCAT(usoa_clear_, Name)(soa)
+
+/**
+ * Returns the record at the specified index, gathered from all columns.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @param idx Index.
+ * @return Record at the specified index.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias USoaRow(Name) usoa_get(symbol Name, Name const *soa, ulib_uint idx);
+ */
+#define usoa_get(Name, soa, idx) ULIB_MACRO_CONCAT(usoa_get_, Name)(soa, idx)
+
+/**
+ * Replaces the record at the specified index, scattering its fields to all columns.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @param idx Index.
+ * @param row Replacement record.
+ *
+ * @warning Passing an out of bounds index results in undefined behavior.
+ * @alias void usoa_set(symbol Name, Name *soa, ulib_uint idx, USoaRow(Name) row);
+ */
+#define usoa_set(Name, soa, idx, row) ULIB_MACRO_CONCAT(usoa_set_, Name)(soa, idx, row)
+
+/**
+ * Pushes the specified record to the end of the struct-of-arrays vector.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @param row Record to push.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret usoa_push(symbol Name, Name *soa, USoaRow(Name) row);
+ */
+#define usoa_push(Name, soa, row) ULIB_MACRO_CONCAT(usoa_push_, Name)(soa, row)
+
+/**
+ * Removes and returns the last record of the struct-of-arrays vector.
+ *
+ * @param Name Struct-of-arrays type.
+ * @param soa Struct-of-arrays instance.
+ * @param[out] row Removed record.
+ * @return True if a record was removed, false if the vector was empty.
+ *
+ * @alias bool usoa_pop(symbol Name, Name *soa, USoaRow(Name) *row);
+ */
+#define usoa_pop(Name, soa, row) ULIB_MACRO_CONCAT(usoa_pop_, Name)(soa, row)
+
+/**
+ * Returns the array holding the specified field of all records.
+ *
+ * @param soa @ctype{Name *} Struct-of-arrays instance.
+ * @param field @ctype{symbol} Field name.
+ * @return @ctype{type *} Column array, holding @func{usoa_count} elements.
+ *
+ * @note Column arrays are invalidated by any operation that grows the vector.
+ */
+#define usoa_column(soa, field) ((soa)->field)
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // USOA_H
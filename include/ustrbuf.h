@@ -102,6 +102,41 @@ uvec_ret ustrbuf_append_format(UStrBuf *buf, char const *format, ...);
 ULIB_API
 uvec_ret ustrbuf_append_format_list(UStrBuf *buf, char const *format, va_list args);
 
+/**
+ * Appends the decimal representation of an integer to the string buffer.
+ *
+ * @param buf String buffer.
+ * @param value Integer.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note This is faster than @func{ustrbuf_append_format}, as it does not parse a format string.
+ */
+ULIB_API
+uvec_ret ustrbuf_append_int(UStrBuf *buf, ulib_int value);
+
+/**
+ * Appends the decimal representation of an unsigned integer to the string buffer.
+ *
+ * @param buf String buffer.
+ * @param value Unsigned integer.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ */
+ULIB_API
+uvec_ret ustrbuf_append_uint(UStrBuf *buf, ulib_uint value);
+
+/**
+ * Appends the shortest decimal representation of a float that converts back to the same value
+ * to the string buffer.
+ *
+ * @param buf String buffer.
+ * @param value Float.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @see @func{ulib_str_from_float} for details about the representation.
+ */
+ULIB_API
+uvec_ret ustrbuf_append_float(UStrBuf *buf, ulib_float value);
+
 /**
  * Converts the string buffer into a @type{UString} and deinitializes the buffer.
  *
@@ -48,6 +48,17 @@ typedef enum ustream_ret {
 
 } ustream_ret;
 
+/// Describes a memory buffer in vectored writes.
+typedef struct UIOVec {
+
+    /// Buffer.
+    void const *base;
+
+    /// Buffer size.
+    size_t size;
+
+} UIOVec;
+
 /// Models an input stream.
 typedef struct UIStream {
 
@@ -316,6 +327,19 @@ typedef struct UOStream {
      */
     ustream_ret (*free)(void *ctx);
 
+    /**
+     * Pointer to a function that writes the contents of multiple buffers into the stream.
+     *
+     * @param ctx Stream context.
+     * @param bufs Buffers.
+     * @param count Number of buffers.
+     * @param[out] written Number of bytes written.
+     * @return Return code.
+     *
+     * @note Can be NULL, in which case the stream will fallback to `write`.
+     */
+    ustream_ret (*writev)(void *ctx, UIOVec const *bufs, size_t count, size_t *written);
+
 } UOStream;
 
 /**
@@ -371,7 +395,8 @@ UOStream uostream(void *ctx, ustream_ret (*write_func)(void *, void const *, siz
                   ustream_ret (*writef_func)(void *, size_t *, char const *, va_list),
                   ustream_ret (*flush_func)(void *), ustream_ret (*reset_func)(void *),
                   ustream_ret (*free_func)(void *)) {
-    UOStream s = { USTREAM_OK, 0, ctx, write_func, writef_func, flush_func, reset_func, free_func };
+    UOStream s = { USTREAM_OK, 0, ctx, write_func, writef_func, flush_func, reset_func, free_func,
+                   NULL };
     return s;
 }
 
@@ -425,6 +450,21 @@ ustream_ret uostream_reset(UOStream *stream);
 ULIB_API
 ustream_ret uostream_write(UOStream *stream, void const *buf, size_t count, size_t *written);
 
+/**
+ * Writes the contents of multiple buffers into the stream, in order.
+ *
+ * @param stream Output stream.
+ * @param bufs Buffers.
+ * @param count Number of buffers.
+ * @param[out] written Number of bytes written.
+ * @return Return code.
+ *
+ * @note Streams backed by files use vectored IO where available, which is much faster
+ *       than writing each buffer separately.
+ */
+ULIB_API
+ustream_ret uostream_writev(UOStream *stream, UIOVec const *bufs, size_t count, size_t *written);
+
 /**
  * Writes a formatted string into the stream.
  *
@@ -472,6 +512,42 @@ ustream_ret uostream_write_buf(UOStream *stream, char const *buf, size_t *writte
 ULIB_API
 ustream_ret uostream_write_string(UOStream *stream, UString const *string, size_t *written);
 
+/**
+ * Writes the decimal representation of an integer into the stream.
+ *
+ * @param stream Output stream.
+ * @param value Integer.
+ * @param[out] written Number of bytes written.
+ * @return Return code.
+ */
+ULIB_API
+ustream_ret uostream_write_int(UOStream *stream, ulib_int value, size_t *written);
+
+/**
+ * Writes the decimal representation of an unsigned integer into the stream.
+ *
+ * @param stream Output stream.
+ * @param value Unsigned integer.
+ * @param[out] written Number of bytes written.
+ * @return Return code.
+ */
+ULIB_API
+ustream_ret uostream_write_uint(UOStream *stream, ulib_uint value, size_t *written);
+
+/**
+ * Writes the shortest decimal representation of a float that converts back to the same value
+ * into the stream.
+ *
+ * @param stream Output stream.
+ * @param value Float.
+ * @param[out] written Number of bytes written.
+ * @return Return code.
+ *
+ * @see @func{ulib_str_from_float} for details about the representation.
+ */
+ULIB_API
+ustream_ret uostream_write_float(UOStream *stream, ulib_float value, size_t *written);
+
 /**
  * Writes the specified date and time into the stream.
  *
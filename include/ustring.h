@@ -17,6 +17,7 @@
 #include "unumber.h"
 #include "ustring_raw.h"
 #include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
 ULIB_BEGIN_DECLS
@@ -36,6 +37,14 @@ struct p_ustring_large {
 
 #define P_USTRING_SIZE sizeof(struct p_ustring_large)
 
+// Large strings allocated by the library are shared: their buffer is preceded by a reference
+// count, and they are marked by a flag that takes a spare byte of the flags if there is one,
+// otherwise the second most significant bit of the size.
+#define P_USTRING_SHARED_IN_SIZE (P_USTRING_FLAGS_SIZE == sizeof(ulib_uint))
+#define P_USTRING_SHARED_BYTE (P_USTRING_SHARED_IN_SIZE ? P_USTRING_FLAGS_SIZE - 1 : 0)
+#define P_USTRING_FLAG_SHARED ((ulib_byte)(P_USTRING_SHARED_IN_SIZE ? 0x40 : 0x01))
+#define P_USTRING_SIZE_MASK ((ulib_uint)-1 >> (P_USTRING_SHARED_IN_SIZE ? 2U : 1U))
+
 ULIB_CONST
 ULIB_INLINE
 ulib_uint p_ustring_large_size(struct p_ustring_large string) {
@@ -46,7 +55,7 @@ ulib_uint p_ustring_large_size(struct p_ustring_large string) {
         size |= (ulib_uint)string._flags[offset + i] << (i * CHAR_BIT);
     }
 
-    return size & ((ulib_uint)-1 >> 1U);
+    return size & P_USTRING_SIZE_MASK;
 }
 
 #define P_USTRING_FLAG_LARGE ((ulib_byte)0x80)
@@ -57,7 +66,10 @@ ulib_uint p_ustring_large_size(struct p_ustring_large string) {
 #define p_ustring_last_byte_length(byte) (p_ustring_last_byte_size(byte) - 1)
 
 #define p_ustring_is_large(str) p_ustring_last_byte_is_large(p_ustring_last_byte(str))
+#define p_ustring_is_shared(str)                                                                   \
+    (p_ustring_is_large(str) && ((str)._l._flags[P_USTRING_SHARED_BYTE] & P_USTRING_FLAG_SHARED))
 #define p_ustring_length_is_small(l) ((l) < P_USTRING_SIZE)
+#define p_ustring_length_is_valid(l) ((l) < P_USTRING_SIZE_MASK)
 #define p_ustring_init_small(size)                                                                 \
     {                                                                                              \
         ._s = { [P_USTRING_SIZE - 1] = (ulib_byte)((P_USTRING_SIZE - (size))) },                   \
@@ -73,6 +85,9 @@ ulib_uint p_ustring_large_size(struct p_ustring_large string) {
 /**
  * An immutable string.
  *
+ * Short strings are stored inline, larger ones are stored in a separate buffer, which is shared
+ * between duplicates if it has been allocated by the library (see @func{ustring_dup}).
+ *
  * @struct UString
  */
 typedef struct UString {
@@ -286,6 +301,10 @@ UString ustring_wrap_buf(char const *buf) {
  * @return Duplicated string.
  *
  * @destructor{ustring_deinit}
+ * @note Large strings allocated by the library are reference counted, and their duplicates
+ *       share the same buffer, so duplicating them is a constant time operation that does not
+ *       allocate. Reference counts are atomic, unless threads are disabled via
+ *       the **ULIB_NO_THREADS** definition.
  */
 ULIB_API
 UString ustring_dup(UString string);
@@ -426,6 +445,56 @@ UString ustring_to_upper(UString string);
 ULIB_API
 UString ustring_to_lower(UString string);
 
+/**
+ * Checks whether the string is valid UTF-8.
+ *
+ * @param string String.
+ * @return True if the string is valid UTF-8, false otherwise.
+ */
+ULIB_PURE
+ULIB_INLINE
+bool ustring_is_valid_utf8(UString string) {
+    return ulib_str_is_valid_utf8(ustring_data(string), ustring_length(string));
+}
+
+/**
+ * Returns the number of code points in the specified UTF-8 string.
+ *
+ * @param string String, must be valid UTF-8.
+ * @return Number of code points.
+ */
+ULIB_PURE
+ULIB_INLINE
+ulib_uint ustring_utf8_length(UString string) {
+    return (ulib_uint)ulib_str_utf8_length(ustring_data(string), ustring_length(string));
+}
+
+/**
+ * Converts the specified UTF-8 string to UTF-16.
+ *
+ * @param string String.
+ * @param[out] length Length of the converted string (code units), can be NULL.
+ * @return Null-terminated UTF-16 string, in the native byte order, or NULL if the string
+ *         is not valid UTF-8 or if memory allocation fails.
+ *
+ * @destructor{ulib_free}
+ */
+ULIB_API
+uint16_t *ustring_to_utf16(UString string, size_t *length);
+
+/**
+ * Initializes a new string by converting the specified UTF-16 string to UTF-8.
+ *
+ * @param src UTF-16 string, in the native byte order.
+ * @param length Length of the UTF-16 string (code units).
+ * @return Initialized string, or @val{ustring_null} if the string contains unpaired surrogates,
+ *         or if memory allocation fails.
+ *
+ * @destructor{ustring_deinit}
+ */
+ULIB_API
+UString ustring_from_utf16(uint16_t const *src, size_t length);
+
 /**
  * Returns the index of the first occurrence of the specified character.
  *
@@ -507,6 +576,20 @@ ULIB_API
 ULIB_PURE
 bool ustring_equals(UString lhs, UString rhs);
 
+/**
+ * Checks whether two strings are equal, ignoring the case of ASCII letters.
+ *
+ * @param lhs First string.
+ * @param rhs Second string.
+ * @return True if the two strings are equal, false otherwise.
+ *
+ * @note Unlike comparing the strings returned by @func{ustring_to_lower},
+ *       this function does not allocate.
+ */
+ULIB_API
+ULIB_PURE
+bool ustring_equals_ignore_case(UString lhs, UString rhs);
+
 /**
  * Checks whether lhs precedes rhs in lexicographic order.
  *
@@ -539,6 +622,61 @@ ULIB_API
 ULIB_PURE
 ulib_uint ustring_hash(UString string);
 
+/**
+ * Returns the hash of the specified string, ignoring the case of ASCII letters.
+ *
+ * @param string String.
+ * @return Hash, equal to the hash of the lowercased string.
+ *
+ * @note Together with @func{ustring_equals_ignore_case}, this function can be used
+ *       to declare hash tables with case-insensitive string keys.
+ */
+ULIB_API
+ULIB_PURE
+ulib_uint ustring_hash_ignore_case(UString string);
+
+/**
+ * Parses the string as a decimal integer, independently of the current locale.
+ *
+ * @param string String.
+ * @param[out] out Parsed value.
+ * @return Return code.
+ *
+ * @see @func{ulib_str_parse_int}
+ */
+ULIB_INLINE
+ulib_ret ustring_parse_int(UString string, ulib_int *out) {
+    return ulib_str_parse_int(ustring_data(string), ustring_length(string), out);
+}
+
+/**
+ * Parses the string as a decimal unsigned integer, independently of the current locale.
+ *
+ * @param string String.
+ * @param[out] out Parsed value.
+ * @return Return code.
+ *
+ * @see @func{ulib_str_parse_uint}
+ */
+ULIB_INLINE
+ulib_ret ustring_parse_uint(UString string, ulib_uint *out) {
+    return ulib_str_parse_uint(ustring_data(string), ustring_length(string), out);
+}
+
+/**
+ * Parses the string as a decimal float, independently of the current locale.
+ *
+ * @param string String.
+ * @param[out] out Parsed value.
+ * @return Return code.
+ *
+ * @see @func{ulib_str_parse_float}
+ */
+ULIB_INLINE
+ulib_ret ustring_parse_float(UString string, ulib_float *out) {
+    return ulib_str_parse_float(ustring_data(string), ustring_length(string), out);
+}
+
 /**
  * Converts the string into an integer.
  *
@@ -586,6 +724,8 @@ void ustring_deinit(UString *string);
  * @return Buffer.
  *
  * @destructor{ulib_free}
+ * @note The buffer is handed over in constant time, unless the string is small, or it shares
+ *       its buffer with duplicates that are still alive, in which case it is copied.
  */
 ULIB_API
 char *ustring_deinit_return_data(UString *string);
@@ -618,6 +758,109 @@ bool ustring_is_empty(UString string) {
 
 /// @}
 
+/**
+ * Iterator over the tokens of a string.
+ *
+ * Tokens are non-owning views over the iterated string, obtained via @func{ustring_wrap},
+ * therefore iterating does not allocate memory.
+ *
+ * @note Tokens are valid as long as the iterated string is, they are not necessarily
+ *       null-terminated, and you must not call @func{ustring_deinit} on them.
+ */
+typedef struct UStrSplit {
+    /// @cond
+    UString _string;
+    UString _sep;
+    ulib_uint _pos;
+    ulib_byte _mode;
+    bool _done;
+    /// @endcond
+} UStrSplit;
+
+/**
+ * @defgroup UStrSplit UStrSplit API
+ * @{
+ */
+
+/// @cond
+typedef enum p_ustrsplit_mode {
+    P_USTRSPLIT_STRING,
+    P_USTRSPLIT_ANY,
+    P_USTRSPLIT_LINES,
+} p_ustrsplit_mode;
+
+ULIB_CONST
+ULIB_INLINE
+UStrSplit p_ustrsplit(UString string, UString sep, p_ustrsplit_mode mode) {
+    UStrSplit split;
+    split._string = string;
+    split._sep = sep;
+    split._pos = 0;
+    split._mode = (ulib_byte)mode;
+    split._done = mode == P_USTRSPLIT_LINES && ustring_is_empty(string);
+    return split;
+}
+/// @endcond
+
+/**
+ * Returns an iterator over the tokens of the string that are delimited by a separator.
+ *
+ * @param string String.
+ * @param sep Separator.
+ * @return Iterator.
+ *
+ * @note Consecutive separators delimit empty tokens, and an empty string yields one empty token.
+ *       If the separator is empty, the whole string is yielded as a single token.
+ */
+ULIB_CONST
+ULIB_INLINE
+UStrSplit ustring_split_iter(UString string, UString sep) {
+    return p_ustrsplit(string, sep, P_USTRSPLIT_STRING);
+}
+
+/**
+ * Returns an iterator over the tokens of the string that are delimited by any of the
+ * specified bytes.
+ *
+ * @param string String.
+ * @param delims Delimiter bytes.
+ * @return Iterator.
+ *
+ * @note Consecutive delimiters delimit empty tokens, and an empty string yields one empty token.
+ */
+ULIB_CONST
+ULIB_INLINE
+UStrSplit ustring_split_any(UString string, UString delims) {
+    return p_ustrsplit(string, delims, P_USTRSPLIT_ANY);
+}
+
+/**
+ * Returns an iterator over the lines of the string.
+ *
+ * Lines are terminated by either LF or CRLF sequences, which are not included in the lines.
+ * The final line terminator is optional.
+ *
+ * @param string String.
+ * @return Iterator.
+ */
+ULIB_CONST
+ULIB_INLINE
+UStrSplit ustring_lines_iter(UString string) {
+    return p_ustrsplit(string, ustring_empty, P_USTRSPLIT_LINES);
+}
+
+/**
+ * Retrieves the next token.
+ *
+ * @param split Iterator.
+ * @param[out] token Token.
+ * @return True if a token has been retrieved, false if there are no more tokens.
+ */
+ULIB_API
+bool ustrsplit_next(UStrSplit *split, UString *token);
+
+/// @}
+
 ULIB_END_DECLS
 
 #endif // USTRING_H
@@ -13,8 +13,10 @@
 #define USTRING_RAW_H
 
 #include "uattrs.h"
+#include "ulib_ret.h"
 #include "unumber.h"
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -127,14 +129,9 @@ size_t ulib_str_flength_list(char const *format, va_list args);
  * @param length String length.
  * @return True if the string does not contain lowercase characters, false otherwise.
  */
+ULIB_API
 ULIB_PURE
-ULIB_INLINE
-bool ulib_str_is_upper(char const *string, size_t length) {
-    while (length--) {
-        if (ulib_char_is_lower(string[length])) return false;
-    }
-    return true;
-}
+bool ulib_str_is_upper(char const *string, size_t length);
 
 /**
  * Checks if the string does not contain uppercase characters.
@@ -143,14 +140,9 @@ bool ulib_str_is_upper(char const *string, size_t length) {
  * @param length String length.
  * @return True if the string does not contain uppercase characters, false otherwise.
  */
+ULIB_API
 ULIB_PURE
-ULIB_INLINE
-bool ulib_str_is_lower(char const *string, size_t length) {
-    while (length--) {
-        if (ulib_char_is_upper(string[length])) return false;
-    }
-    return true;
-}
+bool ulib_str_is_lower(char const *string, size_t length);
 
 /**
  * Converts the given string to uppercase.
@@ -161,10 +153,8 @@ bool ulib_str_is_lower(char const *string, size_t length) {
  *
  * @note `dst` and `src` can be equal.
  */
-ULIB_INLINE
-void ulib_str_to_upper(char *dst, char const *src, size_t length) {
-    while (length--) dst[length] = ulib_char_to_upper(src[length]);
-}
+ULIB_API
+void ulib_str_to_upper(char *dst, char const *src, size_t length);
 
 /**
  * Converts the given string to lowercase.
@@ -175,10 +165,93 @@ void ulib_str_to_upper(char *dst, char const *src, size_t length) {
  *
  * @note `dst` and `src` can be equal.
  */
-ULIB_INLINE
-void ulib_str_to_lower(char *dst, char const *src, size_t length) {
-    while (length--) dst[length] = ulib_char_to_lower(src[length]);
-}
+ULIB_API
+void ulib_str_to_lower(char *dst, char const *src, size_t length);
+
+/**
+ * Checks whether two strings are equal, ignoring the case of ASCII letters.
+ *
+ * @param lhs First string.
+ * @param rhs Second string.
+ * @param length Length of both strings.
+ * @return True if the two strings are equal, false otherwise.
+ */
+ULIB_API
+ULIB_PURE
+bool ulib_str_equals_ignore_case(char const *lhs, char const *rhs, size_t length);
+
+/**
+ * Checks whether the string is valid UTF-8.
+ *
+ * @param src String.
+ * @param length String length.
+ * @return True if the string is valid UTF-8, false otherwise.
+ *
+ * @note Overlong encodings, surrogates and code points greater than U+10FFFF are rejected.
+ *       On AVX2, SSSE3 and NEON targets validation is vectorized, and it only takes
+ *       a handful of instructions per block of 16 or 32 bytes.
+ */
+ULIB_API
+ULIB_PURE
+bool ulib_str_is_valid_utf8(char const *src, size_t length);
+
+/**
+ * Returns the number of code points in the specified UTF-8 string.
+ *
+ * @param src String.
+ * @param length String length.
+ * @return Number of code points.
+ *
+ * @note The string is assumed to be valid UTF-8, otherwise the result is unspecified.
+ */
+ULIB_API
+ULIB_PURE
+size_t ulib_str_utf8_length(char const *src, size_t length);
+
+/**
+ * Converts the specified UTF-8 string to UTF-16.
+ *
+ * @param src UTF-8 string.
+ * @param length Length of the UTF-8 string.
+ * @param dst Destination buffer, must have room for at least `length` code units.
+ * @param[out] written Number of code units written, can be NULL.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if the string is not valid UTF-8,
+ *         in which case `written` holds the number of code units converted
+ *         before the first invalid sequence.
+ *
+ * @note The output is in the native byte order, and it is not null-terminated.
+ */
+ULIB_API
+ulib_ret ulib_str_utf8_to_utf16(char const *src, size_t length, uint16_t *dst, size_t *written);
+
+/**
+ * Returns the length of the UTF-8 encoding of the specified UTF-16 string.
+ *
+ * @param src UTF-16 string.
+ * @param length Length of the UTF-16 string (code units).
+ * @return Length of the UTF-8 encoding (bytes).
+ *
+ * @note The string is assumed to be valid UTF-16, otherwise the result is an upper bound.
+ */
+ULIB_API
+ULIB_PURE
+size_t ulib_str_utf8_length_from_utf16(uint16_t const *src, size_t length);
+
+/**
+ * Converts the specified UTF-16 string to UTF-8.
+ *
+ * @param src UTF-16 string, in the native byte order.
+ * @param length Length of the UTF-16 string (code units).
+ * @param dst Destination buffer, must have room for at least the number of bytes returned
+ *            by @func{ulib_str_utf8_length_from_utf16}, or `3 * length` bytes.
+ * @param[out] written Number of bytes written, can be NULL.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if the string contains unpaired surrogates,
+ *         in which case `written` holds the number of bytes converted before the first one.
+ *
+ * @note The output is not null-terminated.
+ */
+ULIB_API
+ulib_ret ulib_str_utf16_to_utf8(uint16_t const *src, size_t length, char *dst, size_t *written);
 
 /**
  * Converts the given string into an integer.
@@ -248,18 +321,136 @@ ulib_float ulib_str_to_float(char const *src, char **end) {
     return (ulib_float)ret;
 }
 
+/**
+ * Size of a buffer that can hold the string representation of any number,
+ * as produced by @func{ulib_str_from_int}, @func{ulib_str_from_uint} and
+ * @func{ulib_str_from_float}.
+ */
+#define ULIB_NUM_STR_SIZE 32
+
+/**
+ * Writes the decimal representation of an integer into the specified buffer.
+ *
+ * @param dst Destination buffer, of at least @val{ULIB_NUM_STR_SIZE} bytes.
+ * @param value Integer.
+ * @return Number of characters written.
+ *
+ * @note The representation is not null-terminated.
+ */
+ULIB_API
+size_t ulib_str_from_int(char *dst, ulib_int value);
+
+/**
+ * Writes the decimal representation of an unsigned integer into the specified buffer.
+ *
+ * @param dst Destination buffer, of at least @val{ULIB_NUM_STR_SIZE} bytes.
+ * @param value Unsigned integer.
+ * @return Number of characters written.
+ *
+ * @note The representation is not null-terminated.
+ */
+ULIB_API
+size_t ulib_str_from_uint(char *dst, ulib_uint value);
+
+/**
+ * Writes the shortest decimal representation of a float that converts back to the same value
+ * into the specified buffer.
+ *
+ * Values whose decimal exponent is in the `[-6, 21)` range are written in positional notation,
+ * other values are written in scientific notation (e.g. `1e+21`). Integral values are written
+ * without a fractional part. Infinities and NaNs are written as `inf`, `-inf` and `nan`.
+ *
+ * @param dst Destination buffer, of at least @val{ULIB_NUM_STR_SIZE} bytes.
+ * @param value Float.
+ * @return Number of characters written.
+ *
+ * @note The representation is not null-terminated.
+ * @note Digits are generated via the Grisu3 algorithm. In the rare cases in which it cannot
+ *       prove its result optimal, the digits generated via Grisu2 are shortened for as long as
+ *       they convert back to the same value, so the representation is always the shortest one.
+ */
+ULIB_API
+size_t ulib_str_from_float(char *dst, ulib_float value);
+
+/**
+ * Parses a decimal integer.
+ *
+ * The buffer must only contain the number, optionally preceded by a `+` or `-` sign.
+ *
+ * @param src Source buffer, not necessarily null-terminated.
+ * @param length Length of the buffer.
+ * @param[out] out Parsed value.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if the buffer does not contain a valid number,
+ *         or if the number is out of range.
+ *
+ * @note Unlike @func{ulib_str_to_int}, this function does not depend on the current locale.
+ */
+ULIB_API
+ulib_ret ulib_str_parse_int(char const *src, size_t length, ulib_int *out);
+
+/**
+ * Parses a decimal unsigned integer.
+ *
+ * The buffer must only contain the number, optionally preceded by a `+` sign.
+ *
+ * @param src Source buffer, not necessarily null-terminated.
+ * @param length Length of the buffer.
+ * @param[out] out Parsed value.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if the buffer does not contain a valid number,
+ *         or if the number is out of range.
+ *
+ * @note Unlike @func{ulib_str_to_uint}, this function does not depend on the current locale.
+ */
+ULIB_API
+ulib_ret ulib_str_parse_uint(char const *src, size_t length, ulib_uint *out);
+
+/**
+ * Parses a decimal float.
+ *
+ * The buffer must only contain the number, optionally preceded by a `+` or `-` sign.
+ * Numbers consist of digits with an optional `.` decimal separator, followed by an optional
+ * exponent (e.g. `-1.5e+3`). Infinities and NaNs (`inf`, `infinity`, `nan`) are also accepted,
+ * regardless of case. Values are correctly rounded to the nearest representable float.
+ *
+ * @param src Source buffer, not necessarily null-terminated.
+ * @param length Length of the buffer.
+ * @param[out] out Parsed value.
+ * @return @val{ULIB_OK} on success, @val{ULIB_ERR} if the buffer does not contain a valid number,
+ *         @val{ULIB_ERR_MEM} on allocation failure.
+ *
+ * @note Unlike @func{ulib_str_to_float}, this function does not depend on the current locale.
+ * @note Numbers with up to 19 significant digits are converted via the Eisel-Lemire algorithm,
+ *       which does not allocate. Longer numbers fall back to @cfunc{strtod} if their value
+ *       cannot be determined from their first 19 digits.
+ */
+ULIB_API
+ulib_ret ulib_str_parse_float(char const *src, size_t length, ulib_float *out);
+
 /**
  * Finds the last occurrence of a character.
  *
  * @param haystack Memory area.
  * @param c Character to find.
  * @param h_len Length of the memory area.
- * @return Pointer to the first occurrence of the character, or NULL.
+ * @return Pointer to the last occurrence of the character, or NULL.
  */
 ULIB_API
 ULIB_PURE
 void *ulib_mem_chr_last(void const *haystack, int c, size_t h_len);
 
+/**
+ * Finds the first occurrence of any of the specified bytes.
+ *
+ * @param haystack Memory area.
+ * @param h_len Length of the memory area.
+ * @param set Bytes to find.
+ * @param set_len Number of bytes to find.
+ * @return Pointer to the first byte that belongs to the set, or NULL.
+ */
+ULIB_API
+ULIB_PURE
+void *ulib_mem_chr_any(void const *haystack, size_t h_len, void const *set, size_t set_len);
+
 /**
  * Finds the first occurrence of the specified substring.
  *
@@ -0,0 +1,229 @@
+/**
+ * A string interning pool.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef USTRPOOL_H
+#define USTRPOOL_H
+
+#include "uattrs.h"
+#include "unumber.h"
+#include "ustring.h"
+#include "uutils.h"
+#include "uvec_builtin.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+ULIB_BEGIN_DECLS
+
+/// @cond
+struct p_ustrpool_entry {
+    UString string;
+    ulib_uint hash;
+    ulib_uint id;
+};
+
+struct p_ustrpool_chunk;
+/// @endcond
+
+/**
+ * Interned string, also known as symbol.
+ *
+ * Symbols are canonical: each distinct string is interned once per pool, therefore two symbols
+ * obtained from the same pool are equal if and only if they refer to the same string.
+ * Comparing, hashing and retrieving the identifier of a symbol are constant time operations.
+ *
+ * @note Symbols are valid until the pool they have been obtained from is deinitialized.
+ */
+typedef struct UStrSym {
+    /// @cond
+    struct p_ustrpool_entry const *_e;
+    /// @endcond
+} UStrSym;
+
+/**
+ * String interning pool.
+ *
+ * Interned strings are stored in large memory chunks owned by the pool, which are only released
+ * when the pool is deinitialized. Each string is assigned a symbol, and an integer identifier
+ * in the `[0, count)` range, according to insertion order.
+ */
+typedef struct UStrPool {
+    /// @cond
+    struct p_ustrpool_entry **_table;
+    struct p_ustrpool_chunk *_chunks;
+    UVec(ulib_ptr) _entries;
+    ulib_uint _table_size;
+    /// @endcond
+} UStrPool;
+
+/**
+ * @defgroup UStrPool_constants UStrPool constants
+ * @{
+ */
+
+/// Size of the memory chunks allocated by string pools (B).
+#ifndef USTRPOOL_CHUNK_SIZE
+#define USTRPOOL_CHUNK_SIZE 16384
+#endif
+
+/// @}
+
+/**
+ * @defgroup UStrPool UStrPool API
+ * @{
+ */
+
+/// Null symbol.
+ULIB_API
+extern UStrSym const ustrsym_null;
+
+/**
+ * Initializes a new, empty string pool.
+ *
+ * @return Initialized string pool.
+ *
+ * @destructor{ustrpool_deinit}
+ */
+ULIB_CONST
+ULIB_INLINE
+UStrPool ustrpool(void) {
+    UStrPool pool = ulib_struct_init;
+    pool._entries = uvec(ulib_ptr);
+    return pool;
+}
+
+/**
+ * Deinitializes a string pool, invalidating its symbols and strings.
+ *
+ * @param pool String pool.
+ */
+ULIB_API
+void ustrpool_deinit(UStrPool *pool);
+
+/**
+ * Returns the number of strings in the pool.
+ *
+ * @param pool String pool.
+ * @return Number of strings.
+ */
+ULIB_PURE
+ULIB_INLINE
+ulib_uint ustrpool_count(UStrPool const *pool) {
+    return uvec_count(ulib_ptr, &pool->_entries);
+}
+
+/**
+ * Interns the specified string.
+ *
+ * @param pool String pool.
+ * @param string String.
+ * @return Symbol of the interned string, or @val{ustrsym_null} on allocation failure.
+ *
+ * @note The string is copied into the pool, so it can be deinitialized afterwards.
+ */
+ULIB_API
+UStrSym ustrpool_intern(UStrPool *pool, UString string);
+
+/**
+ * Returns the symbol of the specified string, if it has been interned.
+ *
+ * @param pool String pool.
+ * @param string String.
+ * @return Symbol of the string, or @val{ustrsym_null} if the string is not in the pool.
+ */
+ULIB_API
+ULIB_PURE
+UStrSym ustrpool_lookup(UStrPool const *pool, UString string);
+
+/**
+ * Returns the symbol with the specified identifier.
+ *
+ * @param pool String pool.
+ * @param id Symbol identifier, must be lower than the number of strings in the pool.
+ * @return Symbol.
+ */
+ULIB_PURE
+ULIB_INLINE
+UStrSym ustrpool_get(UStrPool const *pool, ulib_uint id) {
+    UStrSym sym = { (struct p_ustrpool_entry const *)uvec_get(ulib_ptr, &pool->_entries, id) };
+    return sym;
+}
+
+/**
+ * Checks whether the symbol is null.
+ *
+ * @param sym Symbol.
+ * @return True if the symbol is null, false otherwise.
+ */
+ULIB_CONST
+ULIB_INLINE
+bool ustrsym_is_null(UStrSym sym) {
+    return sym._e == NULL;
+}
+
+/**
+ * Returns the canonical string of the symbol.
+ *
+ * @param sym Symbol.
+ * @return String.
+ *
+ * @note Canonical strings that are not small enough to be stored inline share their buffer,
+ *       which is owned by the pool. You must not call @func{ustring_deinit} on them.
+ */
+ULIB_PURE
+ULIB_INLINE
+UString ustrsym_string(UStrSym sym) {
+    return sym._e->string;
+}
+
+/**
+ * Returns the identifier of the symbol.
+ *
+ * @param sym Symbol.
+ * @return Identifier.
+ */
+ULIB_PURE
+ULIB_INLINE
+ulib_uint ustrsym_id(UStrSym sym) {
+    return sym._e->id;
+}
+
+/**
+ * Returns the hash of the symbol.
+ *
+ * @param sym Symbol.
+ * @return Hash, equal to the value returned by @func{ustring_hash} for the interned string.
+ */
+ULIB_PURE
+ULIB_INLINE
+ulib_uint ustrsym_hash(UStrSym sym) {
+    return sym._e->hash;
+}
+
+/**
+ * Checks whether two symbols are equal.
+ *
+ * @param lhs First symbol.
+ * @param rhs Second symbol.
+ * @return True if the two symbols are equal, false otherwise.
+ *
+ * @note Only symbols obtained from the same pool can be compared.
+ */
+ULIB_CONST
+ULIB_INLINE
+bool ustrsym_equals(UStrSym lhs, UStrSym rhs) {
+    return lhs._e == rhs._e;
+}
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // USTRPOOL_H
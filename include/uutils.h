@@ -104,6 +104,19 @@
 #define ulib_unlikely(exp) (exp)
 #endif
 
+/**
+ * Hint the processor that the memory at `addr` is likely to be read soon.
+ *
+ * @param addr @ctype{void const *} Address to prefetch.
+ *
+ * @note Prefetching an invalid address is harmless, as it never faults.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define ulib_prefetch(addr) __builtin_prefetch((void const *)(addr))
+#else
+#define ulib_prefetch(addr) ((void)(addr))
+#endif
+
 /// No-op macro.
 #define ulib_noop ((void)0)
 
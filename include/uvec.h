@@ -14,6 +14,7 @@
 
 #include "ualloc.h"
 #include "uattrs.h"
+#include "ubit.h"
 #include "udebug.h"
 #include "unumber.h"
 #include "urand.h" // IWYU pragma: keep, needed for urand_range
@@ -21,6 +22,7 @@
 #include "uwarning.h"
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 ULIB_BEGIN_DECLS
@@ -66,6 +68,20 @@ typedef enum uvec_ret {
 
 } uvec_ret;
 
+/// File mapping modes, see @func{uvec_map_file}.
+typedef enum uvec_map_mode {
+
+    /// Maps an existing file. Changes to the vector are not written to the file.
+    UVEC_MAP_READ = 0,
+
+    /// Maps a file, creating it if it does not exist. Changes are written to the file.
+    UVEC_MAP_WRITE = 1,
+
+    /// Like @val{UVEC_MAP_WRITE}, but discards the contents of the file.
+    UVEC_MAP_CREATE = 2
+
+} uvec_map_mode;
+
 /**
  * @defgroup UVec_constants UVec constants
  * @{
@@ -99,11 +115,40 @@ typedef enum uvec_ret {
 #define UVEC_BINARY_SEARCH_THRESH (sizeof(ulib_uint) * CHAR_BIT)
 #endif
 
+/// Switch from linear merging to galloping when one sorted vector is this many times larger.
+#ifndef UVEC_GALLOP_RATIO
+#define UVEC_GALLOP_RATIO 16
+#endif
+
+/// Growth policy: capacity is rounded up to the next power of two.
+#define UVEC_GROWTH_POW2 0
+
+/// Growth policy: capacity grows by at least 50% of its current value.
+#define UVEC_GROWTH_1_5X 1
+
+/// Growth policy: capacity grows to exactly the requested size.
+#define UVEC_GROWTH_EXACT 2
+
+/**
+ * Growth policy of vector types, used by @func{uvec_reserve} and all functions that grow vectors.
+ *
+ * @note The policy is applied where vector types are implemented, so it can be selected
+ *       on a per-type basis by redefining this macro before the relevant
+ *       @func{UVEC_IMPL} or @func{UVEC_INIT} invocation.
+ * @note Capacities that are not powers of two are stored with a 16-bit mantissa (8 bits on
+ *       some platforms). They are exact below 2^16 (2^8), and otherwise exceed the requested
+ *       capacity by at most 1/2^16 (1/2^8) of its value, see @func{uvec_reserve_exact}.
+ */
+#ifndef UVEC_GROWTH_POLICY
+#define UVEC_GROWTH_POLICY UVEC_GROWTH_POW2
+#endif
+
 /// @}
 
 #define P_UVEC_EXP_COMPACT ((ulib_byte)0xFF)
 #define P_UVEC_EXP_WRAPPED ((ulib_byte)0xFE)
-#define P_UVEC_EXP_MIN_MARKER P_UVEC_EXP_WRAPPED
+#define P_UVEC_EXP_MAPPED ((ulib_byte)0xFD)
+#define P_UVEC_EXP_MIN_MARKER P_UVEC_EXP_MAPPED
 #define P_UVEC_FLAG_LARGE ((ulib_byte)0x80)
 
 #define p_uvec_size(T) (sizeof(struct ULIB_MACRO_CONCAT(p_uvec_large_, T)))
@@ -116,11 +161,15 @@ typedef enum uvec_ret {
 #define p_uvec_exp_is_small(e) (!p_uvec_exp_is_large(e))
 #define p_uvec_exp_is_compact(e) ((e) == P_UVEC_EXP_COMPACT)
 #define p_uvec_exp_is_wrapped(e) ((e) == P_UVEC_EXP_WRAPPED)
+#define p_uvec_exp_is_mapped(e) ((e) == P_UVEC_EXP_MAPPED)
 #define p_uvec_exp_is_marker(e) ((e) >= P_UVEC_EXP_MIN_MARKER)
 #define p_uvec_exp_large_exp(e) ((e) & (~P_UVEC_FLAG_LARGE))
+#define p_uvec_mant_bytes(T) (p_uvec_exp_size(T) > 2 ? 2 : p_uvec_exp_size(T) - 1)
+#define p_uvec_mant_bits(T) ((unsigned)(p_uvec_mant_bytes(T) * CHAR_BIT))
 #define p_uvec_is_large(T, v) p_uvec_exp_is_large(p_uvec_exp(T, v))
 #define p_uvec_is_small(T, v) p_uvec_exp_is_small(p_uvec_exp(T, v))
 #define p_uvec_is_compact(T, v) p_uvec_exp_is_compact(p_uvec_exp(T, v))
+#define p_uvec_is_mapped(T, v) p_uvec_exp_is_mapped(p_uvec_exp(T, v))
 
 #define p_uvec_copy_items(T, dest, src, n)                                                         \
     memcpy((void *)(dest), (void const *)(src), (n) * sizeof(T))
@@ -128,6 +177,71 @@ typedef enum uvec_ret {
     memmove((void *)(dest), (void const *)(src), (n) * sizeof(T))
 #define p_uvec_compare_items(T, dest, src, n)                                                      \
     memcmp((void const *)(dest), (void const *)(src), (n) * sizeof(T))
+#define p_uvec_items_per_line(T)                                                                   \
+    (sizeof(T) < UVEC_CACHE_LINE_SIZE ? UVEC_CACHE_LINE_SIZE / sizeof(T) : 1)
+
+/*
+ * Large vector capacities are encoded as a power of two exponent and a binary mantissa of
+ * `bits` bits, stored in the otherwise unused padding bytes: size = 2^exp * (1 + mant / 2^bits).
+ */
+ULIB_CONST
+ULIB_INLINE
+ulib_uint p_uvec_size_from_exp(ulib_byte exp, ulib_uint mant, unsigned bits) {
+    ulib_uint const size = ulib_uint_pow2(exp);
+    if (exp >= bits) return size + (mant << (exp - bits));
+    return size + (ulib_uint)(((uint64_t)mant << exp) >> bits);
+}
+
+ULIB_INLINE
+ulib_byte p_uvec_exp_from_size(ulib_uint size, unsigned bits, ulib_uint *mant) {
+    ulib_byte exp = (ulib_byte)ulib_uint_log2(size);
+    ulib_uint const rem = size - ulib_uint_pow2(exp);
+    ulib_uint m;
+
+    if (exp >= bits) {
+        unsigned const shift = exp - bits;
+        m = (rem >> shift) + ((rem & (ulib_uint_pow2((ulib_byte)shift) - 1)) != 0);
+    } else {
+        m = rem << (bits - exp);
+    }
+
+    if (m >> bits) {
+        ++exp;
+        m = 0;
+    }
+
+    *mant = m;
+    return exp;
+}
+
+/*
+ * Header of files mapped via uvec_map_file, which precedes the elements of the vector.
+ * Only the first three fields are meaningful on disk. The others are process-local scratch data:
+ * they are rewritten every time the file is mapped, and cleared when it is unmapped.
+ */
+typedef struct p_uvec_map_header {
+    uint64_t magic;
+    uint64_t item_size;
+    uint64_t count;
+    uint64_t size;
+    int64_t fd;
+    uint64_t mode;
+    uint64_t reserved[2];
+} p_uvec_map_header;
+
+#define p_uvec_map_header(data) ((p_uvec_map_header *)(void *)(data) - 1)
+
+ULIB_API
+void *p_uvec_map_open(char const *path, size_t item_size, uvec_map_mode mode, ulib_uint *count);
+
+ULIB_API
+void *p_uvec_map_reserve(void *data, size_t item_size, ulib_uint size);
+
+ULIB_API
+uvec_ret p_uvec_map_sync(void *data, ulib_uint count);
+
+ULIB_API
+uvec_ret p_uvec_map_close(void *data, ulib_uint count);
 
 /*
  * Defines a new vector struct.
@@ -175,6 +289,7 @@ typedef enum uvec_ret {
 #define P_UVEC_DECL(T, ATTRS)                                                                      \
     /** @cond */                                                                                   \
     ATTRS uvec_ret uvec_reserve_##T(UVec(T) *vec, ulib_uint size);                                 \
+    ATTRS uvec_ret uvec_reserve_exact_##T(UVec(T) *vec, ulib_uint size);                           \
     ATTRS uvec_ret uvec_set_range_##T(UVec(T) *vec, T const *array, ulib_uint start, ulib_uint n); \
     ATTRS uvec_ret uvec_copy_##T(UVec(T) const *src, UVec(T) *dest);                               \
     ATTRS void uvec_copy_to_array_##T(UVec(T) const *vec, T array[]);                              \
@@ -187,6 +302,11 @@ typedef enum uvec_ret {
     ATTRS void uvec_unordered_remove_range_##T(UVec(T) *vec, ulib_uint start, ulib_uint n);        \
     ATTRS void uvec_reverse_##T(UVec(T) *vec);                                                     \
     ATTRS void uvec_shuffle_##T(UVec(T) *vec);                                                     \
+    ATTRS ulib_uint uvec_remove_if_##T(UVec(T) *vec, bool (*pred)(void *ctx, T item), void *ctx);  \
+    ATTRS ulib_uint uvec_retain_if_##T(UVec(T) *vec, bool (*pred)(void *ctx, T item), void *ctx);  \
+    ATTRS uvec_ret uvec_map_file_##T(UVec(T) *vec, char const *path, uvec_map_mode mode);          \
+    ATTRS uvec_ret uvec_sync_##T(UVec(T) *vec);                                                    \
+    ATTRS uvec_ret uvec_unmap_##T(UVec(T) *vec);                                                   \
     /** @endcond */
 
 /*
@@ -226,10 +346,31 @@ typedef enum uvec_ret {
         return (T *)vec->_s;                                                                       \
     }                                                                                              \
                                                                                                    \
+    ATTRS ULIB_PURE ULIB_INLINE ulib_uint p_uvec_mant_##T(UVec(T) const *vec) {                    \
+        ulib_uint mant = 0;                                                                        \
+        for (unsigned i = 0; i < p_uvec_mant_bytes(T); ++i) {                                      \
+            mant |= (ulib_uint)vec->_l._exp[i] << (i * CHAR_BIT);                                  \
+        }                                                                                          \
+        return mant;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ULIB_INLINE void p_uvec_mant_set_##T(UVec(T) *vec, ulib_uint mant) {                     \
+        for (unsigned i = 0; i < p_uvec_mant_bytes(T); ++i) {                                      \
+            vec->_l._exp[i] = (ulib_byte)(mant >> (i * CHAR_BIT));                                 \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
     ATTRS ULIB_PURE ULIB_INLINE ulib_uint uvec_size_##T(UVec(T) const *vec) {                      \
         ulib_byte exp = p_uvec_exp(T, vec);                                                        \
         if (p_uvec_exp_is_small(exp)) return p_uvec_small_size(T);                                 \
-        if (!p_uvec_exp_is_marker(exp)) return ulib_uint_pow2(p_uvec_exp_large_exp(exp));          \
+        if (!p_uvec_exp_is_marker(exp)) {                                                          \
+            ulib_byte const large_exp = p_uvec_exp_large_exp(exp);                                 \
+            ulib_uint const mant = p_uvec_mant_##T(vec);                                           \
+            /* Power of two capacities, e.g. from the default growth policy, are a shift. */       \
+            if (!mant) return ulib_uint_pow2(large_exp);                                           \
+            return p_uvec_size_from_exp(large_exp, mant, p_uvec_mant_bits(T));                     \
+        }                                                                                          \
+        if (p_uvec_exp_is_mapped(exp)) return (ulib_uint)p_uvec_map_header(vec->_l._data)->size;   \
         return p_uvec_exp_is_compact(exp) ? vec->_l._count : ULIB_UINT_MAX;                        \
     }                                                                                              \
                                                                                                    \
@@ -256,11 +397,16 @@ typedef enum uvec_ret {
     }                                                                                              \
                                                                                                    \
     ATTRS ULIB_INLINE void uvec_deinit_##T(UVec(T) *vec) {                                         \
-        if (p_uvec_is_small(T, vec)) {                                                             \
+        ulib_byte const exp = p_uvec_exp(T, vec);                                                  \
+        if (p_uvec_exp_is_small(exp)) {                                                            \
             p_uvec_exp_set(T, vec, 0);                                                             \
             return;                                                                                \
         }                                                                                          \
-        ulib_free((void *)vec->_l._data);                                                          \
+        if (p_uvec_exp_is_mapped(exp)) {                                                           \
+            p_uvec_map_close((void *)vec->_l._data, vec->_l._count);                               \
+        } else {                                                                                   \
+            ulib_free((void *)vec->_l._data);                                                      \
+        }                                                                                          \
         struct p_uvec_large_##T zero = ulib_struct_init;                                           \
         vec->_l = zero;                                                                            \
     }                                                                                              \
@@ -352,11 +498,27 @@ typedef enum uvec_ret {
     ATTRS ULIB_PURE ulib_uint uvec_index_of_min_##T(UVec(T) const *vec);                           \
     ATTRS ULIB_PURE ulib_uint uvec_index_of_max_##T(UVec(T) const *vec);                           \
     ATTRS void uvec_sort_range_##T(UVec(T) *vec, ulib_uint start, ulib_uint len);                  \
+    ATTRS void uvec_nth_element_##T(UVec(T) *vec, ulib_uint n);                                    \
+    ATTRS void uvec_partial_sort_##T(UVec(T) *vec, ulib_uint k);                                   \
+    ATTRS uvec_ret uvec_top_k_##T(UVec(T) const *vec, ulib_uint k, UVec(T) *dest);                 \
     ATTRS ULIB_PURE ulib_uint uvec_sorted_insertion_index_##T(UVec(T) const *vec, T item);         \
     ATTRS ULIB_PURE ulib_uint uvec_sorted_index_of_##T(UVec(T) const *vec, T item);                \
+    ATTRS ULIB_PURE ulib_uint uvec_sorted_index_of_branchless_##T(UVec(T) const *vec, T item);     \
+    ATTRS uvec_ret uvec_eytzinger_##T(UVec(T) *vec);                                               \
+    ATTRS ULIB_PURE ulib_uint uvec_eytzinger_index_of_##T(UVec(T) const *vec, T item);             \
+    ATTRS void uvec_sorted_index_of_many_##T(UVec(T) const *vec, UVec(T) const *items,             \
+                                             ulib_uint *indexes);                                  \
+    ATTRS uvec_ret uvec_sorted_intersect_##T(UVec(T) const *a, UVec(T) const *b, UVec(T) *dest);   \
+    ATTRS uvec_ret uvec_sorted_union_##T(UVec(T) const *a, UVec(T) const *b, UVec(T) *dest);       \
+    ATTRS uvec_ret uvec_sorted_diff_##T(UVec(T) const *a, UVec(T) const *b, UVec(T) *dest);        \
     ATTRS uvec_ret uvec_sorted_insert_##T(UVec(T) *vec, T item, ulib_uint *idx);                   \
     ATTRS uvec_ret uvec_sorted_unique_insert_##T(UVec(T) *vec, T item, ulib_uint *idx);            \
+    ATTRS uvec_ret uvec_sorted_insert_all_##T(UVec(T) *vec, T const *array, ulib_uint n);          \
+    ATTRS uvec_ret uvec_sorted_unique_insert_all_##T(UVec(T) *vec, T const *array, ulib_uint n);   \
+    ATTRS uvec_ret uvec_sorted_merge_##T(UVec(T) *dest, UVec(T) const *src);                       \
+    ATTRS uvec_ret uvec_sorted_unique_merge_##T(UVec(T) *dest, UVec(T) const *src);                \
     ATTRS bool uvec_sorted_remove_##T(UVec(T) *vec, T item);                                       \
+    ATTRS ulib_uint uvec_sorted_dedup_##T(UVec(T) *vec);                                           \
     /** @endcond */
 
 /*
@@ -412,12 +574,20 @@ typedef enum uvec_ret {
 #define P_UVEC_IMPL(T, ATTRS)                                                                      \
     /* NOLINTBEGIN(clang-analyzer-unix.Malloc) */                                                  \
                                                                                                    \
-    ATTRS uvec_ret uvec_reserve_##T(UVec(T) *vec, ulib_uint size) {                                \
-        if (size <= uvec_size(T, vec)) return UVEC_OK;                                             \
-                                                                                                   \
+    ULIB_INLINE uvec_ret p_uvec_reserve_##T(UVec(T) *vec, ulib_uint size, bool pow2) {             \
         ulib_byte const exp = p_uvec_exp(T, vec);                                                  \
-        ulib_byte const new_exp = (ulib_byte)ulib_uint_ceil_log2(size);                            \
-        size = ulib_uint_pow2(new_exp);                                                            \
+                                                                                                   \
+        if (p_uvec_exp_is_mapped(exp)) {                                                           \
+            void *mdata = p_uvec_map_reserve((void *)vec->_l._data, sizeof(T), size);              \
+            if (!mdata) return UVEC_ERR;                                                           \
+            vec->_l._data = (T *)mdata;                                                            \
+            return UVEC_OK;                                                                        \
+        }                                                                                          \
+                                                                                                   \
+        ulib_uint mant = 0;                                                                        \
+        ulib_byte const new_exp = pow2 ? (ulib_byte)ulib_uint_ceil_log2(size)                      \
+                                       : p_uvec_exp_from_size(size, p_uvec_mant_bits(T), &mant);   \
+        size = p_uvec_size_from_exp(new_exp, mant, p_uvec_mant_bits(T));                           \
         T *data;                                                                                   \
                                                                                                    \
         if (p_uvec_exp_is_large(exp)) {                                                            \
@@ -432,11 +602,28 @@ typedef enum uvec_ret {
         }                                                                                          \
                                                                                                    \
         p_uvec_exp_set(T, vec, new_exp | P_UVEC_FLAG_LARGE);                                       \
+        p_uvec_mant_set_##T(vec, mant);                                                            \
         vec->_l._data = data;                                                                      \
                                                                                                    \
         return UVEC_OK;                                                                            \
     }                                                                                              \
                                                                                                    \
+    ATTRS uvec_ret uvec_reserve_##T(UVec(T) *vec, ulib_uint size) {                                \
+        ulib_uint const cur = uvec_size(T, vec);                                                   \
+        if (size <= cur) return UVEC_OK;                                                           \
+                                                                                                   \
+        if (UVEC_GROWTH_POLICY == UVEC_GROWTH_1_5X && cur <= ULIB_UINT_MAX / 3 * 2) {              \
+            size = ulib_max(size, cur + (cur >> 1U));                                              \
+        }                                                                                          \
+                                                                                                   \
+        return p_uvec_reserve_##T(vec, size, UVEC_GROWTH_POLICY == UVEC_GROWTH_POW2);              \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_reserve_exact_##T(UVec(T) *vec, ulib_uint size) {                          \
+        if (size <= uvec_size(T, vec)) return UVEC_OK;                                             \
+        return p_uvec_reserve_##T(vec, size, false);                                               \
+    }                                                                                              \
+                                                                                                   \
     ATTRS uvec_ret uvec_set_range_##T(UVec(T) *vec, T const *array, ulib_uint start,               \
                                       ulib_uint n) {                                               \
         if (!n) return UVEC_OK;                                                                    \
@@ -472,7 +659,7 @@ typedef enum uvec_ret {
                                                                                                    \
     ATTRS uvec_ret uvec_shrink_##T(UVec(T) *vec) {                                                 \
         ulib_byte exp = p_uvec_exp(T, vec);                                                        \
-        if (p_uvec_exp_is_wrapped(exp)) return UVEC_OK;                                            \
+        if (p_uvec_exp_is_wrapped(exp) || p_uvec_exp_is_mapped(exp)) return UVEC_OK;               \
                                                                                                    \
         ulib_uint count = uvec_count(T, vec);                                                      \
                                                                                                    \
@@ -572,6 +759,59 @@ typedef enum uvec_ret {
             ulib_uint swap_idx = (ulib_uint)urand_range(0, count);                                 \
             ulib_swap(T, data[i], data[swap_idx]);                                                 \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_map_file_##T(UVec(T) *vec, char const *path, uvec_map_mode mode) {         \
+        ulib_uint count;                                                                           \
+        void *data = p_uvec_map_open(path, sizeof(T), mode, &count);                               \
+        if (!data) return UVEC_ERR;                                                                \
+        *vec = uvec(T);                                                                            \
+        p_uvec_exp_set(T, vec, P_UVEC_EXP_MAPPED);                                                 \
+        vec->_l._data = (T *)data;                                                                 \
+        vec->_l._count = count;                                                                    \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sync_##T(UVec(T) *vec) {                                                   \
+        if (!p_uvec_is_mapped(T, vec)) return UVEC_OK;                                             \
+        return p_uvec_map_sync((void *)vec->_l._data, vec->_l._count);                             \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_unmap_##T(UVec(T) *vec) {                                                  \
+        if (!p_uvec_is_mapped(T, vec)) return UVEC_OK;                                             \
+        uvec_ret const ret = p_uvec_map_close((void *)vec->_l._data, vec->_l._count);              \
+        *vec = uvec(T);                                                                            \
+        return ret;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE ulib_uint p_uvec_compact_##T(UVec(T) *vec, bool (*pred)(void *, T), void *ctx,     \
+                                             bool retain) {                                        \
+        T *const data = uvec_data(T, vec);                                                         \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        ulib_uint r = 0;                                                                           \
+                                                                                                   \
+        /* Retained prefix: no element needs to be moved. */                                       \
+        while (r < count && pred(ctx, data[r]) == retain) ++r;                                     \
+        if (r == count) return 0;                                                                  \
+                                                                                                   \
+        /* Branchless compaction: always write, only advance the write cursor on a match. */       \
+        ulib_uint w = r;                                                                           \
+        for (++r; r < count; ++r) {                                                                \
+            T const item = data[r];                                                                \
+            data[w] = item;                                                                        \
+            w += (ulib_uint)(pred(ctx, item) == retain);                                           \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_set_count_##T(vec, w);                                                              \
+        return count - w;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint uvec_remove_if_##T(UVec(T) *vec, bool (*pred)(void *ctx, T item), void *ctx) { \
+        return p_uvec_compact_##T(vec, pred, ctx, false);                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint uvec_retain_if_##T(UVec(T) *vec, bool (*pred)(void *ctx, T item), void *ctx) { \
+        return p_uvec_compact_##T(vec, pred, ctx, true);                                           \
     }                                                                                              \
     /* NOLINTEND(clang-analyzer-unix.Malloc) */
 
@@ -792,6 +1032,114 @@ typedef enum uvec_ret {
         p_uvec_isort_##T(array, len);                                                              \
     }                                                                                              \
                                                                                                    \
+    ULIB_INLINE void p_uvec_heapsort_sift_##T(T *a, ulib_uint len, ulib_uint i) {                  \
+        T const item = a[i];                                                                       \
+                                                                                                   \
+        for (ulib_uint child; (child = 2 * i + 1) < len; i = child) {                              \
+            if (child + 1 < len && compare_func(a[child], a[child + 1])) ++child;                  \
+            if (!compare_func(item, a[child])) break;                                              \
+            a[i] = a[child];                                                                       \
+        }                                                                                          \
+                                                                                                   \
+        a[i] = item;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_heapsort_##T(T *a, ulib_uint len) {                                    \
+        for (ulib_uint i = len / 2; i-- > 0;) p_uvec_heapsort_sift_##T(a, len, i);                 \
+        for (ulib_uint i = len; i-- > 1;) {                                                        \
+            ulib_swap(T, a[0], a[i]);                                                              \
+            p_uvec_heapsort_sift_##T(a, i, 0);                                                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_select_##T(T *a, ulib_uint len, ulib_uint nth) {                       \
+        ulib_uint lo = 0, hi = len;                                                                \
+        unsigned depth = 2 * ulib_uint_log2(len + 1);                                              \
+                                                                                                   \
+        while (hi > lo + UVEC_SORT_INSERTION_THRESH) {                                             \
+            T *const b = a + lo;                                                                   \
+            ulib_uint const n = hi - lo;                                                           \
+                                                                                                   \
+            if (!depth--) {                                                                        \
+                /* Too many unbalanced partitions: heapsort bounds the worst case. */              \
+                p_uvec_heapsort_##T(b, n);                                                         \
+                return;                                                                            \
+            }                                                                                      \
+                                                                                                   \
+            T const pivot = p_uvec_qsort_pivot_##T(b, n);                                          \
+            ulib_uint i = (ulib_uint)-1, j = n;                                                    \
+                                                                                                   \
+            while (true) {                                                                         \
+                while (compare_func(b[++i], pivot)) {}                                             \
+                while (compare_func(pivot, b[--j])) {}                                             \
+                if (i >= j) break;                                                                 \
+                ulib_swap(T, b[i], b[j]);                                                          \
+            }                                                                                      \
+                                                                                                   \
+            if (nth < lo + i) {                                                                    \
+                hi = lo + i;                                                                       \
+            } else {                                                                               \
+                lo += i;                                                                           \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_isort_##T(a + lo, hi - lo);                                                         \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void uvec_nth_element_##T(UVec(T) *vec, ulib_uint n) {                                   \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        if (n < count) p_uvec_select_##T(uvec_data(T, vec), count, n);                             \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void uvec_partial_sort_##T(UVec(T) *vec, ulib_uint k) {                                  \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        if (!k) return;                                                                            \
+                                                                                                   \
+        if (k < count) {                                                                           \
+            p_uvec_select_##T(uvec_data(T, vec), count, k - 1);                                    \
+            uvec_sort_range(T, vec, 0, k - 1);                                                     \
+        } else {                                                                                   \
+            uvec_sort_range(T, vec, 0, count);                                                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_top_k_##T(UVec(T) const *vec, ulib_uint k, UVec(T) *dest) {                \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        uvec_clear(T, dest);                                                                       \
+                                                                                                   \
+        if (k > count) k = count;                                                                  \
+        if (!k) return UVEC_OK;                                                                    \
+                                                                                                   \
+        ulib_uint const size = k < count / 2 ? k * 2 : count;                                      \
+        if (uvec_reserve(T, dest, size)) return UVEC_ERR;                                          \
+                                                                                                   \
+        T const *const src = uvec_data(T, vec);                                                    \
+        T *const buf = uvec_data(T, dest);                                                         \
+        T min = src[0];                                                                            \
+        ulib_uint n = 0;                                                                           \
+        bool full = false;                                                                         \
+                                                                                                   \
+        for (ulib_uint i = 0; i < count; ++i) {                                                    \
+            if (full && !compare_func(min, src[i])) continue;                                      \
+            buf[n++] = src[i];                                                                     \
+                                                                                                   \
+            if (n == size && i + 1 < count) {                                                      \
+                p_uvec_select_##T(buf, n, n - k);                                                  \
+                p_uvec_move_items(T, buf, buf + n - k, k);                                         \
+                min = buf[0];                                                                      \
+                full = true;                                                                       \
+                n = k;                                                                             \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_select_##T(buf, n, n - k);                                                          \
+        p_uvec_move_items(T, buf, buf + n - k, k);                                                 \
+        p_uvec_set_count_##T(dest, k);                                                             \
+        uvec_sort(T, dest);                                                                        \
+        uvec_reverse(T, dest);                                                                     \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
     ATTRS ulib_uint uvec_sorted_insertion_index_##T(UVec(T) const *vec, T item) {                  \
         ulib_uint len = uvec_count(T, vec);                                                        \
         T const *const data = uvec_data(T, vec);                                                   \
@@ -815,6 +1163,232 @@ typedef enum uvec_ret {
         return data && i < count && equal_func(data[i], item) ? i : count;                         \
     }                                                                                              \
                                                                                                    \
+    ATTRS ulib_uint uvec_sorted_index_of_branchless_##T(UVec(T) const *vec, T item) {              \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        if (!count) return count;                                                                  \
+                                                                                                   \
+        T const *const data = uvec_data(T, vec);                                                   \
+        T const *cur = data;                                                                       \
+                                                                                                   \
+        for (ulib_uint len = count; len > 1;) {                                                    \
+            ulib_uint const half = len >> 1;                                                       \
+            ulib_prefetch(cur + (len >> 2));                                                       \
+            ulib_prefetch(cur + half + (len >> 2));                                                \
+            cur += (ulib_uint)compare_func(cur[half], item) * half;                                \
+            len -= half;                                                                           \
+        }                                                                                          \
+                                                                                                   \
+        ulib_uint const i = (ulib_uint)(cur - data) + (ulib_uint)compare_func(*cur, item);         \
+        return i < count && equal_func(data[i], item) ? i : count;                                 \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_eytzinger_##T(UVec(T) *vec) {                                              \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        if (count < 2) return UVEC_OK;                                                             \
+                                                                                                   \
+        T *const data = uvec_data(T, vec);                                                         \
+        T *sorted = (T *)ulib_alloc_array(sorted, count);                                          \
+        if (!sorted) return UVEC_ERR;                                                              \
+        p_uvec_copy_items(T, sorted, data, count);                                                 \
+                                                                                                   \
+        /* In-order traversal of the implicit tree, using one-based node indexes. */               \
+        ulib_uint k = 1;                                                                           \
+        while (k <= (count >> 1)) k <<= 1;                                                         \
+                                                                                                   \
+        for (ulib_uint i = 0; i < count; ++i) {                                                    \
+            data[k - 1] = sorted[i];                                                               \
+            if (k <= ((count - 1) >> 1)) {                                                         \
+                for (k = (k << 1) | 1; k <= (count >> 1); k <<= 1) {}                              \
+            } else {                                                                               \
+                while (k & 1) k >>= 1;                                                             \
+                k >>= 1;                                                                           \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        ulib_free(sorted);                                                                         \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint uvec_eytzinger_index_of_##T(UVec(T) const *vec, T item) {                      \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        T const *const data = uvec_data(T, vec);                                                   \
+        uint64_t k = 1;                                                                            \
+                                                                                                   \
+        while (k <= count) {                                                                       \
+            ulib_prefetch(data + p_uvec_items_per_line(T) * k - 1);                                \
+            k = (k << 1) + (uint64_t)compare_func(data[k - 1], item);                              \
+        }                                                                                          \
+                                                                                                   \
+        /* Backtrack to the last node where the search went left. */                               \
+        k >>= ubit_first_set(64, ~k) + 1;                                                          \
+        return k && equal_func(data[k - 1], item) ? (ulib_uint)(k - 1) : count;                    \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE ulib_uint p_uvec_gallop_##T(T const *a, ulib_uint start, ulib_uint len, T item) {  \
+        ulib_uint lo = start, hi = start, step = 1;                                                \
+                                                                                                   \
+        while (hi < len && compare_func(a[hi], item)) {                                            \
+            lo = hi + 1;                                                                           \
+            hi = step < len - hi ? hi + step : len;                                                \
+            step <<= 1;                                                                            \
+        }                                                                                          \
+                                                                                                   \
+        while (lo < hi) {                                                                          \
+            ulib_uint const mid = lo + ((hi - lo) >> 1);                                           \
+            if (compare_func(a[mid], item)) {                                                      \
+                lo = mid + 1;                                                                      \
+            } else {                                                                               \
+                hi = mid;                                                                          \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        return lo;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void uvec_sorted_index_of_many_##T(UVec(T) const *vec, UVec(T) const *items,             \
+                                             ulib_uint *indexes) {                                 \
+        ulib_uint const count = uvec_count(T, vec), n = uvec_count(T, items);                      \
+        T const *const data = uvec_data(T, vec);                                                   \
+        T const *const it = uvec_data(T, items);                                                   \
+                                                                                                   \
+        for (ulib_uint i = 0, j = 0; i < n; ++i) {                                                 \
+            j = p_uvec_gallop_##T(data, j, count, it[i]);                                          \
+            indexes[i] = j < count && equal_func(data[j], it[i]) ? j : count;                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_intersect_##T(UVec(T) const *a, UVec(T) const *b, UVec(T) *dest) {  \
+        if (uvec_count(T, a) > uvec_count(T, b)) ulib_swap(UVec(T) const *, a, b);                 \
+        ulib_uint const na = uvec_count(T, a), nb = uvec_count(T, b);                              \
+        uvec_clear(T, dest);                                                                       \
+                                                                                                   \
+        if (!na) return UVEC_OK;                                                                   \
+        if (uvec_reserve(T, dest, na)) return UVEC_ERR;                                            \
+                                                                                                   \
+        T const *const da = uvec_data(T, a);                                                       \
+        T const *const db = uvec_data(T, b);                                                       \
+        T *const out = uvec_data(T, dest);                                                         \
+        ulib_uint i = 0, j = 0, n = 0;                                                             \
+                                                                                                   \
+        if (nb / na >= UVEC_GALLOP_RATIO) {                                                        \
+            for (; i < na && j < nb; ++i) {                                                        \
+                j = p_uvec_gallop_##T(db, j, nb, da[i]);                                           \
+                if (j < nb && !compare_func(da[i], db[j])) {                                       \
+                    out[n++] = da[i];                                                              \
+                    ++j;                                                                           \
+                }                                                                                  \
+            }                                                                                      \
+        } else {                                                                                   \
+            while (i < na && j < nb) {                                                             \
+                T const x = da[i], y = db[j];                                                      \
+                bool const lt = compare_func(x, y), gt = compare_func(y, x);                       \
+                /* Unconditional store: n never exceeds i, so out[n] is in bounds. */              \
+                out[n] = x;                                                                        \
+                n += !(lt || gt);                                                                  \
+                i += !gt;                                                                          \
+                j += !lt;                                                                          \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_set_count_##T(dest, n);                                                             \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_union_##T(UVec(T) const *a, UVec(T) const *b, UVec(T) *dest) {      \
+        ulib_uint const na = uvec_count(T, a), nb = uvec_count(T, b);                              \
+        uvec_clear(T, dest);                                                                       \
+        if (na > ULIB_UINT_MAX - nb || uvec_reserve(T, dest, na + nb)) return UVEC_ERR;            \
+                                                                                                   \
+        T const *da = uvec_data(T, a);                                                             \
+        T const *db = uvec_data(T, b);                                                             \
+        T *const out = uvec_data(T, dest);                                                         \
+        ulib_uint i = 0, j = 0, n = 0;                                                             \
+                                                                                                   \
+        if (na && nb && ulib_max(na, nb) / ulib_min(na, nb) >= UVEC_GALLOP_RATIO) {                \
+            ulib_uint const ns = ulib_min(na, nb), nl = ulib_max(na, nb);                          \
+            T const *const ds = na < nb ? da : db;                                                 \
+            T const *const dl = na < nb ? db : da;                                                 \
+                                                                                                   \
+            for (; i < ns; ++i) {                                                                  \
+                ulib_uint const k = p_uvec_gallop_##T(dl, j, nl, ds[i]);                           \
+                p_uvec_copy_items(T, out + n, dl + j, k - j);                                      \
+                n += k - j;                                                                        \
+                out[n++] = ds[i];                                                                  \
+                j = k + (k < nl && !compare_func(ds[i], dl[k]));                                   \
+            }                                                                                      \
+                                                                                                   \
+            p_uvec_copy_items(T, out + n, dl + j, nl - j);                                         \
+            n += nl - j;                                                                           \
+        } else {                                                                                   \
+            while (i < na && j < nb) {                                                             \
+                T const x = da[i], y = db[j];                                                      \
+                if (compare_func(y, x)) {                                                          \
+                    out[n++] = y;                                                                  \
+                    ++j;                                                                           \
+                } else {                                                                           \
+                    out[n++] = x;                                                                  \
+                    ++i;                                                                           \
+                    j += !compare_func(x, y);                                                      \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            if (i < na) p_uvec_copy_items(T, out + n, da + i, na - i);                             \
+            if (j < nb) p_uvec_copy_items(T, out + n, db + j, nb - j);                             \
+            n += (na - i) + (nb - j);                                                              \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_set_count_##T(dest, n);                                                             \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_diff_##T(UVec(T) const *a, UVec(T) const *b, UVec(T) *dest) {       \
+        ulib_uint const na = uvec_count(T, a), nb = uvec_count(T, b);                              \
+        uvec_clear(T, dest);                                                                       \
+                                                                                                   \
+        if (!na) return UVEC_OK;                                                                   \
+        if (uvec_reserve(T, dest, na)) return UVEC_ERR;                                            \
+                                                                                                   \
+        T const *const da = uvec_data(T, a);                                                       \
+        T const *const db = uvec_data(T, b);                                                       \
+        T *const out = uvec_data(T, dest);                                                         \
+        ulib_uint i = 0, j = 0, n = 0;                                                             \
+                                                                                                   \
+        if (nb && nb / na >= UVEC_GALLOP_RATIO) {                                                  \
+            for (; i < na; ++i) {                                                                  \
+                j = p_uvec_gallop_##T(db, j, nb, da[i]);                                           \
+                if (j < nb && !compare_func(da[i], db[j])) {                                       \
+                    ++j;                                                                           \
+                } else {                                                                           \
+                    out[n++] = da[i];                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        } else if (nb && na / nb >= UVEC_GALLOP_RATIO) {                                           \
+            for (; j < nb && i < na; ++j) {                                                        \
+                ulib_uint const k = p_uvec_gallop_##T(da, i, na, db[j]);                           \
+                p_uvec_copy_items(T, out + n, da + i, k - i);                                      \
+                n += k - i;                                                                        \
+                i = k + (k < na && !compare_func(db[j], da[k]));                                   \
+            }                                                                                      \
+        } else {                                                                                   \
+            while (i < na && j < nb) {                                                             \
+                T const x = da[i], y = db[j];                                                      \
+                if (compare_func(x, y)) {                                                          \
+                    out[n++] = x;                                                                  \
+                    ++i;                                                                           \
+                } else {                                                                           \
+                    i += !compare_func(y, x);                                                      \
+                    ++j;                                                                           \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        if (i < na) p_uvec_copy_items(T, out + n, da + i, na - i);                                 \
+        n += na - i;                                                                               \
+                                                                                                   \
+        p_uvec_set_count_##T(dest, n);                                                             \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
     ATTRS uvec_ret uvec_sorted_insert_##T(UVec(T) *vec, T item, ulib_uint *idx) {                  \
         ulib_uint i = uvec_sorted_insertion_index(T, vec, item);                                   \
         if (idx) *idx = i;                                                                         \
@@ -829,11 +1403,108 @@ typedef enum uvec_ret {
         return uvec_insert_at(T, vec, i, item);                                                    \
     }                                                                                              \
                                                                                                    \
+    ULIB_INLINE uvec_ret p_uvec_sorted_merge_##T(UVec(T) *vec, T const *src, ulib_uint n,          \
+                                                 bool unique) {                                    \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        ulib_uint total = n;                                                                       \
+                                                                                                   \
+        if (unique) {                                                                              \
+            T const *const data = uvec_data(T, vec);                                               \
+            total = 0;                                                                             \
+                                                                                                   \
+            for (ulib_uint i = 0, j = 0; i < n; ++i) {                                             \
+                if (i && !compare_func(src[i - 1], src[i])) continue;                              \
+                j = p_uvec_gallop_##T(data, j, count, src[i]);                                     \
+                total += !(j < count && !compare_func(src[i], data[j]));                           \
+            }                                                                                      \
+                                                                                                   \
+            if (!total) return UVEC_NO;                                                            \
+        }                                                                                          \
+                                                                                                   \
+        if (!total) return UVEC_OK;                                                                \
+        if (total > ULIB_UINT_MAX - count || uvec_reserve(T, vec, count + total)) {                \
+            return UVEC_ERR;                                                                       \
+        }                                                                                          \
+                                                                                                   \
+        T *const data = uvec_data(T, vec);                                                         \
+        ulib_uint i = count, j = n, w = count + total;                                             \
+                                                                                                   \
+        while (j) {                                                                                \
+            T const item = src[j - 1];                                                             \
+            if (unique && j > 1 && !compare_func(src[j - 2], item)) {                              \
+                --j;                                                                               \
+            } else if (i && compare_func(item, data[i - 1])) {                                     \
+                data[--w] = data[--i];                                                             \
+            } else if (unique && i && !compare_func(data[i - 1], item)) {                          \
+                --j;                                                                               \
+            } else {                                                                               \
+                data[--w] = item;                                                                  \
+                --j;                                                                               \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_set_count_##T(vec, count + total);                                                  \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE uvec_ret p_uvec_sorted_insert_all_##T(UVec(T) *vec, T const *array, ulib_uint n,   \
+                                                      bool unique) {                               \
+        if (!n) return unique ? UVEC_NO : UVEC_OK;                                                 \
+                                                                                                   \
+        T *const batch = (T *)ulib_alloc_array(batch, n);                                          \
+        if (!batch) return UVEC_ERR;                                                               \
+        p_uvec_copy_items(T, batch, array, n);                                                     \
+                                                                                                   \
+        UVec(T) tmp = uvec_wrap(T, batch, n);                                                      \
+        uvec_sort(T, &tmp);                                                                        \
+        uvec_ret const ret = p_uvec_sorted_merge_##T(vec, batch, n, unique);                       \
+                                                                                                   \
+        ulib_free(batch);                                                                          \
+        return ret;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_insert_all_##T(UVec(T) *vec, T const *array, ulib_uint n) {         \
+        return p_uvec_sorted_insert_all_##T(vec, array, n, false);                                 \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_unique_insert_all_##T(UVec(T) *vec, T const *array, ulib_uint n) {  \
+        return p_uvec_sorted_insert_all_##T(vec, array, n, true);                                  \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_merge_##T(UVec(T) *dest, UVec(T) const *src) {                      \
+        return p_uvec_sorted_merge_##T(dest, uvec_data(T, src), uvec_count(T, src), false);        \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_sorted_unique_merge_##T(UVec(T) *dest, UVec(T) const *src) {               \
+        ulib_uint const n = uvec_count(T, src);                                                    \
+        if (!n) return UVEC_NO;                                                                    \
+        return p_uvec_sorted_merge_##T(dest, uvec_data(T, src), n, true);                          \
+    }                                                                                              \
+                                                                                                   \
     ATTRS bool uvec_sorted_remove_##T(UVec(T) *vec, T item) {                                      \
         ulib_uint i = uvec_sorted_index_of(T, vec, item);                                          \
         if (!uvec_index_is_valid(T, vec, i)) return false;                                         \
         uvec_remove_at(T, vec, i);                                                                 \
         return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS ulib_uint uvec_sorted_dedup_##T(UVec(T) *vec) {                                          \
+        T *const data = uvec_data(T, vec);                                                         \
+        ulib_uint const count = uvec_count(T, vec);                                                \
+        ulib_uint r = 1;                                                                           \
+                                                                                                   \
+        while (r < count && !equal_func(data[r - 1], data[r])) ++r;                                \
+        if (r >= count) return 0;                                                                  \
+                                                                                                   \
+        ulib_uint w = r;                                                                           \
+        for (++r; r < count; ++r) {                                                                \
+            T const item = data[r];                                                                \
+            data[w] = item;                                                                        \
+            w += (ulib_uint)!equal_func(data[w - 1], item);                                        \
+        }                                                                                          \
+                                                                                                   \
+        p_uvec_set_count_##T(vec, w);                                                              \
+        return count - w;                                                                          \
     }
 
 /*
@@ -1189,6 +1860,61 @@ typedef enum uvec_ret {
  */
 #define uvec_wrap(T, array, count) ULIB_MACRO_CONCAT(uvec_wrap_, T)(array, count)
 
+/**
+ * Initializes a new vector whose elements are stored in a memory-mapped file.
+ *
+ * The file starts with a small header, followed by the elements of the vector.
+ * If the file exists, the vector contains the elements stored in it, otherwise it is empty.
+ * The vector can be used via the vector API as usual: it grows by extending the file
+ * and remapping it, and the operating system pages its elements in and out of memory
+ * as needed. Calling @func{uvec_unmap} or @func{uvec_deinit} writes the number of elements
+ * to the file, trims any excess capacity, and unmaps it.
+ *
+ * @param T Vector type.
+ * @param vec Vector to initialize.
+ * @param path File path.
+ * @param mode Mapping mode.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}, e.g. if the file cannot be
+ *         mapped or does not contain elements of the same size as `T`.
+ *
+ * @destructor{uvec_deinit}
+ * @note Elements are stored as they are laid out in memory, so this is only suitable for
+ *       plain data types that do not contain pointers.
+ * @note Vectors mapped in @val{UVEC_MAP_READ} mode cannot grow beyond the size of the file.
+ * @note Only available on POSIX systems.
+ * @alias uvec_ret uvec_map_file(symbol T, UVec(T) *vec, char const *path, uvec_map_mode mode);
+ */
+#define uvec_map_file(T, vec, path, mode) ULIB_MACRO_CONCAT(uvec_map_file_, T)(vec, path, mode)
+
+/**
+ * Writes the elements of a vector initialized via @func{uvec_map_file} to its file,
+ * waiting for the operation to complete.
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note This function does nothing if the vector is not backed by a file.
+ * @alias uvec_ret uvec_sync(symbol T, UVec(T) *vec);
+ */
+#define uvec_sync(T, vec) ULIB_MACRO_CONCAT(uvec_sync_, T)(vec)
+
+/**
+ * Unmaps the file of a vector initialized via @func{uvec_map_file}, after writing
+ * the number of elements to it and trimming any excess capacity.
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}, e.g. if the file
+ *         could not be trimmed.
+ *
+ * @note Unlike @func{uvec_deinit}, which ignores them, this function reports I/O errors.
+ *       The vector is deinitialized in any case.
+ * @note This function does nothing if the vector is not backed by a file.
+ * @alias uvec_ret uvec_unmap(symbol T, UVec(T) *vec);
+ */
+#define uvec_unmap(T, vec) ULIB_MACRO_CONCAT(uvec_unmap_, T)(vec)
+
 /**
  * De-initializes a vector previously initialized via @func{uvec}.
  *
@@ -1247,6 +1973,21 @@ typedef enum uvec_ret {
  */
 #define uvec_reserve(T, vec, size) ULIB_MACRO_CONCAT(uvec_reserve_, T)(vec, size)
 
+/**
+ * Ensures the specified vector can hold at least as many elements as `size`,
+ * without applying the growth policy of the vector type.
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param size Number of elements the vector should be able to hold.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note The resulting capacity is exactly `size` if it is below 2^16 (2^8 on some platforms),
+ *       otherwise it exceeds `size` by at most 1/2^16 (1/2^8) of its value.
+ * @alias uvec_ret uvec_reserve_exact(symbol T, UVec(T) *vec, ulib_uint size);
+ */
+#define uvec_reserve_exact(T, vec, size) ULIB_MACRO_CONCAT(uvec_reserve_exact_, T)(vec, size)
+
 /**
  * Expands the specified vector so that it can contain additional `size` elements.
  *
@@ -1475,6 +2216,37 @@ typedef enum uvec_ret {
  */
 #define uvec_clear(T, vec) ULIB_MACRO_CONCAT(uvec_clear_, T)(vec)
 
+/**
+ * Removes all the elements that satisfy the specified predicate.
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param pred @ctype{(void *, T) -> bool} Predicate.
+ * @param ctx Context passed to the predicate.
+ * @return Number of removed elements.
+ *
+ * @note Elements retain their relative order. Unlike removing elements one by one,
+ *       this function moves each element at most once, so its cost is linear.
+ *
+ * @alias ulib_uint uvec_remove_if(symbol T, UVec(T) *vec, bool (*pred)(void *, T), void *ctx);
+ */
+#define uvec_remove_if(T, vec, pred, ctx) ULIB_MACRO_CONCAT(uvec_remove_if_, T)(vec, pred, ctx)
+
+/**
+ * Removes all the elements that do not satisfy the specified predicate.
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param pred @ctype{(void *, T) -> bool} Predicate.
+ * @param ctx Context passed to the predicate.
+ * @return Number of removed elements.
+ *
+ * @note Elements retain their relative order, and the cost is linear.
+ *
+ * @alias ulib_uint uvec_retain_if(symbol T, UVec(T) *vec, bool (*pred)(void *, T), void *ctx);
+ */
+#define uvec_retain_if(T, vec, pred, ctx) ULIB_MACRO_CONCAT(uvec_retain_if_, T)(vec, pred, ctx)
+
 /**
  * Removes all the elements in the vector.
  *
@@ -1779,6 +2551,52 @@ typedef enum uvec_ret {
  */
 #define uvec_sort_range(T, vec, start, len) ULIB_MACRO_CONCAT(uvec_sort_range_, T)(vec, start, len)
 
+/**
+ * Partially sorts the vector so that the element at the specified index is the one that would be
+ * there if the vector were sorted. Elements before it are not greater, and elements after it
+ * are not smaller.
+ * Average performance: *O(n)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param n Index of the element to select.
+ *
+ * @note Selection is performed via introselect: quickselect with median-of-three pivots,
+ *       falling back to heapsort on the current partition if it recurses too deeply,
+ *       which bounds the worst case to *O(n log n)*.
+ * @alias void uvec_nth_element(symbol T, UVec(T) *vec, ulib_uint n);
+ */
+#define uvec_nth_element(T, vec, n) ULIB_MACRO_CONCAT(uvec_nth_element_, T)(vec, n)
+
+/**
+ * Sorts the smallest `k` elements of the vector, moving them to its start.
+ * The order of the remaining elements is unspecified.
+ * Average performance: *O(n + k log k)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param k Number of elements to sort.
+ *
+ * @alias void uvec_partial_sort(symbol T, UVec(T) *vec, ulib_uint k);
+ */
+#define uvec_partial_sort(T, vec, k) ULIB_MACRO_CONCAT(uvec_partial_sort_, T)(vec, k)
+
+/**
+ * Retrieves the largest `k` elements of the vector, sorted in descending order.
+ * Average performance: *O(n + k log k)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param k Number of elements to retrieve.
+ * @param[out] dest Destination vector, which is overwritten with the result.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note The source vector is not modified, and at most `2k` elements of extra storage are used.
+ * @note `dest` and `vec` must be different instances.
+ * @alias uvec_ret uvec_top_k(symbol T, UVec(T) const *vec, ulib_uint k, UVec(T) *dest);
+ */
+#define uvec_top_k(T, vec, k, dest) ULIB_MACRO_CONCAT(uvec_top_k_, T)(vec, k, dest)
+
 /**
  * Finds the insertion index for the specified item in a sorted vector.
  * Average performance: *O(log n)*
@@ -1820,6 +2638,119 @@ typedef enum uvec_ret {
  */
 #define uvec_sorted_contains(T, vec, item) ULIB_MACRO_CONCAT(uvec_sorted_contains_, T)(vec, item)
 
+/**
+ * Returns the index of the specified element in a sorted vector, via a branchless binary search.
+ * Average performance: *O(log n)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param item Element to search.
+ * @return Index of the first occurrence of the element, or an invalid index.
+ *
+ * @note This variant avoids unpredictable branches and prefetches both candidate midpoints,
+ *       which usually makes it faster than @func{uvec_sorted_index_of} on large vectors.
+ * @alias ulib_uint uvec_sorted_index_of_branchless(symbol T, UVec(T) const *vec, T item);
+ */
+#define uvec_sorted_index_of_branchless(T, vec, item)                                              \
+    ULIB_MACRO_CONCAT(uvec_sorted_index_of_branchless_, T)(vec, item)
+
+/**
+ * Rearranges the elements of a sorted vector in Eytzinger (BFS) layout.
+ * Average performance: *O(n)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note The vector must be sorted. After this call, it must only be searched
+ *       via @func{uvec_eytzinger_index_of}.
+ * @alias uvec_ret uvec_eytzinger(symbol T, UVec(T) *vec);
+ */
+#define uvec_eytzinger(T, vec) ULIB_MACRO_CONCAT(uvec_eytzinger_, T)(vec)
+
+/**
+ * Returns the index of the specified element in a vector in Eytzinger layout.
+ * Average performance: *O(log n)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param item Element to search.
+ * @return Index of the found element, or an invalid index.
+ *
+ * @note The vector must have been rearranged via @func{uvec_eytzinger}.
+ * @alias ulib_uint uvec_eytzinger_index_of(symbol T, UVec(T) const *vec, T item);
+ */
+#define uvec_eytzinger_index_of(T, vec, item)                                                      \
+    ULIB_MACRO_CONCAT(uvec_eytzinger_index_of_, T)(vec, item)
+
+/**
+ * Retrieves the indexes of multiple elements in a sorted vector.
+ * Average performance: *O(m log(n/m))*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param items Sorted vector of elements to search.
+ * @param[out] indexes Indexes of the found elements, or invalid indexes.
+ *                     Must have room for as many indexes as the elements in `items`.
+ *
+ * @note Searches resume from the previous match and gallop forward, so this is faster
+ *       than repeatedly calling @func{uvec_sorted_index_of}.
+ * @alias void uvec_sorted_index_of_many(symbol T, UVec(T) const *vec, UVec(T) const *items,
+ *                                       ulib_uint *indexes);
+ */
+#define uvec_sorted_index_of_many(T, vec, items, indexes)                                          \
+    ULIB_MACRO_CONCAT(uvec_sorted_index_of_many_, T)(vec, items, indexes)
+
+/**
+ * Computes the intersection of two sorted vectors.
+ * Average performance: *O(min(n + m, n log(m/n)))*
+ *
+ * @param T Vector type.
+ * @param a First vector.
+ * @param b Second vector.
+ * @param[out] dest Destination vector, which is overwritten with the result.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note `dest` must not be the same instance as `a` or `b`.
+ * @note If one of the vectors is at least @val{UVEC_GALLOP_RATIO} times larger than the other,
+ *       elements of the smaller vector are located in the larger one via galloping.
+ *       Otherwise, the vectors are merged by a loop whose body has no data-dependent branches.
+ * @alias uvec_ret uvec_sorted_intersect(symbol T, UVec(T) const *a, UVec(T) const *b,
+ *                                       UVec(T) *dest);
+ */
+#define uvec_sorted_intersect(T, a, b, dest)                                                       \
+    ULIB_MACRO_CONCAT(uvec_sorted_intersect_, T)(a, b, dest)
+
+/**
+ * Computes the union of two sorted vectors.
+ * Average performance: *O(n + m)*
+ *
+ * @param T Vector type.
+ * @param a First vector.
+ * @param b Second vector.
+ * @param[out] dest Destination vector, which is overwritten with the result.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note `dest` must not be the same instance as `a` or `b`.
+ * @alias uvec_ret uvec_sorted_union(symbol T, UVec(T) const *a, UVec(T) const *b, UVec(T) *dest);
+ */
+#define uvec_sorted_union(T, a, b, dest) ULIB_MACRO_CONCAT(uvec_sorted_union_, T)(a, b, dest)
+
+/**
+ * Computes the difference between two sorted vectors, i.e. the elements of `a` not in `b`.
+ * Average performance: *O(min(n + m, n log(m/n)))*
+ *
+ * @param T Vector type.
+ * @param a First vector.
+ * @param b Second vector.
+ * @param[out] dest Destination vector, which is overwritten with the result.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note `dest` must not be the same instance as `a` or `b`.
+ * @alias uvec_ret uvec_sorted_diff(symbol T, UVec(T) const *a, UVec(T) const *b, UVec(T) *dest);
+ */
+#define uvec_sorted_diff(T, a, b, dest) ULIB_MACRO_CONCAT(uvec_sorted_diff_, T)(a, b, dest)
+
 /**
  * Inserts the specified element in a sorted vector.
  *
@@ -1849,6 +2780,71 @@ typedef enum uvec_ret {
 #define uvec_sorted_unique_insert(T, vec, item, idx)                                               \
     ULIB_MACRO_CONCAT(uvec_sorted_unique_insert_, T)(vec, item, idx)
 
+/**
+ * Inserts the elements of an array in a sorted vector.
+ * Average performance: *O(n + m log m)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param array Array of elements to insert, in any order.
+ * @param n Number of elements in the array.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note The elements are sorted in a temporary buffer and merged from the back of the vector
+ *       in a single pass, reallocating its storage at most once.
+ * @alias uvec_ret uvec_sorted_insert_all(symbol T, UVec(T) *vec, T const *array, ulib_uint n);
+ */
+#define uvec_sorted_insert_all(T, vec, array, n)                                                   \
+    ULIB_MACRO_CONCAT(uvec_sorted_insert_all_, T)(vec, array, n)
+
+/**
+ * Inserts the elements of an array in a sorted vector, skipping those that are already present,
+ * either in the vector or earlier in the array.
+ * Average performance: *O(n + m log m)*
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @param array Array of elements to insert, in any order.
+ * @param n Number of elements in the array.
+ * @return @val{UVEC_OK} if at least one element was inserted,
+ *         @val{UVEC_NO} if all the elements were already present, otherwise @val{UVEC_ERR}.
+ *
+ * @alias uvec_ret uvec_sorted_unique_insert_all(symbol T, UVec(T) *vec, T const *array,
+ *                                               ulib_uint n);
+ */
+#define uvec_sorted_unique_insert_all(T, vec, array, n)                                            \
+    ULIB_MACRO_CONCAT(uvec_sorted_unique_insert_all_, T)(vec, array, n)
+
+/**
+ * Merges a sorted vector into another sorted vector.
+ * Average performance: *O(n + m)*
+ *
+ * @param T Vector type.
+ * @param dest Destination vector.
+ * @param src Source vector.
+ * @return @val{UVEC_OK} on success, otherwise @val{UVEC_ERR}.
+ *
+ * @note `dest` and `src` must be different instances.
+ * @alias uvec_ret uvec_sorted_merge(symbol T, UVec(T) *dest, UVec(T) const *src);
+ */
+#define uvec_sorted_merge(T, dest, src) ULIB_MACRO_CONCAT(uvec_sorted_merge_, T)(dest, src)
+
+/**
+ * Merges a sorted vector into another sorted vector, skipping elements that are already present.
+ * Average performance: *O(n + m)*
+ *
+ * @param T Vector type.
+ * @param dest Destination vector.
+ * @param src Source vector.
+ * @return @val{UVEC_OK} if at least one element was inserted,
+ *         @val{UVEC_NO} if all the elements were already present, otherwise @val{UVEC_ERR}.
+ *
+ * @note `dest` and `src` must be different instances.
+ * @alias uvec_ret uvec_sorted_unique_merge(symbol T, UVec(T) *dest, UVec(T) const *src);
+ */
+#define uvec_sorted_unique_merge(T, dest, src)                                                     \
+    ULIB_MACRO_CONCAT(uvec_sorted_unique_merge_, T)(dest, src)
+
 /**
  * Removes the specified element from a sorted vector.
  *
@@ -1861,6 +2857,17 @@ typedef enum uvec_ret {
  */
 #define uvec_sorted_remove(T, vec, item) ULIB_MACRO_CONCAT(uvec_sorted_remove_, T)(vec, item)
 
+/**
+ * Removes consecutive duplicate elements from a sorted vector, in a single pass.
+ *
+ * @param T Vector type.
+ * @param vec Vector instance.
+ * @return Number of removed elements.
+ *
+ * @alias ulib_uint uvec_sorted_dedup(symbol T, UVec(T) *vec);
+ */
+#define uvec_sorted_dedup(T, vec) ULIB_MACRO_CONCAT(uvec_sorted_dedup_, T)(vec)
+
 /**
  * Finds the insertion index for the specified item in a sorted vector.
  * Average performance: *O(log n)*
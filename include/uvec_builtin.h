@@ -17,6 +17,7 @@
 #include "unumber.h"
 #include "ustring.h"
 #include "uvec.h" // IWYU pragma: export
+#include "uvec_parallel.h"
 
 ULIB_BEGIN_DECLS
 
@@ -74,6 +75,40 @@ UVEC_DECL_COMPARABLE_SPEC(ulib_ptr, ULIB_API)
  */
 UVEC_DECL_COMPARABLE_SPEC(UString, ULIB_API)
 
+// Parallel algorithms over numeric vectors.
+UVEC_DECL_PARALLEL_SPEC(ulib_int, ULIB_API)
+UVEC_DECL_PARALLEL_SPEC(ulib_uint, ULIB_API)
+UVEC_DECL_PARALLEL_SPEC(ulib_float, ULIB_API)
+
+/// @cond
+ULIB_API
+ulib_ret uvec_parse_ulib_int(UVec(ulib_int) *vec, UString string, UString delims);
+ULIB_API
+ulib_ret uvec_parse_ulib_uint(UVec(ulib_uint) *vec, UString string, UString delims);
+ULIB_API
+ulib_ret uvec_parse_ulib_float(UVec(ulib_float) *vec, UString string, UString delims);
+/// @endcond
+
+/**
+ * Parses a sequence of delimited numbers, such as a CSV column, appending them to the vector.
+ *
+ * Numbers are parsed independently of the current locale, via @func{ulib_str_parse_int},
+ * @func{ulib_str_parse_uint} or @func{ulib_str_parse_float}. Numbers are separated by any of
+ * the delimiter bytes, and the string may end with a delimiter (e.g. a final newline).
+ * If `'\n'` is a delimiter, `"\r\n"` line endings count as a single delimiter.
+ *
+ * @param T @ctype{symbol} Vector type, either @type{ulib_int}, @type{ulib_uint}
+ *          or @type{ulib_float}.
+ * @param vec @ctype{UVec(T) *} Vector.
+ * @param string @type{UString} String to parse.
+ * @param delims @type{UString} Delimiter bytes.
+ * @return @type{ulib_ret} @val{ULIB_OK} on success, @val{ULIB_ERR} if the string contains
+ *         an invalid or empty value, @val{ULIB_ERR_MEM} on allocation failure.
+ *
+ * @note On failure, the values parsed before the invalid one stay appended to the vector.
+ */
+#define uvec_parse(T, vec, string, delims) ULIB_MACRO_CONCAT(uvec_parse_, T)(vec, string, delims)
+
 /// @}
 
 ULIB_END_DECLS
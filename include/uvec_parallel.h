@@ -0,0 +1,386 @@
+/**
+ * Parallel algorithms over vectors.
+ *
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ *
+ * @file
+ */
+
+#ifndef UVEC_PARALLEL_H
+#define UVEC_PARALLEL_H
+
+#include "ualloc.h"
+#include "uattrs.h"
+#include "unumber.h"
+#include "upool.h"
+#include "uvec.h"
+#include <stdbool.h>
+
+ULIB_BEGIN_DECLS
+
+/**
+ * @defgroup UVec_parallel_constants UVec parallel algorithms constants
+ * @{
+ */
+
+/**
+ * Size of the chunks processed by parallel algorithms (B).
+ *
+ * @note Vectors are split into chunks of `UVEC_PARALLEL_CHUNK_SIZE / sizeof(T)` elements,
+ *       which span many cache lines, so that threads writing adjacent chunks can only
+ *       contend for the lines at their boundaries. Chunk boundaries only depend on the number
+ *       of elements, which makes the results of parallel algorithms independent from
+ *       the number of threads.
+ */
+#ifndef UVEC_PARALLEL_CHUNK_SIZE
+#define UVEC_PARALLEL_CHUNK_SIZE (UVEC_CACHE_LINE_SIZE * 64)
+#endif
+
+/// @}
+
+#define p_uvec_parallel_chunk(T)                                                                   \
+    ((ulib_uint)(UVEC_PARALLEL_CHUNK_SIZE / sizeof(T) ? UVEC_PARALLEL_CHUNK_SIZE / sizeof(T) : 1))
+
+/*
+ * Generates function declarations for the specified vector type.
+ *
+ * @param T [symbol] Vector type.
+ * @param ATTRS [attributes] Attributes of the declarations.
+ */
+#define P_UVEC_PARALLEL_DECL(T, ATTRS)                                                             \
+    /** @cond */                                                                                   \
+    ATTRS void uvec_parallel_foreach_##T(UPool *pool, UVec(T) *vec,                                \
+                                         void (*fn)(void *ctx, T *item), void *ctx);               \
+    ATTRS uvec_ret uvec_parallel_map_##T(UPool *pool, UVec(T) const *src, UVec(T) *dest,           \
+                                         T (*fn)(void *ctx, T item), void *ctx);                   \
+    ATTRS uvec_ret uvec_parallel_filter_##T(UPool *pool, UVec(T) const *src, UVec(T) *dest,        \
+                                            bool (*fn)(void *ctx, T item), void *ctx);             \
+    ATTRS T uvec_parallel_reduce_##T(UPool *pool, UVec(T) const *vec, T init,                      \
+                                     T (*fn)(void *ctx, T a, T b), void *ctx);                     \
+    /** @endcond */
+
+/*
+ * Generates function definitions for the specified vector type.
+ *
+ * @param T [symbol] Vector type.
+ * @param ATTRS [attributes] Attributes of the definitions.
+ */
+#define P_UVEC_PARALLEL_IMPL(T, ATTRS)                                                             \
+    /** @cond */                                                                                   \
+                                                                                                   \
+    typedef struct p_uvec_parallel_##T {                                                           \
+        T *src;                                                                                    \
+        T *dest;                                                                                   \
+        ulib_uint count;                                                                           \
+        ulib_uint chunks;                                                                          \
+        void *ctx;                                                                                 \
+        void (*foreach_fn)(void *, T *);                                                           \
+        T (*map_fn)(void *, T);                                                                    \
+        bool (*filter_fn)(void *, T);                                                              \
+        T (*reduce_fn)(void *, T, T);                                                              \
+        ulib_byte *flags;                                                                          \
+        ulib_uint *offsets;                                                                        \
+        T *partials;                                                                               \
+    } p_uvec_parallel_##T;                                                                         \
+                                                                                                   \
+    ULIB_INLINE p_uvec_parallel_##T p_uvec_parallel_init_##T(UVec(T) const *vec, void *ctx) {      \
+        p_uvec_parallel_##T p = ulib_struct_init;                                                  \
+        ulib_uint const chunk = p_uvec_parallel_chunk(T);                                          \
+        p.src = uvec_data(T, vec);                                                                 \
+        p.count = uvec_count(T, vec);                                                              \
+        p.chunks = p.count / chunk + (p.count % chunk ? 1 : 0);                                    \
+        p.ctx = ctx;                                                                               \
+        return p;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE ulib_uint p_uvec_parallel_end_##T(p_uvec_parallel_##T const *p,                    \
+                                                  ulib_uint chunk) {                               \
+        return chunk + 1 < p->chunks ? (chunk + 1) * p_uvec_parallel_chunk(T) : p->count;          \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_parallel_foreach_range_##T(void *ctx, ulib_uint start,                 \
+                                                       ulib_uint len) {                            \
+        p_uvec_parallel_##T *p = (p_uvec_parallel_##T *)ctx;                                       \
+        ulib_uint i = start * p_uvec_parallel_chunk(T);                                            \
+        ulib_uint const end = p_uvec_parallel_end_##T(p, start + len - 1);                         \
+        for (; i < end; ++i) p->foreach_fn(p->ctx, p->src + i);                                    \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_parallel_map_range_##T(void *ctx, ulib_uint start,                     \
+                                                   ulib_uint len) {                                \
+        p_uvec_parallel_##T *p = (p_uvec_parallel_##T *)ctx;                                       \
+        ulib_uint i = start * p_uvec_parallel_chunk(T);                                            \
+        ulib_uint const end = p_uvec_parallel_end_##T(p, start + len - 1);                         \
+        for (; i < end; ++i) p->dest[i] = p->map_fn(p->ctx, p->src[i]);                            \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_parallel_flag_range_##T(void *ctx, ulib_uint start,                    \
+                                                    ulib_uint len) {                               \
+        p_uvec_parallel_##T *p = (p_uvec_parallel_##T *)ctx;                                       \
+        for (ulib_uint c = start; c < start + len; ++c) {                                          \
+            ulib_uint i = c * p_uvec_parallel_chunk(T), kept = 0;                                  \
+            ulib_uint const end = p_uvec_parallel_end_##T(p, c);                                   \
+            for (; i < end; ++i) {                                                                 \
+                ulib_byte const flag = p->filter_fn(p->ctx, p->src[i]) ? 1 : 0;                    \
+                p->flags[i] = flag;                                                                \
+                kept += flag;                                                                      \
+            }                                                                                      \
+            p->offsets[c] = kept;                                                                  \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_parallel_compact_range_##T(void *ctx, ulib_uint start,                 \
+                                                       ulib_uint len) {                            \
+        p_uvec_parallel_##T *p = (p_uvec_parallel_##T *)ctx;                                       \
+        for (ulib_uint c = start; c < start + len; ++c) {                                          \
+            T *out = p->dest + p->offsets[c];                                                      \
+            ulib_uint i = c * p_uvec_parallel_chunk(T);                                            \
+            ulib_uint const end = p_uvec_parallel_end_##T(p, c);                                   \
+            for (; i < end; ++i) {                                                                 \
+                if (p->flags[i]) *(out++) = p->src[i];                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE T p_uvec_parallel_reduce_chunk_##T(p_uvec_parallel_##T const *p, ulib_uint c) {    \
+        ulib_uint i = c * p_uvec_parallel_chunk(T);                                                \
+        ulib_uint const end = p_uvec_parallel_end_##T(p, c);                                       \
+        T acc = p->src[i++];                                                                       \
+        for (; i < end; ++i) acc = p->reduce_fn(p->ctx, acc, p->src[i]);                           \
+        return acc;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ULIB_INLINE void p_uvec_parallel_reduce_range_##T(void *ctx, ulib_uint start,                  \
+                                                      ulib_uint len) {                             \
+        p_uvec_parallel_##T *p = (p_uvec_parallel_##T *)ctx;                                       \
+        for (ulib_uint c = start; c < start + len; ++c) {                                          \
+            p->partials[c] = p_uvec_parallel_reduce_chunk_##T(p, c);                               \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS void uvec_parallel_foreach_##T(UPool *pool, UVec(T) *vec,                                \
+                                         void (*fn)(void *ctx, T *item), void *ctx) {              \
+        p_uvec_parallel_##T p = p_uvec_parallel_init_##T(vec, ctx);                                \
+        p.foreach_fn = fn;                                                                         \
+        if (upool_parallel_for(pool, 0, p.chunks, 0, p_uvec_parallel_foreach_range_##T, &p)) {     \
+            p_uvec_parallel_foreach_range_##T(&p, 0, p.chunks);                                    \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_parallel_map_##T(UPool *pool, UVec(T) const *src, UVec(T) *dest,           \
+                                         T (*fn)(void *ctx, T item), void *ctx) {                  \
+        p_uvec_parallel_##T p = p_uvec_parallel_init_##T(src, ctx);                                \
+        if (uvec_reserve(T, dest, p.count)) return UVEC_ERR;                                       \
+        p.src = uvec_data(T, src);                                                                 \
+        p.dest = uvec_data(T, dest);                                                               \
+        p.map_fn = fn;                                                                             \
+        if (upool_parallel_for(pool, 0, p.chunks, 0, p_uvec_parallel_map_range_##T, &p)) {         \
+            p_uvec_parallel_map_range_##T(&p, 0, p.chunks);                                        \
+        }                                                                                          \
+        p_uvec_set_count_##T(dest, p.count);                                                       \
+        return UVEC_OK;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS uvec_ret uvec_parallel_filter_##T(UPool *pool, UVec(T) const *src, UVec(T) *dest,        \
+                                            bool (*fn)(void *ctx, T item), void *ctx) {            \
+        p_uvec_parallel_##T p = p_uvec_parallel_init_##T(src, ctx);                                \
+        uvec_ret ret = UVEC_ERR;                                                                   \
+        ulib_uint total = 0;                                                                       \
+        p.filter_fn = fn;                                                                          \
+                                                                                                   \
+        if (!p.count) {                                                                            \
+            uvec_clear(T, dest);                                                                   \
+            return UVEC_OK;                                                                        \
+        }                                                                                          \
+                                                                                                   \
+        p.flags = (ulib_byte *)ulib_alloc_array(p.flags, p.count);                                 \
+        p.offsets = (ulib_uint *)ulib_alloc_array(p.offsets, p.chunks);                            \
+        if (!(p.flags && p.offsets)) goto end;                                                     \
+                                                                                                   \
+        if (upool_parallel_for(pool, 0, p.chunks, 0, p_uvec_parallel_flag_range_##T, &p)) {        \
+            p_uvec_parallel_flag_range_##T(&p, 0, p.chunks);                                       \
+        }                                                                                          \
+                                                                                                   \
+        for (ulib_uint c = 0; c < p.chunks; ++c) {                                                 \
+            ulib_uint const kept = p.offsets[c];                                                   \
+            p.offsets[c] = total;                                                                  \
+            total += kept;                                                                         \
+        }                                                                                          \
+                                                                                                   \
+        if (uvec_reserve(T, dest, total)) goto end;                                                \
+        p.dest = uvec_data(T, dest);                                                               \
+        if (upool_parallel_for(pool, 0, p.chunks, 0, p_uvec_parallel_compact_range_##T, &p)) {     \
+            p_uvec_parallel_compact_range_##T(&p, 0, p.chunks);                                    \
+        }                                                                                          \
+        p_uvec_set_count_##T(dest, total);                                                         \
+        ret = UVEC_OK;                                                                             \
+                                                                                                   \
+    end:                                                                                           \
+        ulib_free(p.flags);                                                                        \
+        ulib_free(p.offsets);                                                                      \
+        return ret;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    ATTRS T uvec_parallel_reduce_##T(UPool *pool, UVec(T) const *vec, T init,                      \
+                                     T (*fn)(void *ctx, T a, T b), void *ctx) {                    \
+        p_uvec_parallel_##T p = p_uvec_parallel_init_##T(vec, ctx);                                \
+        p.reduce_fn = fn;                                                                          \
+        if (!p.count) return init;                                                                 \
+                                                                                                   \
+        /* Without workers, or on allocation failure, reduce the chunks in order on this thread. */\
+        bool const parallel = p.chunks > 1 && upool_threads(pool);                                 \
+        p.partials = parallel ? (T *)ulib_alloc_array(p.partials, p.chunks) : NULL;                \
+                                                                                                   \
+        if (p.partials) {                                                                          \
+            if (upool_parallel_for(pool, 0, p.chunks, 0, p_uvec_parallel_reduce_range_##T, &p)) {  \
+                p_uvec_parallel_reduce_range_##T(&p, 0, p.chunks);                                 \
+            }                                                                                      \
+            for (ulib_uint c = 0; c < p.chunks; ++c) init = fn(ctx, init, p.partials[c]);          \
+            ulib_free(p.partials);                                                                 \
+        } else {                                                                                   \
+            for (ulib_uint c = 0; c < p.chunks; ++c) {                                             \
+                init = fn(ctx, init, p_uvec_parallel_reduce_chunk_##T(&p, c));                     \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        return init;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /** @endcond */
+
+/**
+ * @defgroup UVec_parallel_definitions UVec parallel algorithms definitions
+ * @{
+ */
+
+/**
+ * Declares parallel algorithms for a previously declared vector type.
+ *
+ * @param T @ctype{symbol} Vector type.
+ */
+#define UVEC_DECL_PARALLEL(T) P_UVEC_PARALLEL_DECL(T, ulib_unused)
+
+/**
+ * Declares parallel algorithms for a previously declared vector type,
+ * prepending a specifier to the generated declarations.
+ *
+ * @param T @ctype{symbol} Vector type.
+ * @param SPEC @ctype{specifier} Specifier.
+ */
+#define UVEC_DECL_PARALLEL_SPEC(T, SPEC) P_UVEC_PARALLEL_DECL(T, SPEC ulib_unused)
+
+/**
+ * Implements parallel algorithms for a previously declared vector type.
+ *
+ * @param T @ctype{symbol} Vector type.
+ */
+#define UVEC_IMPL_PARALLEL(T) P_UVEC_PARALLEL_IMPL(T, ulib_unused)
+
+/**
+ * Defines static parallel algorithms for a previously declared vector type.
+ *
+ * @param T @ctype{symbol} Vector type.
+ */
+#define UVEC_INIT_PARALLEL(T)                                                                      \
+    P_UVEC_PARALLEL_DECL(T, ULIB_INLINE ulib_unused)                                               \
+    P_UVEC_PARALLEL_IMPL(T, ULIB_INLINE ulib_unused)
+
+/// @}
+
+/**
+ * @defgroup UVec_parallel_api UVec parallel algorithms API
+ * @{
+ */
+
+/**
+ * Invokes the specified function on each element of the vector, in parallel.
+ *
+ * @param T @ctype{symbol} Vector type.
+ * @param pool @ctype{#UPool *} Thread pool, or NULL to run on the calling thread.
+ * @param vec @ctype{#UVec(T) *} Vector instance.
+ * @param fn @ctype{(void *, T *) -> void} Function invoked on each element.
+ * @param ctx @ctype{void *} Context passed to the function.
+ *
+ * @alias void uvec_parallel_foreach(symbol T, UPool *pool, UVec(T) *vec,
+ *                                   void (*fn)(void *, T *), void *ctx);
+ */
+#define uvec_parallel_foreach(T, pool, vec, fn, ctx)                                               \
+    ULIB_MACRO_CONCAT(uvec_parallel_foreach_, T)(pool, vec, fn, ctx)
+
+/**
+ * Stores the results of the specified function, invoked on each element
+ * of the source vector, in the destination vector, in parallel.
+ *
+ * @param T @ctype{symbol} Vector type.
+ * @param pool @ctype{#UPool *} Thread pool, or NULL to run on the calling thread.
+ * @param src @ctype{#UVec(T) const *} Source vector.
+ * @param dest @ctype{#UVec(T) *} Destination vector.
+ * @param fn @ctype{(void *, T) -> T} Mapping function.
+ * @param ctx @ctype{void *} Context passed to the function.
+ * @return @ctype{#uvec_ret} Return code.
+ *
+ * @note The destination vector may be the source vector, in which case
+ *       elements are mapped in place.
+ *
+ * @alias uvec_ret uvec_parallel_map(symbol T, UPool *pool, UVec(T) const *src, UVec(T) *dest,
+ *                                   T (*fn)(void *, T), void *ctx);
+ */
+#define uvec_parallel_map(T, pool, src, dest, fn, ctx)                                             \
+    ULIB_MACRO_CONCAT(uvec_parallel_map_, T)(pool, src, dest, fn, ctx)
+
+/**
+ * Copies the elements of the source vector that satisfy the specified predicate
+ * to the destination vector, in parallel.
+ *
+ * The predicate is evaluated in parallel, then elements are compacted based on
+ * the prefix sum of the number of matches in each chunk.
+ *
+ * @param T @ctype{symbol} Vector type.
+ * @param pool @ctype{#UPool *} Thread pool, or NULL to run on the calling thread.
+ * @param src @ctype{#UVec(T) const *} Source vector.
+ * @param dest @ctype{#UVec(T) *} Destination vector.
+ * @param fn @ctype{(void *, T) -> bool} Predicate.
+ * @param ctx @ctype{void *} Context passed to the predicate.
+ * @return @ctype{#uvec_ret} Return code.
+ *
+ * @note The filter is stable: elements retain their relative order.
+ * @note The destination vector must not be the source vector.
+ *
+ * @alias uvec_ret uvec_parallel_filter(symbol T, UPool *pool, UVec(T) const *src, UVec(T) *dest,
+ *                                      bool (*fn)(void *, T), void *ctx);
+ */
+#define uvec_parallel_filter(T, pool, src, dest, fn, ctx)                                          \
+    ULIB_MACRO_CONCAT(uvec_parallel_filter_, T)(pool, src, dest, fn, ctx)
+
+/**
+ * Combines the elements of the vector via the specified function, in parallel.
+ *
+ * Each chunk is reduced from left to right, then partial results are combined with
+ * the initial value, again from left to right.
+ *
+ * @param T @ctype{symbol} Vector type.
+ * @param pool @ctype{#UPool *} Thread pool, or NULL to run on the calling thread.
+ * @param vec @ctype{#UVec(T) const *} Vector instance.
+ * @param init @ctype{T} Initial value.
+ * @param fn @ctype{(void *, T, T) -> T} Associative combining function.
+ * @param ctx @ctype{void *} Context passed to the function.
+ * @return @ctype{T} Result of the reduction, or the initial value if the vector is empty.
+ *
+ * @note Since chunk boundaries do not depend on the number of threads, the result is
+ *       deterministic even if the function is only approximately associative,
+ *       as is the case for floating point addition.
+ *
+ * @alias T uvec_parallel_reduce(symbol T, UPool *pool, UVec(T) const *vec, T init,
+ *                               T (*fn)(void *, T, T), void *ctx);
+ */
+#define uvec_parallel_reduce(T, pool, vec, init, fn, ctx)                                          \
+    ULIB_MACRO_CONCAT(uvec_parallel_reduce_, T)(pool, vec, init, fn, ctx)
+
+/// @}
+
+ULIB_END_DECLS
+
+#endif // UVEC_PARALLEL_H
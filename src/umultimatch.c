@@ -0,0 +1,271 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "umultimatch.h"
+#include "ualloc.h"
+#include <string.h>
+
+// States are identified by the offset of their row in the transition table, that is, by their
+// index multiplied by the number of byte classes. The root is state zero, which never matches,
+// so zero also denotes the end of output chains.
+struct p_umultimatch_out {
+    // Index of the pattern matched by the state, or P_UMULTIMATCH_NONE.
+    ulib_uint pattern;
+    // Depth of the state, which is the length of the pattern.
+    ulib_uint length;
+    // Next state along the failure chain that matches some pattern.
+    ulib_uint next;
+};
+
+#define P_UMULTIMATCH_NONE ULIB_UINT_MAX
+
+#define p_umultimatch_out(mm, state)                                                               \
+    ((mm)->_out + ((state) - (mm)->_out_start) / (mm)->_classes)
+
+// Temporary per-state data, indexed by trie state.
+typedef struct p_umultimatch_build {
+    ulib_uint *trie;
+    ulib_uint *depth;
+    ulib_uint *match;
+    ulib_uint *fail;
+    ulib_uint *dict;
+    ulib_uint *order;
+    ulib_uint *id;
+    ulib_uint count;
+} p_umultimatch_build;
+
+static ulib_uint p_umultimatch_classes(UMultiMatch *mm, UVec(UString) const *patterns) {
+    bool used[256] = { false };
+
+    uvec_foreach (UString, patterns, p) {
+        unsigned char const *s = (unsigned char const *)ustring_data(*p.item);
+        for (ulib_uint i = 0, len = ustring_length(*p.item); i < len; ++i) used[s[i]] = true;
+    }
+
+    // Bytes that do not occur in any pattern share the last class.
+    ulib_uint classes = 0;
+    for (unsigned i = 0; i < 256; ++i) {
+        if (used[i]) mm->_class[i] = (ulib_byte)classes++;
+    }
+    for (unsigned i = 0; i < 256; ++i) {
+        if (!used[i]) mm->_class[i] = (ulib_byte)classes;
+    }
+
+    return classes < 256 ? classes + 1 : classes;
+}
+
+static void p_umultimatch_insert(UMultiMatch const *mm, p_umultimatch_build *b, UString pattern,
+                                 ulib_uint idx) {
+    unsigned char const *s = (unsigned char const *)ustring_data(pattern);
+    ulib_uint const len = ustring_length(pattern);
+    ulib_uint state = 0;
+
+    for (ulib_uint i = 0; i < len; ++i) {
+        ulib_uint *child = b->trie + (size_t)state * mm->_classes + mm->_class[s[i]];
+
+        if (!*child) {
+            *child = b->count++;
+            b->depth[*child] = b->depth[state] + 1;
+            b->match[*child] = P_UMULTIMATCH_NONE;
+        }
+
+        state = *child;
+    }
+
+    // Duplicate patterns are reported with the index of their first occurrence.
+    if (b->match[state] == P_UMULTIMATCH_NONE) b->match[state] = idx;
+}
+
+// Computes failure links in breadth-first order, and completes the trie into a DFA by replacing
+// missing transitions with those of the failure state.
+static void p_umultimatch_link(UMultiMatch const *mm, p_umultimatch_build *b) {
+    ulib_uint const classes = mm->_classes;
+    ulib_uint head = 0, tail = 0;
+    b->fail[0] = b->dict[0] = 0;
+    b->order[tail++] = 0;
+
+    while (head < tail) {
+        ulib_uint const state = b->order[head++];
+        ulib_uint *row = b->trie + (size_t)state * classes;
+        ulib_uint const *fail_row = b->trie + (size_t)b->fail[state] * classes;
+
+        for (ulib_uint c = 0; c < classes; ++c) {
+            ulib_uint const child = row[c];
+
+            if (!child) {
+                row[c] = state ? fail_row[c] : 0;
+                continue;
+            }
+
+            ulib_uint const fail = state ? fail_row[c] : 0;
+            b->fail[child] = fail;
+            b->dict[child] = b->match[fail] != P_UMULTIMATCH_NONE ? fail : b->dict[fail];
+            b->order[tail++] = child;
+        }
+    }
+}
+
+// Builds the final transition table, numbering states that do not match any pattern first.
+static ulib_ret p_umultimatch_compact(UMultiMatch *mm, p_umultimatch_build *b) {
+    ulib_uint const classes = mm->_classes;
+    ulib_uint plain = 0, out = 0;
+
+    for (ulib_uint i = 0; i < b->count; ++i) {
+        ulib_uint const s = b->order[i];
+        if (b->match[s] == P_UMULTIMATCH_NONE && !b->dict[s]) b->id[s] = plain++;
+    }
+
+    for (ulib_uint i = 0; i < b->count; ++i) {
+        ulib_uint const s = b->order[i];
+        if (b->match[s] != P_UMULTIMATCH_NONE || b->dict[s]) b->id[s] = plain + out++;
+    }
+
+    mm->_delta = (ulib_uint *)ulib_malloc(sizeof(*mm->_delta) * b->count * classes);
+    if (!mm->_delta) return ULIB_ERR_MEM;
+
+    if (out) {
+        mm->_out = ulib_alloc_array(mm->_out, out);
+        if (!mm->_out) return ULIB_ERR_MEM;
+    }
+
+    mm->_out_start = plain * classes;
+
+    for (ulib_uint s = 0; s < b->count; ++s) {
+        ulib_uint const *src = b->trie + (size_t)s * classes;
+        ulib_uint *dst = mm->_delta + (size_t)b->id[s] * classes;
+        for (ulib_uint c = 0; c < classes; ++c) dst[c] = b->id[src[c]] * classes;
+        if (b->id[s] < plain) continue;
+
+        struct p_umultimatch_out *o = mm->_out + (b->id[s] - plain);
+        o->pattern = b->match[s];
+        o->length = b->depth[s];
+        o->next = b->dict[s] ? b->id[b->dict[s]] * classes : 0;
+    }
+
+    return ULIB_OK;
+}
+
+ulib_ret umultimatch_init(UMultiMatch *mm, UVec(UString) const *patterns) {
+    UMultiMatch const zero = ulib_struct_init;
+    *mm = zero;
+
+    // The trie has at most one state per pattern byte, plus the root.
+    size_t states = 1;
+
+    uvec_foreach (UString, patterns, p) {
+        ulib_uint const len = ustring_length(*p.item);
+        if (!len) return ULIB_ERR;
+        states += len;
+    }
+
+    mm->_classes = p_umultimatch_classes(mm, patterns);
+    if (states > ULIB_UINT_MAX / mm->_classes) return ULIB_ERR;
+
+    p_umultimatch_build b = { 0 };
+    b.trie = (ulib_uint *)ulib_calloc(states * mm->_classes, sizeof(*b.trie));
+    b.depth = ulib_alloc_array(b.depth, states * 6);
+    ulib_ret ret = ULIB_ERR_MEM;
+    if (!(b.trie && b.depth)) goto end;
+
+    b.match = b.depth + states;
+    b.fail = b.match + states;
+    b.dict = b.fail + states;
+    b.order = b.dict + states;
+    b.id = b.order + states;
+
+    b.depth[0] = 0;
+    b.match[0] = P_UMULTIMATCH_NONE;
+    b.count = 1;
+
+    uvec_foreach (UString, patterns, p) {
+        p_umultimatch_insert(mm, &b, *p.item, p.i);
+    }
+
+    p_umultimatch_link(mm, &b);
+    ret = p_umultimatch_compact(mm, &b);
+
+end:
+    ulib_free(b.trie);
+    ulib_free(b.depth);
+    if (ret) umultimatch_deinit(mm);
+    return ret;
+}
+
+void umultimatch_deinit(UMultiMatch *mm) {
+    ulib_free(mm->_delta);
+    ulib_free(mm->_out);
+    mm->_delta = NULL;
+    mm->_out = NULL;
+}
+
+bool umultimatch_find(UMultiMatch const *mm, UString string, UMultiMatchHit *hit) {
+    UMultiMatchScan scan = umultimatch_scan(mm);
+    umultimatch_scan_feed(&scan, ustring_data(string), ustring_length(string));
+
+    UMultiMatchHit lhit;
+    if (!umultimatch_scan_next(&scan, &lhit)) return false;
+    if (hit) *hit = lhit;
+    return true;
+}
+
+void umultimatch_scan_feed(UMultiMatchScan *scan, void const *buf, size_t length) {
+    scan->_offset += scan->_length;
+    scan->_buf = (unsigned char const *)buf;
+    scan->_length = length;
+    scan->_pos = 0;
+}
+
+ustream_ret umultimatch_scan_read(UMultiMatchScan *scan, UIStream *stream, void *buf, size_t size,
+                                  size_t *read) {
+    size_t lread = 0;
+    ustream_ret ret = uistream_read(stream, buf, size, &lread);
+    umultimatch_scan_feed(scan, buf, lread);
+    if (read) *read = lread;
+    return ret;
+}
+
+bool umultimatch_scan_next(UMultiMatchScan *scan, UMultiMatchHit *hit) {
+    UMultiMatch const *mm = scan->_mm;
+
+    while (true) {
+        // Report the pending matches along the output chain of the last state.
+        while (scan->_out) {
+            struct p_umultimatch_out const *o = p_umultimatch_out(mm, scan->_out);
+            scan->_out = o->next;
+            if (o->pattern == P_UMULTIMATCH_NONE) continue;
+
+            hit->pattern = o->pattern;
+            hit->length = o->length;
+            hit->start = scan->_end - o->length;
+            return true;
+        }
+
+        ulib_uint const *delta = mm->_delta;
+        ulib_byte const *cls = mm->_class;
+        ulib_uint const out_start = mm->_out_start;
+        unsigned char const *buf = scan->_buf;
+        size_t const length = scan->_length;
+        ulib_uint state = scan->_state;
+        size_t i = scan->_pos;
+
+        for (; i < length; ++i) {
+            state = delta[state + cls[buf[i]]];
+            if (state >= out_start) break;
+        }
+
+        scan->_state = state;
+
+        if (i == length) {
+            scan->_pos = length;
+            return false;
+        }
+
+        scan->_pos = i + 1;
+        scan->_end = scan->_offset + i + 1;
+        scan->_out = state;
+    }
+}
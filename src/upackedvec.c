@@ -0,0 +1,243 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "upackedvec.h"
+#include "ualloc.h"
+#include "unumber.h"
+#include "uvec_builtin.h"
+
+ULIB_CONST
+ULIB_INLINE
+unsigned p_upackedvec_bits_for(ulib_uint range) {
+    return range ? ulib_uint_log2(range) + 1 : 0;
+}
+
+// Number of padding words past the packed elements, so that reading any element never needs
+// to check whether its bits span the last word, see p_upackedvec_read.
+#define P_UPACKEDVEC_PAD_WORDS 1
+
+ULIB_INLINE
+size_t p_upackedvec_words(ulib_uint n, unsigned bits) {
+    return ((size_t)n * bits + 63) / 64 + P_UPACKEDVEC_PAD_WORDS;
+}
+
+ULIB_INLINE
+void p_upackedvec_write(uint64_t *words, size_t pos, unsigned bits, uint64_t v) {
+    size_t const w = pos / 64;
+    unsigned const off = (unsigned)(pos % 64);
+    words[w] |= v << off;
+    if (off + bits > 64) words[w + 1] |= v >> (64 - off);
+}
+
+// Vectorized decoding of 32-bit elements on x86-64. Eight consecutive elements starting at a
+// multiple of eight span exactly `bits` bytes, so every such group has the same layout: element i
+// starts at bit (i * bits) % 32 of the 32-bit lane (i * bits) / 32, and is assembled from that
+// lane and the next one. The AVX2 kernel is selected at runtime unless the build targets AVX2.
+#if !defined(ULIB_NO_SIMD) && ULIB_UINT_MAX == UINT32_MAX && defined(__x86_64__) &&               \
+    (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#define P_UPACKEDVEC_SIMD 1
+#define P_UPACKEDVEC_SIMD_GROUP 8
+
+#if defined(__AVX2__)
+#define p_upackedvec_has_simd() true
+#else
+#define p_upackedvec_has_simd() __builtin_cpu_supports("avx2")
+#endif
+
+__attribute__((target("avx2"))) static ulib_uint
+p_upackedvec_unpack_simd(unsigned char const *bytes, size_t size, size_t pos, unsigned bits,
+                         ulib_uint base, ulib_uint n, ulib_uint *array) {
+    int lo[P_UPACKEDVEC_SIMD_GROUP], hi[P_UPACKEDVEC_SIMD_GROUP], shift[P_UPACKEDVEC_SIMD_GROUP];
+
+    for (unsigned i = 0; i < P_UPACKEDVEC_SIMD_GROUP; ++i) {
+        lo[i] = (int)(i * bits / 32);
+        hi[i] = lo[i] + 1;
+        shift[i] = (int)(i * bits % 32);
+    }
+
+    __m256i const lo_idx = _mm256_loadu_si256((__m256i const *)lo);
+    __m256i const hi_idx = _mm256_loadu_si256((__m256i const *)hi);
+    __m256i const lo_shift = _mm256_loadu_si256((__m256i const *)shift);
+    // Shifting left by 32 yields zero, which discards the next lane for elements that fit.
+    __m256i const hi_shift = _mm256_sub_epi32(_mm256_set1_epi32(32), lo_shift);
+    __m256i const mask = _mm256_set1_epi32((int)(UINT32_MAX >> (32 - bits)));
+    __m256i const vbase = _mm256_set1_epi32((int)base);
+    ulib_uint i = 0;
+
+    // Each group loads 32 bytes, which must not extend past the allocated words.
+    for (; n - i >= P_UPACKEDVEC_SIMD_GROUP && pos / 8 + 32 <= size;
+         i += P_UPACKEDVEC_SIMD_GROUP, pos += P_UPACKEDVEC_SIMD_GROUP * bits) {
+        __m256i const v = _mm256_loadu_si256((__m256i const *)(bytes + pos / 8));
+        __m256i x = _mm256_srlv_epi32(_mm256_permutevar8x32_epi32(v, lo_idx), lo_shift);
+        x = _mm256_or_si256(x, _mm256_sllv_epi32(_mm256_permutevar8x32_epi32(v, hi_idx), hi_shift));
+        x = _mm256_add_epi32(_mm256_and_si256(x, mask), vbase);
+        _mm256_storeu_si256((__m256i *)(array + i), x);
+    }
+
+    return i;
+}
+
+#endif
+
+static uvec_ret p_upackedvec_alloc(UPackedVec *vec, ulib_uint n, unsigned bits, bool delta) {
+    upackedvec_deinit(vec);
+    vec->_count = n;
+    vec->_bits = (ulib_byte)bits;
+
+    if (bits) {
+        vec->_words = (uint64_t *)ulib_calloc_array(vec->_words, p_upackedvec_words(n, bits));
+        if (!vec->_words) goto err;
+    }
+
+    if (delta) {
+        ulib_uint const count = n / UPACKEDVEC_BLOCK_SIZE + 1;
+        vec->_anchors = (ulib_uint *)ulib_alloc_array(vec->_anchors, count);
+        if (!vec->_anchors) goto err;
+    }
+
+    return UVEC_OK;
+
+err:
+    upackedvec_deinit(vec);
+    return UVEC_ERR;
+}
+
+void upackedvec_deinit(UPackedVec *vec) {
+    ulib_free(vec->_words);
+    ulib_free(vec->_anchors);
+    *vec = upackedvec();
+}
+
+uvec_ret upackedvec_build(UPackedVec *vec, ulib_uint const *array, ulib_uint n) {
+    ulib_uint min = n ? array[0] : 0, max = min;
+
+    for (ulib_uint i = 1; i < n; ++i) {
+        min = ulib_min(min, array[i]);
+        max = ulib_max(max, array[i]);
+    }
+
+    unsigned const bits = p_upackedvec_bits_for(max - min);
+    if (p_upackedvec_alloc(vec, n, bits, false)) return UVEC_ERR;
+    vec->_base = min;
+    if (!bits) return UVEC_OK;
+
+    for (ulib_uint i = 0; i < n; ++i) {
+        p_upackedvec_write(vec->_words, (size_t)i * bits, bits, array[i] - min);
+    }
+
+    return UVEC_OK;
+}
+
+uvec_ret upackedvec_build_sorted(UPackedVec *vec, ulib_uint const *array, ulib_uint n) {
+    // Frame of reference: the minimum difference between consecutive elements.
+    ulib_uint min = n > 1 ? ULIB_UINT_MAX : 0, max = 0;
+
+    for (ulib_uint i = 1; i < n; ++i) {
+        if (array[i] < array[i - 1]) return UVEC_NO;
+        ulib_uint const delta = array[i] - array[i - 1];
+        min = ulib_min(min, delta);
+        max = ulib_max(max, delta);
+    }
+
+    unsigned const bits = p_upackedvec_bits_for(max - min);
+    if (p_upackedvec_alloc(vec, n, bits, true)) return UVEC_ERR;
+    vec->_base = min;
+
+    for (ulib_uint i = 0; i < n; ++i) {
+        if (i % UPACKEDVEC_BLOCK_SIZE == 0) {
+            // Block anchors store absolute values, their differences are not needed.
+            vec->_anchors[i / UPACKEDVEC_BLOCK_SIZE] = array[i];
+        } else if (bits) {
+            ulib_uint const delta = array[i] - array[i - 1] - min;
+            p_upackedvec_write(vec->_words, (size_t)i * bits, bits, delta);
+        }
+    }
+
+    return UVEC_OK;
+}
+
+size_t upackedvec_memory(UPackedVec const *vec) {
+    size_t size = 0;
+    if (vec->_words) size += p_upackedvec_words(vec->_count, vec->_bits) * sizeof(uint64_t);
+    if (vec->_anchors) size += (vec->_count / UPACKEDVEC_BLOCK_SIZE + 1) * sizeof(ulib_uint);
+    return size;
+}
+
+ulib_uint p_upackedvec_get_delta(UPackedVec const *vec, ulib_uint idx) {
+    ulib_uint const first = idx - idx % UPACKEDVEC_BLOCK_SIZE;
+    ulib_uint value = vec->_anchors[first / UPACKEDVEC_BLOCK_SIZE];
+    unsigned const bits = vec->_bits;
+    uint64_t sum = 0;
+
+    for (size_t pos = ((size_t)first + 1) * bits, end = ((size_t)idx + 1) * bits; pos < end;
+         pos += bits) {
+        sum += p_upackedvec_read(vec->_words, pos, bits);
+    }
+
+    return value + (ulib_uint)sum + (ulib_uint)((idx - first) * vec->_base);
+}
+
+static void p_upackedvec_unpack_words(UPackedVec const *vec, ulib_uint start, ulib_uint n,
+                                      ulib_uint *array) {
+    uint64_t const *const words = vec->_words;
+    unsigned const bits = vec->_bits;
+    ulib_uint const base = vec->_base;
+    size_t pos = (size_t)start * bits;
+    ulib_uint i = 0;
+
+#if defined(P_UPACKEDVEC_SIMD)
+    if (bits && n >= 2 * P_UPACKEDVEC_SIMD_GROUP && p_upackedvec_has_simd()) {
+        for (; (start + i) % P_UPACKEDVEC_SIMD_GROUP; ++i, pos += bits) {
+            array[i] = base + (ulib_uint)p_upackedvec_read(words, pos, bits);
+        }
+
+        size_t const size = p_upackedvec_words(vec->_count, bits) * sizeof(*words);
+        ulib_uint const done = p_upackedvec_unpack_simd((unsigned char const *)words, size, pos,
+                                                        bits, base, n - i, array + i);
+        i += done;
+        pos += (size_t)done * bits;
+    }
+#endif
+
+    for (; i < n; ++i, pos += bits) {
+        array[i] = base + (ulib_uint)p_upackedvec_read(words, pos, bits);
+    }
+}
+
+void upackedvec_unpack(UPackedVec const *vec, ulib_uint start, ulib_uint n, ulib_uint *array) {
+    if (!n) return;
+
+    if (!vec->_anchors) {
+        p_upackedvec_unpack_words(vec, start, n, array);
+        return;
+    }
+
+    // Decode the deltas, then turn them into values via a running sum, restarting at each anchor.
+    p_upackedvec_unpack_words(vec, start + 1, n - 1, array + 1);
+    ulib_uint value = p_upackedvec_get_delta(vec, start);
+    array[0] = value;
+
+    for (ulib_uint i = 1, idx = start + 1; i < n; ++i, ++idx) {
+        if (idx % UPACKEDVEC_BLOCK_SIZE == 0) {
+            value = vec->_anchors[idx / UPACKEDVEC_BLOCK_SIZE];
+        } else {
+            value += array[i];
+        }
+        array[i] = value;
+    }
+}
+
+uvec_ret upackedvec_to_uvec(UPackedVec const *vec, UVec(ulib_uint) *dest) {
+    ulib_uint const count = uvec_count(ulib_uint, dest);
+    if (uvec_expand(ulib_uint, dest, vec->_count)) return UVEC_ERR;
+    upackedvec_unpack(vec, 0, vec->_count, uvec_data(ulib_uint, dest) + count);
+    p_uvec_set_count_ulib_uint(dest, count + vec->_count);
+    return UVEC_OK;
+}
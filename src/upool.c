@@ -0,0 +1,441 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "upool.h"
+#include "ualloc.h"
+#include "udeque.h"
+#include "uutils.h"
+#include <stdbool.h>
+
+// clang-format off
+
+#if defined(ULIB_NO_THREADS) || (!defined(_WIN32) && defined(__STDC_NO_ATOMICS__))
+    #ifndef ULIB_NO_THREADS
+        #define ULIB_NO_THREADS
+    #endif
+    typedef ulib_uint p_upool_counter;
+    typedef char p_upool_mutex;
+    typedef char p_upool_cond;
+    typedef char p_upool_thread;
+    #define p_upool_counter_init(c, v) (*(c) = (v))
+    #define p_upool_counter_get(c) (*(c))
+    #define p_upool_counter_add(c, v) (*(c) += (v))
+    #define p_upool_counter_sub(c, v) p_upool_counter_fetch_sub(c, v)
+    ULIB_INLINE ulib_uint p_upool_counter_fetch_sub(ulib_uint *c, ulib_uint v) {
+        ulib_uint const old = *c;
+        *c -= v;
+        return old;
+    }
+    #define p_upool_mutex_init(m) ((void)(m), true)
+    #define p_upool_mutex_deinit(m) ((void)(m))
+    #define p_upool_mutex_lock(m) ((void)(m))
+    #define p_upool_mutex_unlock(m) ((void)(m))
+    #define p_upool_cond_init(c) ((void)(c), true)
+    #define p_upool_cond_deinit(c) ((void)(c))
+    #define p_upool_cond_wait(c, m) ((void)(c), (void)(m))
+    #define p_upool_cond_signal(c) ((void)(c))
+    #define p_upool_cond_broadcast(c) ((void)(c))
+    #define P_UPOOL_TLS
+#else
+    #include <stdatomic.h>
+    typedef atomic_size_t p_upool_counter;
+    #define p_upool_counter_init(c, v) atomic_init(c, v)
+    #define p_upool_counter_get(c) atomic_load_explicit(c, memory_order_acquire)
+    #define p_upool_counter_add(c, v) atomic_fetch_add_explicit(c, v, memory_order_relaxed)
+    #define p_upool_counter_sub(c, v) atomic_fetch_sub_explicit(c, v, memory_order_release)
+
+    #if defined(_WIN32)
+        #include <windows.h>
+        typedef CRITICAL_SECTION p_upool_mutex;
+        typedef CONDITION_VARIABLE p_upool_cond;
+        typedef HANDLE p_upool_thread;
+        #define p_upool_mutex_init(m) (InitializeCriticalSection(m), true)
+        #define p_upool_mutex_deinit(m) DeleteCriticalSection(m)
+        #define p_upool_mutex_lock(m) EnterCriticalSection(m)
+        #define p_upool_mutex_unlock(m) LeaveCriticalSection(m)
+        #define p_upool_cond_init(c) (InitializeConditionVariable(c), true)
+        #define p_upool_cond_deinit(c) ((void)(c))
+        #define p_upool_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+        #define p_upool_cond_signal(c) WakeConditionVariable(c)
+        #define p_upool_cond_broadcast(c) WakeAllConditionVariable(c)
+        #define P_UPOOL_TLS __declspec(thread)
+    #else
+        #include <pthread.h>
+        #include <unistd.h>
+        typedef pthread_mutex_t p_upool_mutex;
+        typedef pthread_cond_t p_upool_cond;
+        typedef pthread_t p_upool_thread;
+        #define p_upool_mutex_init(m) (pthread_mutex_init(m, NULL) == 0)
+        #define p_upool_mutex_deinit(m) pthread_mutex_destroy(m)
+        #define p_upool_mutex_lock(m) pthread_mutex_lock(m)
+        #define p_upool_mutex_unlock(m) pthread_mutex_unlock(m)
+        #define p_upool_cond_init(c) (pthread_cond_init(c, NULL) == 0)
+        #define p_upool_cond_deinit(c) pthread_cond_destroy(c)
+        #define p_upool_cond_wait(c, m) pthread_cond_wait(c, m)
+        #define p_upool_cond_signal(c) pthread_cond_signal(c)
+        #define p_upool_cond_broadcast(c) pthread_cond_broadcast(c)
+        #define P_UPOOL_TLS _Thread_local
+    #endif
+#endif
+
+// clang-format on
+
+typedef struct p_upool_task {
+    UPoolGroup *group;
+    upool_task_fn fn;
+    void *ctx;
+    ulib_uint start;
+    ulib_uint len;
+} p_upool_task;
+
+UDEQUE_INIT(p_upool_task)
+
+typedef struct p_upool_worker {
+    UPool *pool;
+    UDeque(p_upool_task) tasks;
+    p_upool_mutex lock;
+    p_upool_thread thread;
+    unsigned index;
+} p_upool_worker;
+
+struct UPool {
+    // Workers, followed by the deque that receives tasks spawned by other threads.
+    p_upool_worker *workers;
+    unsigned count;
+    p_upool_counter queued;
+    p_upool_mutex lock;
+    p_upool_cond cond;
+    unsigned sleeping;
+    bool stop;
+};
+
+struct UPoolGroup {
+    UPool *pool;
+    p_upool_counter pending;
+};
+
+typedef struct p_upool_for {
+    upool_range_fn fn;
+    void *ctx;
+    ulib_uint grain;
+} p_upool_for;
+
+static P_UPOOL_TLS p_upool_worker *current_worker = NULL;
+
+static void p_upool_group_release(UPoolGroup *group) {
+    // The group may be released by its joiner as soon as the counter drops to zero.
+    UPool *pool = group->pool;
+    if (p_upool_counter_sub(&group->pending, 1) != 1) return;
+
+    // Last task of the group: wake up the threads that may be waiting for it.
+    p_upool_mutex_lock(&pool->lock);
+    if (pool->sleeping) p_upool_cond_broadcast(&pool->cond);
+    p_upool_mutex_unlock(&pool->lock);
+}
+
+static ulib_ret p_upool_spawn(p_upool_task task) {
+    UPool *pool = task.group->pool;
+    p_upool_worker *w = current_worker;
+    if (!w || w->pool != pool) w = pool->workers + pool->count;
+
+    p_upool_counter_add(&task.group->pending, 1);
+    p_upool_counter_add(&pool->queued, 1);
+    p_upool_mutex_lock(&w->lock);
+    uvec_ret ret = udeque_push_back(p_upool_task, &w->tasks, task);
+    p_upool_mutex_unlock(&w->lock);
+
+    if (ret) {
+        p_upool_counter_sub(&pool->queued, 1);
+        p_upool_group_release(task.group);
+        return ULIB_ERR_MEM;
+    }
+
+    p_upool_mutex_lock(&pool->lock);
+    if (pool->sleeping) p_upool_cond_signal(&pool->cond);
+    p_upool_mutex_unlock(&pool->lock);
+    return ULIB_OK;
+}
+
+static void p_upool_exec(p_upool_task task) {
+    if (task.fn) {
+        task.fn(task.ctx);
+    } else {
+        // Range task: keep splitting the range, leaving the right halves to thieves.
+        p_upool_for const *f = (p_upool_for const *)task.ctx;
+
+        while (task.len > f->grain) {
+            p_upool_task right = task;
+            right.start += task.len / 2;
+            right.len -= task.len / 2;
+            if (p_upool_spawn(right)) break;
+            task.len /= 2;
+        }
+
+        f->fn(f->ctx, task.start, task.len);
+    }
+
+    p_upool_group_release(task.group);
+}
+
+static bool p_upool_try_run(UPool *pool, p_upool_worker *self) {
+    p_upool_task task;
+    bool found = false;
+
+    if (self) {
+        p_upool_mutex_lock(&self->lock);
+        found = udeque_pop_back(p_upool_task, &self->tasks, &task);
+        p_upool_mutex_unlock(&self->lock);
+    }
+
+    unsigned const count = pool->count + 1;
+    unsigned const first = self ? self->index + 1 : 0;
+
+    for (unsigned i = 0; !found && i < count; ++i) {
+        p_upool_worker *victim = pool->workers + (first + i) % count;
+        if (victim == self) continue;
+        p_upool_mutex_lock(&victim->lock);
+        found = udeque_pop_front(p_upool_task, &victim->tasks, &task);
+        p_upool_mutex_unlock(&victim->lock);
+    }
+
+    if (!found) return false;
+
+    p_upool_counter_sub(&pool->queued, 1);
+    p_upool_exec(task);
+    return true;
+}
+
+#ifndef ULIB_NO_THREADS
+
+static void p_upool_worker_loop(p_upool_worker *w) {
+    UPool *pool = w->pool;
+    current_worker = w;
+
+    for (;;) {
+        if (p_upool_try_run(pool, w)) continue;
+
+        p_upool_mutex_lock(&pool->lock);
+        while (!pool->stop && !p_upool_counter_get(&pool->queued)) {
+            pool->sleeping++;
+            p_upool_cond_wait(&pool->cond, &pool->lock);
+            pool->sleeping--;
+        }
+        bool const stop = pool->stop && !p_upool_counter_get(&pool->queued);
+        p_upool_mutex_unlock(&pool->lock);
+
+        if (stop) break;
+    }
+
+    current_worker = NULL;
+}
+
+#if defined(_WIN32)
+
+static DWORD WINAPI p_upool_worker_main(LPVOID arg) {
+    p_upool_worker_loop((p_upool_worker *)arg);
+    return 0;
+}
+
+static bool p_upool_thread_start(p_upool_worker *w) {
+    w->thread = CreateThread(NULL, 0, p_upool_worker_main, w, 0, NULL);
+    return w->thread != NULL;
+}
+
+static void p_upool_thread_join(p_upool_worker *w) {
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+}
+
+#else
+
+static void *p_upool_worker_main(void *arg) {
+    p_upool_worker_loop((p_upool_worker *)arg);
+    return NULL;
+}
+
+static bool p_upool_thread_start(p_upool_worker *w) {
+    return pthread_create(&w->thread, NULL, p_upool_worker_main, w) == 0;
+}
+
+static void p_upool_thread_join(p_upool_worker *w) {
+    pthread_join(w->thread, NULL);
+}
+
+#endif
+
+#endif // ULIB_NO_THREADS
+
+unsigned upool_processors(void) {
+#if defined(ULIB_NO_THREADS)
+    return 1;
+#elif defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (unsigned)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long const count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned)count : 1;
+#else
+    return 1;
+#endif
+}
+
+static void p_upool_stop(UPool *pool, unsigned started) {
+    p_upool_mutex_lock(&pool->lock);
+    pool->stop = true;
+    p_upool_cond_broadcast(&pool->cond);
+    p_upool_mutex_unlock(&pool->lock);
+
+#ifndef ULIB_NO_THREADS
+    for (unsigned i = 0; i < started; ++i) {
+        p_upool_thread_join(pool->workers + i);
+    }
+#else
+    (void)started;
+#endif
+}
+
+static void p_upool_deinit_workers(UPool *pool, unsigned count) {
+    for (unsigned i = 0; i < count; ++i) {
+        p_upool_mutex_deinit(&pool->workers[i].lock);
+        udeque_deinit(p_upool_task, &pool->workers[i].tasks);
+    }
+    ulib_free(pool->workers);
+}
+
+UPool *upool_new(unsigned threads) {
+#ifdef ULIB_NO_THREADS
+    threads = 0;
+#else
+    if (!threads) threads = upool_processors() - 1;
+#endif
+
+    unsigned init = 0;
+    UPool *pool = (UPool *)ulib_alloc(pool);
+    if (!pool) return NULL;
+
+    pool->count = threads;
+    pool->sleeping = 0;
+    pool->stop = false;
+    p_upool_counter_init(&pool->queued, 0);
+    pool->workers = (p_upool_worker *)ulib_alloc_array(pool->workers, threads + 1);
+    if (!pool->workers) goto err_workers;
+
+    for (; init <= threads; ++init) {
+        p_upool_worker *w = pool->workers + init;
+        w->pool = pool;
+        w->index = init;
+        w->tasks = udeque(p_upool_task);
+        if (!p_upool_mutex_init(&w->lock)) goto err_locks;
+    }
+
+    if (!p_upool_mutex_init(&pool->lock)) goto err_locks;
+    if (!p_upool_cond_init(&pool->cond)) goto err_cond;
+
+#ifndef ULIB_NO_THREADS
+    for (unsigned i = 0; i < threads; ++i) {
+        if (!p_upool_thread_start(pool->workers + i)) {
+            p_upool_stop(pool, i);
+            goto err_threads;
+        }
+    }
+#endif
+
+    return pool;
+
+#ifndef ULIB_NO_THREADS
+err_threads:
+    p_upool_cond_deinit(&pool->cond);
+#endif
+err_cond:
+    p_upool_mutex_deinit(&pool->lock);
+err_locks:
+    p_upool_deinit_workers(pool, init);
+err_workers:
+    ulib_free(pool);
+    return NULL;
+}
+
+void upool_free(UPool *pool) {
+    if (!pool) return;
+    p_upool_stop(pool, pool->count);
+    p_upool_cond_deinit(&pool->cond);
+    p_upool_mutex_deinit(&pool->lock);
+    p_upool_deinit_workers(pool, pool->count + 1);
+    ulib_free(pool);
+}
+
+unsigned upool_threads(UPool const *pool) {
+    return pool ? pool->count : 0;
+}
+
+UPoolGroup *upool_group_new(UPool *pool) {
+    UPoolGroup *group = (UPoolGroup *)ulib_alloc(group);
+    if (!group) return NULL;
+    group->pool = pool;
+    p_upool_counter_init(&group->pending, 0);
+    return group;
+}
+
+void upool_group_free(UPoolGroup *group) {
+    if (!group) return;
+    upool_group_join(group);
+    ulib_free(group);
+}
+
+ulib_ret upool_group_spawn(UPoolGroup *group, upool_task_fn fn, void *ctx) {
+    p_upool_task task = { group, fn, ctx, 0, 0 };
+    return p_upool_spawn(task);
+}
+
+void upool_group_join(UPoolGroup *group) {
+    UPool *pool = group->pool;
+    p_upool_worker *self = current_worker;
+    if (self && self->pool != pool) self = NULL;
+
+    while (p_upool_counter_get(&group->pending)) {
+        if (p_upool_try_run(pool, self)) continue;
+
+        // The remaining tasks are running on other threads: sleep until the group completes,
+        // or until new tasks are queued.
+        p_upool_mutex_lock(&pool->lock);
+        while (p_upool_counter_get(&group->pending) && !p_upool_counter_get(&pool->queued)) {
+            pool->sleeping++;
+            p_upool_cond_wait(&pool->cond, &pool->lock);
+            pool->sleeping--;
+        }
+        p_upool_mutex_unlock(&pool->lock);
+    }
+}
+
+ulib_ret upool_parallel_for(UPool *pool, ulib_uint start, ulib_uint len, ulib_uint grain,
+                            upool_range_fn fn, void *ctx) {
+    if (!len) return ULIB_OK;
+
+    if (!grain) {
+        // Aim for several chunks per thread, so that stealing can balance the load.
+        ulib_uint const chunks = (ulib_uint)(upool_threads(pool) + 1) * 8;
+        grain = len / chunks ? len / chunks : 1;
+    }
+
+    if (!pool || !pool->count || len <= grain) {
+        fn(ctx, start, len);
+        return ULIB_OK;
+    }
+
+    p_upool_for f = { fn, ctx, grain };
+    UPoolGroup group;
+    group.pool = pool;
+    p_upool_counter_init(&group.pending, 0);
+    p_upool_task task = { &group, NULL, &f, start, len };
+
+    ulib_ret const ret = p_upool_spawn(task);
+    if (ret) return ret;
+
+    upool_group_join(&group);
+    return ULIB_OK;
+}
@@ -0,0 +1,376 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "urope.h"
+#include "ualloc.h"
+#include "udebug.h"
+#include "unumber.h"
+#include <string.h>
+
+// Ropes are AVL trees: the heights of the children of each node differ by at most one,
+// so the height is bounded by ~1.44 log2(n) for n chunks.
+#define P_UROPE_MAX_HEIGHT 96
+
+// Number of chunks passed to each vectored write.
+#define P_UROPE_WRITE_BATCH 64
+
+struct p_urope_node {
+    size_t length;
+    size_t refs;
+    ulib_byte height;
+    union {
+        // Inner nodes (height > 0).
+        struct {
+            struct p_urope_node *left;
+            struct p_urope_node *right;
+        } c;
+        // Leaves (height == 0): chunks are slices of the string owned by the source leaf,
+        // which is the leaf itself unless the chunk has been obtained via urope_range.
+        struct {
+            struct p_urope_node *src;
+            size_t offset;
+        } l;
+    };
+    UString string;
+};
+
+typedef struct p_urope_node URopeNode;
+
+#define p_urope_leaf_data(n) (ustring_data((n)->l.src->string) + (n)->l.offset)
+
+ULIB_INLINE
+URopeNode *p_urope_retain(URopeNode *node) {
+    if (node) node->refs++;
+    return node;
+}
+
+static void p_urope_release(URopeNode *node) {
+    if (!node || --node->refs) return;
+
+    if (node->height) {
+        p_urope_release(node->c.left);
+        p_urope_release(node->c.right);
+    } else if (node->l.src == node) {
+        ustring_deinit(&node->string);
+    } else {
+        p_urope_release(node->l.src);
+    }
+
+    ulib_free(node);
+}
+
+// Unless stated otherwise, the functions below take ownership of the nodes passed as arguments,
+// and return NULL if an allocation fails, after releasing them.
+
+static URopeNode *p_urope_leaf(UString string) {
+    URopeNode *node = ulib_alloc(node);
+
+    if (!node) {
+        ustring_deinit(&string);
+        return NULL;
+    }
+
+    node->length = ustring_length(string);
+    node->refs = 1;
+    node->height = 0;
+    node->l.src = node;
+    node->l.offset = 0;
+    node->string = string;
+    return node;
+}
+
+static URopeNode *p_urope_concat(URopeNode *left, URopeNode *right) {
+    URopeNode *node = left && right ? ulib_alloc(node) : NULL;
+
+    if (!node) {
+        p_urope_release(left);
+        p_urope_release(right);
+        return NULL;
+    }
+
+    node->length = left->length + right->length;
+    node->refs = 1;
+    node->height = (ulib_byte)(ulib_max(left->height, right->height) + 1);
+    node->c.left = left;
+    node->c.right = right;
+    node->string = ustring_null;
+    return node;
+}
+
+static URopeNode *p_urope_merge(URopeNode *left, URopeNode *right) {
+    UString string;
+    char *buf = ustring(&string, left->length + right->length);
+
+    if (buf) {
+        memcpy(buf, p_urope_leaf_data(left), left->length);
+        memcpy(buf + left->length, p_urope_leaf_data(right), right->length);
+    }
+
+    p_urope_release(left);
+    p_urope_release(right);
+    return buf ? p_urope_leaf(string) : NULL;
+}
+
+// Restores the AVL invariant via rotations, assuming heights differ by at most two.
+static URopeNode *p_urope_balance(URopeNode *a, URopeNode *b) {
+    if (a->height > b->height + 1) {
+        URopeNode *al = p_urope_retain(a->c.left), *ar = p_urope_retain(a->c.right);
+        p_urope_release(a);
+        if (al->height >= ar->height) return p_urope_concat(al, p_urope_concat(ar, b));
+        URopeNode *arl = p_urope_retain(ar->c.left), *arr = p_urope_retain(ar->c.right);
+        p_urope_release(ar);
+        return p_urope_concat(p_urope_concat(al, arl), p_urope_concat(arr, b));
+    }
+
+    if (b->height > a->height + 1) {
+        URopeNode *bl = p_urope_retain(b->c.left), *br = p_urope_retain(b->c.right);
+        p_urope_release(b);
+        if (br->height >= bl->height) return p_urope_concat(p_urope_concat(a, bl), br);
+        URopeNode *bll = p_urope_retain(bl->c.left), *blr = p_urope_retain(bl->c.right);
+        p_urope_release(bl);
+        return p_urope_concat(p_urope_concat(a, bll), p_urope_concat(blr, br));
+    }
+
+    return p_urope_concat(a, b);
+}
+
+// Joins two trees by descending the spine of the taller one, copying the visited path.
+static URopeNode *p_urope_join(URopeNode *left, URopeNode *right) {
+    if (!left) return right;
+    if (!right) return left;
+
+    if (left->height > right->height + 1) {
+        URopeNode *ll = p_urope_retain(left->c.left), *lr = p_urope_retain(left->c.right);
+        p_urope_release(left);
+        URopeNode *joined = p_urope_join(lr, right);
+
+        if (!joined) {
+            p_urope_release(ll);
+            return NULL;
+        }
+
+        return p_urope_balance(ll, joined);
+    }
+
+    if (right->height > left->height + 1) {
+        URopeNode *rl = p_urope_retain(right->c.left), *rr = p_urope_retain(right->c.right);
+        p_urope_release(right);
+        URopeNode *joined = p_urope_join(left, rl);
+
+        if (!joined) {
+            p_urope_release(rr);
+            return NULL;
+        }
+
+        return p_urope_balance(joined, rr);
+    }
+
+    if (!(left->height || right->height) && left->length + right->length <= UROPE_MERGE_SIZE) {
+        return p_urope_merge(left, right);
+    }
+
+    return p_urope_concat(left, right);
+}
+
+// Does not take ownership of the leaf.
+static URopeNode *p_urope_slice(URopeNode *leaf, size_t start, size_t length) {
+    // Short slices are copied inline, so that they do not keep large chunks alive.
+    if (p_ustring_length_is_small(length)) {
+        return p_urope_leaf(ustring_copy(p_urope_leaf_data(leaf) + start, length));
+    }
+
+    URopeNode *node = ulib_alloc(node);
+    if (!node) return NULL;
+
+    node->length = length;
+    node->refs = 1;
+    node->height = 0;
+    node->l.src = p_urope_retain(leaf->l.src);
+    node->l.offset = leaf->l.offset + start;
+    node->string = ustring_null;
+    return node;
+}
+
+// Does not take ownership of the node, the range must not be empty.
+static URopeNode *p_urope_range(URopeNode *node, size_t start, size_t length) {
+    if (!start && length == node->length) return p_urope_retain(node);
+    if (!node->height) return p_urope_slice(node, start, length);
+
+    size_t const left_length = node->c.left->length;
+    if (start + length <= left_length) return p_urope_range(node->c.left, start, length);
+    if (start >= left_length) return p_urope_range(node->c.right, start - left_length, length);
+
+    URopeNode *left = p_urope_range(node->c.left, start, left_length - start);
+    if (!left) return NULL;
+
+    URopeNode *right = p_urope_range(node->c.right, 0, start + length - left_length);
+    if (!right) {
+        p_urope_release(left);
+        return NULL;
+    }
+
+    return p_urope_join(left, right);
+}
+
+typedef struct p_urope_iter {
+    URopeNode const *stack[P_UROPE_MAX_HEIGHT];
+    unsigned count;
+} p_urope_iter;
+
+ULIB_INLINE
+void p_urope_iter_init(p_urope_iter *iter, URopeNode const *root) {
+    iter->count = 0;
+    if (root) iter->stack[iter->count++] = root;
+}
+
+ULIB_INLINE
+URopeNode const *p_urope_iter_next(p_urope_iter *iter) {
+    if (!iter->count) return NULL;
+    URopeNode const *node = iter->stack[--iter->count];
+
+    while (node->height) {
+        iter->stack[iter->count++] = node->c.right;
+        node = node->c.left;
+    }
+
+    return node;
+}
+
+void urope_deinit(URope *rope) {
+    p_urope_release(rope->_root);
+    rope->_root = NULL;
+}
+
+URope urope_dup(URope const *rope) {
+    URope dup = { p_urope_retain(rope->_root) };
+    return dup;
+}
+
+size_t urope_length(URope const *rope) {
+    return rope->_root ? rope->_root->length : 0;
+}
+
+ulib_ret urope_append_ustring(URope *rope, UString string) {
+    if (ustring_is_null(string)) return ULIB_ERR_MEM;
+
+    if (ustring_is_empty(string)) {
+        ustring_deinit(&string);
+        return ULIB_OK;
+    }
+
+    URopeNode *leaf = p_urope_leaf(string);
+    if (!leaf) return ULIB_ERR_MEM;
+
+    // Keep the current root alive, in case the join fails.
+    URopeNode *root = p_urope_join(p_urope_retain(rope->_root), leaf);
+    if (!root) return ULIB_ERR_MEM;
+
+    p_urope_release(rope->_root);
+    rope->_root = root;
+    return ULIB_OK;
+}
+
+ulib_ret urope_append_buf(URope *rope, char const *buf, size_t length) {
+    return length ? urope_append_ustring(rope, ustring_copy(buf, length)) : ULIB_OK;
+}
+
+ulib_ret urope_append(URope *rope, URope const *other) {
+    if (!other->_root) return ULIB_OK;
+
+    URopeNode *root = p_urope_join(p_urope_retain(rope->_root), p_urope_retain(other->_root));
+    if (!root) return ULIB_ERR_MEM;
+
+    p_urope_release(rope->_root);
+    rope->_root = root;
+    return ULIB_OK;
+}
+
+ulib_ret urope_range(URope const *rope, size_t start, size_t length, URope *range) {
+    size_t const rope_length = urope_length(rope);
+    if (start > rope_length || length > rope_length - start) return ULIB_ERR;
+
+    URopeNode *root = NULL;
+
+    if (length) {
+        root = p_urope_range(rope->_root, start, length);
+        if (!root) return ULIB_ERR_MEM;
+    }
+
+    range->_root = root;
+    return ULIB_OK;
+}
+
+char urope_char_at(URope const *rope, size_t idx) {
+    URopeNode const *node = rope->_root;
+    ulib_assert(idx < urope_length(rope));
+
+    while (node->height) {
+        size_t const left_length = node->c.left->length;
+
+        if (idx < left_length) {
+            node = node->c.left;
+        } else {
+            idx -= left_length;
+            node = node->c.right;
+        }
+    }
+
+    return p_urope_leaf_data(node)[idx];
+}
+
+size_t urope_chunk_count(URope const *rope) {
+    p_urope_iter iter;
+    p_urope_iter_init(&iter, rope->_root);
+    size_t count = 0;
+    while (p_urope_iter_next(&iter)) ++count;
+    return count;
+}
+
+UString urope_to_ustring(URope const *rope) {
+    size_t const length = urope_length(rope);
+    UString string;
+    char *buf = ustring(&string, length);
+    if (!buf) return ustring_null;
+
+    p_urope_iter iter;
+    p_urope_iter_init(&iter, rope->_root);
+
+    for (URopeNode const *leaf; (leaf = p_urope_iter_next(&iter)) != NULL;) {
+        memcpy(buf, p_urope_leaf_data(leaf), leaf->length);
+        buf += leaf->length;
+    }
+
+    return string;
+}
+
+ustream_ret urope_write(URope const *rope, UOStream *stream, size_t *written) {
+    UIOVec bufs[P_UROPE_WRITE_BATCH];
+    size_t count = 0, total = 0, lwritten;
+    ustream_ret ret = USTREAM_OK;
+
+    p_urope_iter iter;
+    p_urope_iter_init(&iter, rope->_root);
+
+    for (URopeNode const *leaf; (leaf = p_urope_iter_next(&iter)) != NULL;) {
+        bufs[count].base = p_urope_leaf_data(leaf);
+        bufs[count++].size = leaf->length;
+        if (count < P_UROPE_WRITE_BATCH) continue;
+
+        ret = uostream_writev(stream, bufs, count, &lwritten);
+        total += lwritten;
+        count = 0;
+        if (ret) break;
+    }
+
+    if (!ret && count) {
+        ret = uostream_writev(stream, bufs, count, &lwritten);
+        total += lwritten;
+    }
+
+    if (written) *written = total;
+    return ret;
+}
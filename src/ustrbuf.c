@@ -26,17 +26,54 @@ uvec_ret ustrbuf_append_format(UStrBuf *buf, char const *format, ...) {
 }
 
 uvec_ret ustrbuf_append_format_list(UStrBuf *buf, char const *format, va_list args) {
-    size_t length = ulib_str_flength_list(format, args);
-    size_t size = length + 1;
-    uvec_ret ret = uvec_expand(char, buf, (ulib_uint)size);
+    ulib_uint const old_length = ustrbuf_length(buf);
+    size_t const spare = ustrbuf_size(buf) - old_length;
 
-    if (ret == UVEC_OK) {
-        ulib_uint old_length = ustrbuf_length(buf);
+    // Format into the spare capacity first, so that the string is only formatted twice
+    // if the buffer must grow.
+    va_list cargs;
+    va_copy(cargs, args);
+    int const res = vsnprintf(spare ? ustrbuf_data(buf) + old_length : NULL, spare, format, cargs);
+    va_end(cargs);
+
+    size_t const length = res > 0 ? (size_t)res : 0;
+
+    if (length >= spare) {
+        size_t const size = length + 1;
+        uvec_ret ret = uvec_expand(char, buf, (ulib_uint)size);
+        if (ret) return ret;
         vsnprintf(ustrbuf_data(buf) + old_length, size, format, args);
-        p_uvec_set_count_char(buf, old_length + (ulib_uint)length);
     }
 
-    return ret;
+    p_uvec_set_count_char(buf, old_length + (ulib_uint)length);
+    return UVEC_OK;
+}
+
+ULIB_INLINE
+char *p_ustrbuf_num_reserve(UStrBuf *buf) {
+    if (uvec_expand(char, buf, ULIB_NUM_STR_SIZE)) return NULL;
+    return ustrbuf_data(buf) + ustrbuf_length(buf);
+}
+
+ULIB_INLINE
+uvec_ret p_ustrbuf_num_commit(UStrBuf *buf, size_t length) {
+    p_uvec_set_count_char(buf, ustrbuf_length(buf) + (ulib_uint)length);
+    return UVEC_OK;
+}
+
+uvec_ret ustrbuf_append_int(UStrBuf *buf, ulib_int value) {
+    char *dst = p_ustrbuf_num_reserve(buf);
+    return dst ? p_ustrbuf_num_commit(buf, ulib_str_from_int(dst, value)) : UVEC_ERR;
+}
+
+uvec_ret ustrbuf_append_uint(UStrBuf *buf, ulib_uint value) {
+    char *dst = p_ustrbuf_num_reserve(buf);
+    return dst ? p_ustrbuf_num_commit(buf, ulib_str_from_uint(dst, value)) : UVEC_ERR;
+}
+
+uvec_ret ustrbuf_append_float(UStrBuf *buf, ulib_float value) {
+    char *dst = p_ustrbuf_num_reserve(buf);
+    return dst ? p_ustrbuf_num_commit(buf, ulib_str_from_float(dst, value)) : UVEC_ERR;
 }
 
 ULIB_INLINE
@@ -68,6 +105,11 @@ UString ustrbuf_to_ustring_reuse(UStrBuf *buf, ulib_uint length) {
 UString ustrbuf_to_ustring(UStrBuf *buf) {
     ulib_uint length = ustrbuf_length(buf);
 
+    if (!p_ustring_length_is_valid(length)) {
+        ustrbuf_deinit(buf);
+        return ustring_null;
+    }
+
     if (p_ustring_length_is_small(length) || p_uvec_is_small(char, buf)) {
         return ustrbuf_to_ustring_copy(buf, length);
     }
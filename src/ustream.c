@@ -20,6 +20,19 @@
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define P_USTREAM_WRITEV
+#if defined(IOV_MAX) && IOV_MAX < 64
+#define P_USTREAM_IOV_MAX IOV_MAX
+#else
+#define P_USTREAM_IOV_MAX 64
+#endif
+#endif
+
 typedef struct UStreamBuf {
     size_t size;
     char *orig;
@@ -67,6 +80,58 @@ ustream_file_writef(void *file, size_t *written, char const *format, va_list arg
     return ret;
 }
 
+#ifdef P_USTREAM_WRITEV
+
+static ustream_ret p_ustream_fd_writev(int fd, struct iovec *iov, int count, size_t *written) {
+    while (count) {
+        ssize_t const w = writev(fd, iov, count);
+
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return USTREAM_ERR_IO;
+        }
+
+        // Skip fully written buffers, then adjust the partially written one.
+        size_t rem = (size_t)w;
+        *written += rem;
+        for (; count && rem >= iov->iov_len; ++iov, --count) rem -= iov->iov_len;
+        if (!count) break;
+        if (!w) return USTREAM_ERR_IO;
+        iov->iov_base = (char *)iov->iov_base + rem;
+        iov->iov_len -= rem;
+    }
+
+    return USTREAM_OK;
+}
+
+static ustream_ret ustream_file_writev(void *file, UIOVec const *bufs, size_t count,
+                                       size_t *written) {
+    *written = 0;
+
+    // Data buffered by the FILE object must precede the vectored write.
+    if (fflush(file)) return USTREAM_ERR_IO;
+    int const fd = fileno(file);
+    struct iovec iov[P_USTREAM_IOV_MAX];
+
+    while (count) {
+        int const batch = (int)ulib_min(count, P_USTREAM_IOV_MAX);
+
+        for (int i = 0; i < batch; ++i) {
+            iov[i].iov_base = (void *)bufs[i].base;
+            iov[i].iov_len = bufs[i].size;
+        }
+
+        ustream_ret ret = p_ustream_fd_writev(fd, iov, batch, written);
+        if (ret) return ret;
+        bufs += batch;
+        count -= (size_t)batch;
+    }
+
+    return USTREAM_OK;
+}
+
+#endif
+
 static ustream_ret ustream_file_reset(void *file) {
     return fseek(file, 0, SEEK_SET) == 0 ? USTREAM_OK : USTREAM_ERR_IO;
 }
@@ -157,6 +222,23 @@ ustream_strbuf_writef(void *ctx, size_t *written, char const *format, va_list ar
     return ret == UVEC_OK ? USTREAM_OK : USTREAM_ERR_MEM;
 }
 
+static ustream_ret
+ustream_strbuf_writev(void *ctx, UIOVec const *bufs, size_t count, size_t *written) {
+    ulib_uint const start_count = uvec_count(char, ctx);
+    size_t total = start_count;
+    for (size_t i = 0; i < count; ++i) total += bufs[i].size;
+
+    // Grow the buffer once.
+    uvec_ret ret = total > ULIB_UINT_MAX ? UVEC_ERR : uvec_reserve(char, ctx, (ulib_uint)total + 1);
+
+    for (size_t i = 0; i < count && ret == UVEC_OK; ++i) {
+        ret = ustrbuf_append_string(ctx, bufs[i].base, (ulib_uint)bufs[i].size);
+    }
+
+    *written = uvec_count(char, ctx) - start_count;
+    return ret == UVEC_OK ? USTREAM_OK : USTREAM_ERR_MEM;
+}
+
 static ustream_ret ustream_strbuf_reset(void *ctx) {
     uvec_clear(char, ctx);
     return USTREAM_OK;
@@ -174,6 +256,13 @@ static ustream_ret ustream_null_write(ulib_unused void *ctx, ulib_unused void co
     return USTREAM_OK;
 }
 
+static ustream_ret ustream_null_writev(ulib_unused void *ctx, UIOVec const *bufs, size_t count,
+                                       size_t *written) {
+    *written = 0;
+    for (size_t i = 0; i < count; ++i) *written += bufs[i].size;
+    return USTREAM_OK;
+}
+
 static ustream_ret
 ustream_null_writef(ulib_unused void *ctx, size_t *written, char const *format, va_list args) {
     *written = ulib_str_flength_list(format, args);
@@ -212,6 +301,21 @@ ustream_multi_writef(void *ctx, size_t *written, char const *format, va_list arg
     return ret;
 }
 
+static ustream_ret
+ustream_multi_writev(void *ctx, UIOVec const *bufs, size_t count, size_t *written) {
+    ustream_ret ret = USTREAM_OK;
+    *written = 0;
+
+    uvec_foreach (ulib_ptr, ctx, stream) {
+        size_t lwritten;
+        ustream_ret lret = uostream_writev(*stream.item, bufs, count, &lwritten);
+        if (*written < lwritten) *written = lwritten;
+        if (!ret) ret = lret;
+    }
+
+    return ret;
+}
+
 static ustream_ret ustream_multi_flush(void *ctx) {
     ustream_ret ret = USTREAM_OK;
 
@@ -349,6 +453,37 @@ end:
     return ret;
 }
 
+static ustream_ret
+uostream_buffered_writev(void *ctx, UIOVec const *bufs, size_t count, size_t *written) {
+    UOStreamBuffered *bs = ctx;
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += bufs[i].size;
+
+    if ((size_t)(bs->cur - bs->buf) + total < bs->size || !bs->raw_stream.writev) {
+        // Coalesce the buffers, unless the raw stream supports vectored writes.
+        ustream_ret ret = USTREAM_OK;
+        *written = 0;
+
+        for (size_t i = 0; i < count && !ret; ++i) {
+            size_t lwritten;
+            ret = uostream_buffered_write(ctx, bufs[i].base, bufs[i].size, &lwritten);
+            *written += lwritten;
+        }
+
+        return ret;
+    }
+
+    ustream_ret ret = uostream_buffered_flush_impl(ctx);
+
+    if (bs->cur != bs->buf) {
+        // Stream not fully flushed, don't write any data.
+        *written = 0;
+        return ret;
+    }
+
+    return uostream_writev(&bs->raw_stream, bufs, count, written);
+}
+
 static ustream_ret uostream_buffered_flush(void *ctx) {
     ustream_ret write_ret = uostream_buffered_flush_impl(ctx);
     ustream_ret flush_ret = uostream_flush(&((UOStreamBuffered *)ctx)->raw_stream);
@@ -497,6 +632,7 @@ UOStream *uostream_null(void) {
     static UOStream stream = {
         .write = ustream_null_write,
         .writef = ustream_null_writef,
+        .writev = ustream_null_writev,
     };
     return &stream;
 }
@@ -529,6 +665,26 @@ ustream_ret uostream_write(UOStream *stream, void const *buf, size_t count, size
     return stream->state;
 }
 
+ustream_ret uostream_writev(UOStream *stream, UIOVec const *bufs, size_t count, size_t *written) {
+    size_t written_bytes = 0;
+
+    if (!stream->state) {
+        if (stream->writev) {
+            stream->state = stream->writev(stream->ctx, bufs, count, &written_bytes);
+        } else {
+            for (size_t i = 0; i < count && !stream->state; ++i) {
+                size_t lwritten = 0;
+                stream->state = stream->write(stream->ctx, bufs[i].base, bufs[i].size, &lwritten);
+                written_bytes += lwritten;
+            }
+        }
+        stream->written_bytes += written_bytes;
+    }
+
+    if (written) *written = written_bytes;
+    return stream->state;
+}
+
 ustream_ret uostream_writef(UOStream *stream, size_t *written, char const *format, ...) {
     va_list args;
     va_start(args, format);
@@ -537,9 +693,20 @@ ustream_ret uostream_writef(UOStream *stream, size_t *written, char const *forma
     return ret;
 }
 
+// Size of the stack buffer used to format strings for streams that do not support writef.
+#define P_USTREAM_WRITEF_BUF_SIZE 256
+
 static ustream_ret
 uostream_writef_list_fallback(UOStream *stream, size_t *written, char const *format, va_list args) {
-    size_t len = ulib_str_flength_list(format, args);
+    char sbuf[P_USTREAM_WRITEF_BUF_SIZE];
+    va_list cargs;
+    va_copy(cargs, args);
+    int const res = vsnprintf(sbuf, sizeof(sbuf), format, cargs);
+    va_end(cargs);
+
+    size_t const len = res > 0 ? (size_t)res : 0;
+    if (len < sizeof(sbuf)) return uostream_write(stream, sbuf, len, written);
+
     size_t size = len + 1;
     char *buf = ulib_malloc(size);
 
@@ -580,6 +747,21 @@ ustream_ret uostream_write_string(UOStream *stream, UString const *string, size_
     return uostream_write(stream, ustring_data(*string), ustring_length(*string), written);
 }
 
+ustream_ret uostream_write_int(UOStream *stream, ulib_int value, size_t *written) {
+    char buf[ULIB_NUM_STR_SIZE];
+    return uostream_write(stream, buf, ulib_str_from_int(buf, value), written);
+}
+
+ustream_ret uostream_write_uint(UOStream *stream, ulib_uint value, size_t *written) {
+    char buf[ULIB_NUM_STR_SIZE];
+    return uostream_write(stream, buf, ulib_str_from_uint(buf, value), written);
+}
+
+ustream_ret uostream_write_float(UOStream *stream, ulib_float value, size_t *written) {
+    char buf[ULIB_NUM_STR_SIZE];
+    return uostream_write(stream, buf, ulib_str_from_float(buf, value), written);
+}
+
 ustream_ret uostream_write_time(UOStream *stream, UTime const *time, size_t *written) {
     return uostream_writef(stream, written, UTIME_FMT, utime_fmt_args(*time));
 }
@@ -622,6 +804,9 @@ ustream_ret uostream_to_file(UOStream *stream, FILE *file) {
         stream->writef = ustream_file_writef;
         stream->flush = ustream_file_flush;
         stream->reset = ustream_file_reset;
+#ifdef P_USTREAM_WRITEV
+        stream->writev = ustream_file_writev;
+#endif
     }
 
     return stream->state;
@@ -660,6 +845,7 @@ ustream_ret uostream_to_strbuf(UOStream *stream, UStrBuf *buf) {
         stream->ctx = buf;
         stream->write = ustream_strbuf_write;
         stream->writef = ustream_strbuf_writef;
+        stream->writev = ustream_strbuf_writev;
         stream->reset = ustream_strbuf_reset;
     }
 
@@ -676,6 +862,7 @@ ustream_ret uostream_to_multi(UOStream *stream) {
             .ctx = vec,
             .write = ustream_multi_write,
             .writef = ustream_multi_writef,
+            .writev = ustream_multi_writev,
             .flush = ustream_multi_flush,
             .reset = ustream_multi_reset,
             .free = ustream_multi_free,
@@ -707,6 +894,7 @@ ustream_ret uostream_buffered(UOStream *stream, UOStream **raw_stream, size_t bu
         bs->size = buffer_size;
         stream->ctx = bs;
         stream->write = uostream_buffered_write;
+        stream->writev = uostream_buffered_writev;
         stream->flush = uostream_buffered_flush;
         stream->reset = uostream_buffered_reset;
         stream->free = uostream_buffered_free;
@@ -16,8 +16,43 @@
 #include "uwarning.h"
 #include <limits.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <string.h>
 
+// clang-format off
+
+#if defined(ULIB_NO_THREADS) || defined(__STDC_NO_ATOMICS__)
+    typedef size_t p_ustring_refcount;
+    #define p_ustring_refs_init(c, v) (*(c) = (v))
+    #define p_ustring_refs_get(c) (*(c))
+    #define p_ustring_refs_retain(c) ((*(c))++)
+    #define p_ustring_refs_release(c) ((*(c))--)
+#else
+    #include <stdatomic.h>
+    typedef atomic_size_t p_ustring_refcount;
+    #define p_ustring_refs_init(c, v) atomic_init(c, v)
+    #define p_ustring_refs_get(c) atomic_load_explicit(c, memory_order_acquire)
+    #define p_ustring_refs_retain(c) atomic_fetch_add_explicit(c, 1, memory_order_relaxed)
+    #define p_ustring_refs_release(c) atomic_fetch_sub_explicit(c, 1, memory_order_acq_rel)
+#endif
+
+// clang-format on
+
+// Header of shared strings. It follows the buffer rather than preceding it, so that the buffer
+// starts the allocation, and it can be handed over by ustring_deinit_return_data.
+typedef struct p_ustring_header {
+    p_ustring_refcount refs;
+} p_ustring_header;
+
+// Offset of the header from the start of the buffer, given the size of the string.
+#define p_ustring_header_offset(size)                                                              \
+    (((size_t)(size) + sizeof(p_ustring_header) - 1) / sizeof(p_ustring_header) *                  \
+     sizeof(p_ustring_header))
+
+#define p_ustring_header(str)                                                                      \
+    ((p_ustring_header *)(void *)((char *)(str)._l._data +                                         \
+                                  p_ustring_header_offset(ustring_size(str))))
+
 UString const ustring_null = ustring_init_null;
 UString const ustring_empty = ustring_init_empty;
 
@@ -30,6 +65,7 @@ UString ustring_small(char const *buf, size_t length) {
 
 ULIB_INLINE
 UString ustring_large(char const *buf, size_t length) {
+    ulib_assert(p_ustring_length_is_valid(length));
     ulib_uint size = ((ulib_uint)length + 1) | ~((ulib_uint)-1 >> 1U);
     UString ret = { ._l = { ._data = buf, ._flags = { 0 } } };
     unsigned const offset = P_USTRING_FLAGS_SIZE - sizeof(ulib_uint);
@@ -41,11 +77,27 @@ UString ustring_large(char const *buf, size_t length) {
     return ret;
 }
 
+ULIB_INLINE
+UString ustring_shared(char const *buf, size_t length) {
+    UString ret = ustring_large(buf, length);
+    ret._l._flags[P_USTRING_SHARED_BYTE] |= P_USTRING_FLAG_SHARED;
+    return ret;
+}
+
+// Releases a reference to a shared string, returning true if it was the last one.
+ULIB_INLINE
+bool ustring_release(UString string) {
+    p_ustring_header *header = p_ustring_header(string);
+    if (p_ustring_refs_release(&header->refs) != 1) return false;
+    ulib_free((void *)string._l._data);
+    return true;
+}
+
 UString ustring_assign(char const *buf, size_t length) {
     bool should_free = true;
     UString ret = ustring_null;
 
-    if (!buf) goto end;
+    if (!buf || !p_ustring_length_is_valid(length)) goto end;
 
     if (p_ustring_length_is_small(length)) {
         ret = ustring_small(buf, length);
@@ -63,11 +115,15 @@ end:
 UString ustring_copy(char const *buf, size_t length) {
     if (!buf) return ustring_null;
     if (p_ustring_length_is_small(length)) return ustring_small(buf, length);
-    return ustring_large(ulib_str_dup(buf, length), length);
+
+    UString ret;
+    char *data = ustring(&ret, length);
+    if (data) memcpy(data, buf, length);
+    return ret;
 }
 
 UString ustring_wrap(char const *buf, size_t length) {
-    if (!buf) return ustring_null;
+    if (!buf || !p_ustring_length_is_valid(length)) return ustring_null;
     if (p_ustring_length_is_small(length)) return ustring_small(buf, length);
     return ustring_large(buf, length);
 }
@@ -78,11 +134,18 @@ char *ustring(UString *string, size_t length) {
     if (p_ustring_length_is_small(length)) {
         *string = (UString)p_ustring_init_small((ulib_uint)length + 1);
         buf = (char *)string->_s;
+    } else if (!p_ustring_length_is_valid(length)) {
+        *string = ustring_null;
+        buf = NULL;
     } else {
-        buf = ulib_malloc(length + 1);
+        // The length check prevents overflows if size_t is narrower than ulib_uint.
+        size_t const offset = p_ustring_header_offset(length + 1);
+        bool const fits = length <= SIZE_MAX - 2 * sizeof(p_ustring_header);
+        buf = fits ? (char *)ulib_malloc(offset + sizeof(p_ustring_header)) : NULL;
         if (buf) {
+            p_ustring_refs_init(&((p_ustring_header *)(void *)(buf + offset))->refs, 1);
             ULIB_SUPPRESS_ONE(GCC, "-Wmaybe-uninitialized")
-            *string = ustring_large(buf, length);
+            *string = ustring_shared(buf, length);
             ulib_assert(string->_l._data == buf);
             ULIB_SUPPRESS_END(GCC)
         } else {
@@ -95,16 +158,36 @@ char *ustring(UString *string, size_t length) {
 }
 
 void ustring_deinit(UString *string) {
-    if (!p_ustring_is_large(*string)) return;
-    ulib_free((void *)string->_l._data);
-    string->_l._data = NULL;
+    if (!(p_ustring_is_large(*string) && string->_l._data)) return;
+
+    if (p_ustring_is_shared(*string)) {
+        ustring_release(*string);
+    } else {
+        ulib_free((void *)string->_l._data);
+    }
+
+    // Clear the flags as well, so that deinitialized strings are never treated as shared.
+    *string = ustring_null;
 }
 
 char *ustring_deinit_return_data(UString *string) {
     char *ret;
     ulib_byte byte = p_ustring_last_byte(*string);
 
-    if (p_ustring_last_byte_is_large(byte)) {
+    if (p_ustring_is_shared(*string)) {
+        // The buffer starts the allocation, so it can be handed over if this is the only
+        // reference, otherwise it must be copied.
+        if (p_ustring_refs_get(&p_ustring_header(*string)->refs) == 1) {
+            ret = (char *)string->_l._data;
+        } else {
+            ulib_uint const size = ustring_size(*string);
+            ret = ulib_malloc(size);
+            if (ret) memcpy(ret, string->_l._data, size);
+            ustring_release(*string);
+        }
+
+        *string = ustring_null;
+    } else if (p_ustring_last_byte_is_large(byte)) {
         ret = (char *)string->_l._data;
         string->_l._data = NULL;
     } else {
@@ -117,6 +200,10 @@ char *ustring_deinit_return_data(UString *string) {
 }
 
 UString ustring_dup(UString string) {
+    if (p_ustring_is_shared(string)) {
+        p_ustring_refs_retain(&p_ustring_header(string)->refs);
+        return string;
+    }
     return ustring_copy(ustring_data(string), ustring_length(string));
 }
 
@@ -168,17 +255,20 @@ bool ustring_ends_with(UString string, UString suffix) {
 bool ustring_equals(UString lhs, UString rhs) {
     ulib_byte lb = p_ustring_last_byte(lhs);
     ulib_byte rb = p_ustring_last_byte(rhs);
-    if (lb != rb) return false;
 
     if (p_ustring_last_byte_is_small(lb)) {
+        if (lb != rb) return false;
         ulib_uint size = p_ustring_last_byte_size(lb);
         return size ? (*lhs._s == *rhs._s && memcmp(lhs._s, rhs._s, size - 1) == 0) : true;
     }
 
+    // The last byte of large strings may also hold the shared flag, so only compare sizes.
+    if (p_ustring_last_byte_is_small(rb)) return false;
     ulib_uint lsize = p_ustring_large_size(lhs._l);
     ulib_uint rsize = p_ustring_large_size(rhs._l);
-    return lsize == rsize && *lhs._l._data == *rhs._l._data &&
-           memcmp(lhs._l._data, rhs._l._data, lsize - 1) == 0;
+    if (lsize != rsize) return false;
+    if (lhs._l._data == rhs._l._data) return true;
+    return *lhs._l._data == *rhs._l._data && memcmp(lhs._l._data, rhs._l._data, lsize - 1) == 0;
 }
 
 bool ustring_precedes(UString lhs, UString rhs) {
@@ -201,11 +291,20 @@ int ustring_compare(UString lhs, UString rhs) {
     return res == 0 ? (l_len > r_len) - (l_len < r_len) : res;
 }
 
+bool ustring_equals_ignore_case(UString lhs, UString rhs) {
+    ulib_uint const length = ustring_length(lhs);
+    if (length != ustring_length(rhs)) return false;
+    return ulib_str_equals_ignore_case(ustring_data(lhs), ustring_data(rhs), length);
+}
+
+// Long strings are hashed by sampling three parts of this size.
+#define P_USTRING_HASH_PART_SIZE 32
+
 ulib_uint ustring_hash(UString string) {
     ulib_uint const length = ustring_length(string);
     char const *buf = ustring_data(string);
 
-    ulib_uint const part_size = 32;
+    ulib_uint const part_size = P_USTRING_HASH_PART_SIZE;
     ulib_uint hash = length;
 
     if (length <= (part_size * 3)) {
@@ -219,6 +318,31 @@ ulib_uint ustring_hash(UString string) {
     return hash;
 }
 
+ulib_uint ustring_hash_ignore_case(UString string) {
+    // Lowercases the hashed parts only, so that the result matches ustring_hash
+    // of the lowercased string.
+    ulib_uint const length = ustring_length(string);
+    char const *src = ustring_data(string);
+
+    ulib_uint const part_size = P_USTRING_HASH_PART_SIZE;
+    char buf[P_USTRING_HASH_PART_SIZE * 3];
+    ulib_uint hash = length;
+
+    if (length <= (part_size * 3)) {
+        ulib_str_to_lower(buf, src, length);
+        hash = ustring_hash_func(hash, buf, length);
+    } else {
+        ulib_str_to_lower(buf, src, part_size);
+        ulib_str_to_lower(buf + part_size, src + ((length + part_size) >> 1U), part_size);
+        ulib_str_to_lower(buf + part_size * 2, src + length - part_size, part_size);
+        hash = ustring_hash_func(hash, buf, part_size);
+        hash = ustring_hash_func(hash, buf + part_size, part_size);
+        hash = ustring_hash_func(hash, buf + part_size * 2, part_size);
+    }
+
+    return hash;
+}
+
 ulib_ret ustring_to_int(UString string, ulib_int *out, unsigned base) {
     char *end;
     char const *start = ustring_data(string);
@@ -334,3 +458,71 @@ UString ustring_to_lower(UString string) {
     ulib_str_to_lower(buf, ustring_data(string), len);
     return ret;
 }
+
+uint16_t *ustring_to_utf16(UString string, size_t *length) {
+    ulib_uint const len = ustring_length(string);
+    uint16_t *buf = ulib_alloc_array(buf, len + 1);
+    size_t written;
+
+    if (!buf) return NULL;
+
+    if (ulib_str_utf8_to_utf16(ustring_data(string), len, buf, &written)) {
+        ulib_free(buf);
+        return NULL;
+    }
+
+    buf[written] = 0;
+    if (length) *length = written;
+    return buf;
+}
+
+UString ustring_from_utf16(uint16_t const *src, size_t length) {
+    size_t const len = ulib_str_utf8_length_from_utf16(src, length);
+    UString ret;
+    char *buf = ustring(&ret, len);
+    if (!buf) return ustring_null;
+
+    if (ulib_str_utf16_to_utf8(src, length, buf, NULL)) {
+        ustring_deinit(&ret);
+        return ustring_null;
+    }
+
+    return ret;
+}
+
+bool ustrsplit_next(UStrSplit *split, UString *token) {
+    if (split->_done) return false;
+
+    ulib_uint const length = ustring_length(split->_string);
+    char const *start = ustring_data(split->_string) + split->_pos;
+    size_t const remaining = length - split->_pos;
+    char const *sep = ustring_data(split->_sep);
+    size_t sep_len = 1;
+    char const *found;
+
+    if (split->_mode == P_USTRSPLIT_STRING) {
+        sep_len = ustring_length(split->_sep);
+        found = (char const *)ulib_mem_mem(start, remaining, sep, sep_len);
+    } else if (split->_mode == P_USTRSPLIT_ANY) {
+        found = (char const *)ulib_mem_chr_any(start, remaining, sep, ustring_length(split->_sep));
+    } else {
+        found = (char const *)memchr(start, '\n', remaining);
+    }
+
+    size_t token_len = remaining;
+
+    if (found) {
+        token_len = (size_t)(found - start);
+        split->_pos = (ulib_uint)(split->_pos + token_len + sep_len);
+    } else {
+        split->_done = true;
+    }
+
+    if (split->_mode == P_USTRSPLIT_LINES) {
+        if (token_len && start[token_len - 1] == '\r') --token_len;
+        if (split->_pos == length) split->_done = true;
+    }
+
+    *token = ustring_wrap(start, token_len);
+    return true;
+}
@@ -7,7 +7,12 @@
 
 #include "ustring_raw.h"
 #include "ualloc.h"
+#include "ubit.h"
+#include "unumber.h"
+#include <limits.h>
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -38,25 +43,398 @@ size_t ulib_str_flength_list(char const *format, va_list args) {
     return res > 0 ? (size_t)res : 0;
 }
 
+// Byte-parallel primitives used by the search and case conversion functions, which process
+// P_ULIB_MEM_WIDTH bytes at a time:
+// - p_ulib_mem_eq compares bytes against a broadcast byte, returning a bitmask that has one set
+//   bit for every matching byte. The bit for byte i is bit (i * P_ULIB_MEM_STRIDE + k) for some
+//   k < P_ULIB_MEM_STRIDE, so dividing bit indices by the stride yields byte offsets.
+// - p_ulib_mem_case_bits returns 0x20 for every byte in the [lo, lo + 26) range, 0 otherwise,
+//   which flips the case of letters when xor'ed with the original bytes.
+
+#if !defined(ULIB_NO_SIMD) && defined(__AVX2__)
+
+#include <immintrin.h>
+
+#define P_ULIB_MEM_WIDTH 32
+#define P_ULIB_MEM_STRIDE 1
+typedef __m256i p_ulib_mem_vec;
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_splat(unsigned char c) {
+    return _mm256_set1_epi8((char)c);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_load(unsigned char const *p) {
+    return _mm256_loadu_si256((__m256i const *)p);
+}
+
+ULIB_INLINE
+void p_ulib_mem_store(unsigned char *p, p_ulib_mem_vec v) {
+    _mm256_storeu_si256((__m256i *)p, v);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_xor(p_ulib_mem_vec a, p_ulib_mem_vec b) {
+    return _mm256_xor_si256(a, b);
+}
+
+ULIB_INLINE
+bool p_ulib_mem_is_zero(p_ulib_mem_vec v) {
+    return _mm256_testz_si256(v, v);
+}
+
+ULIB_INLINE
+uint64_t p_ulib_mem_eq(unsigned char const *p, p_ulib_mem_vec v) {
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(p_ulib_mem_load(p), v));
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_case_bits(p_ulib_mem_vec x, unsigned char lo) {
+    // Moves the range to the bottom of the signed byte range, then compares once.
+    __m256i const t = _mm256_add_epi8(x, p_ulib_mem_splat((unsigned char)(0x80 - lo)));
+    __m256i const in = _mm256_cmpgt_epi8(p_ulib_mem_splat(0x80 + 26), t);
+    return _mm256_and_si256(in, p_ulib_mem_splat(0x20));
+}
+
+#elif !defined(ULIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+
+#include <emmintrin.h>
+
+#define P_ULIB_MEM_WIDTH 16
+#define P_ULIB_MEM_STRIDE 1
+typedef __m128i p_ulib_mem_vec;
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_splat(unsigned char c) {
+    return _mm_set1_epi8((char)c);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_load(unsigned char const *p) {
+    return _mm_loadu_si128((__m128i const *)p);
+}
+
+ULIB_INLINE
+void p_ulib_mem_store(unsigned char *p, p_ulib_mem_vec v) {
+    _mm_storeu_si128((__m128i *)p, v);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_xor(p_ulib_mem_vec a, p_ulib_mem_vec b) {
+    return _mm_xor_si128(a, b);
+}
+
+ULIB_INLINE
+bool p_ulib_mem_is_zero(p_ulib_mem_vec v) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF;
+}
+
+ULIB_INLINE
+uint64_t p_ulib_mem_eq(unsigned char const *p, p_ulib_mem_vec v) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(p_ulib_mem_load(p), v));
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_case_bits(p_ulib_mem_vec x, unsigned char lo) {
+    // Moves the range to the bottom of the signed byte range, then compares once.
+    __m128i const t = _mm_add_epi8(x, p_ulib_mem_splat((unsigned char)(0x80 - lo)));
+    __m128i const in = _mm_cmpgt_epi8(p_ulib_mem_splat(0x80 + 26), t);
+    return _mm_and_si128(in, p_ulib_mem_splat(0x20));
+}
+
+#elif !defined(ULIB_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>
+
+#define P_ULIB_MEM_WIDTH 16
+#define P_ULIB_MEM_STRIDE 4
+typedef uint8x16_t p_ulib_mem_vec;
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_splat(unsigned char c) {
+    return vdupq_n_u8(c);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_load(unsigned char const *p) {
+    return vld1q_u8(p);
+}
+
+ULIB_INLINE
+void p_ulib_mem_store(unsigned char *p, p_ulib_mem_vec v) {
+    vst1q_u8(p, v);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_xor(p_ulib_mem_vec a, p_ulib_mem_vec b) {
+    return veorq_u8(a, b);
+}
+
+ULIB_INLINE
+bool p_ulib_mem_is_zero(p_ulib_mem_vec v) {
+    return vmaxvq_u8(v) == 0;
+}
+
+ULIB_INLINE
+uint64_t p_ulib_mem_eq(unsigned char const *p, p_ulib_mem_vec v) {
+    // Narrowing shift: each byte of the comparison result becomes a nibble of the mask.
+    uint8x16_t const eq = vceqq_u8(p_ulib_mem_load(p), v);
+    uint8x8_t const mask = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(mask), 0) & 0x8888888888888888ULL;
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_case_bits(p_ulib_mem_vec x, unsigned char lo) {
+    uint8x16_t const in = vcltq_u8(vsubq_u8(x, vdupq_n_u8(lo)), vdupq_n_u8(26));
+    return vandq_u8(in, vdupq_n_u8(0x20));
+}
+
+#else
+
+// SWAR fallback: processes the bytes of a 64-bit word at once.
+#define P_ULIB_MEM_WIDTH 8
+#define P_ULIB_MEM_STRIDE 8
+typedef uint64_t p_ulib_mem_vec;
+
+#define P_ULIB_MEM_LOW 0x7F7F7F7F7F7F7F7FULL
+#define P_ULIB_MEM_HIGH 0x8080808080808080ULL
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_splat(unsigned char c) {
+    return 0x0101010101010101ULL * c;
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_load(unsigned char const *p) {
+    // Compilers turn this into a single load on little-endian targets.
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+           (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 |
+           (uint64_t)p[7] << 56;
+}
+
+ULIB_INLINE
+void p_ulib_mem_store(unsigned char *p, p_ulib_mem_vec v) {
+    for (unsigned i = 0; i < 8; ++i, v >>= 8) p[i] = (unsigned char)v;
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_xor(p_ulib_mem_vec a, p_ulib_mem_vec b) {
+    return a ^ b;
+}
+
+ULIB_INLINE
+bool p_ulib_mem_is_zero(p_ulib_mem_vec v) {
+    return v == 0;
+}
+
+ULIB_INLINE
+uint64_t p_ulib_mem_eq(unsigned char const *p, p_ulib_mem_vec v) {
+    uint64_t const x = p_ulib_mem_load(p) ^ v;
+    // Exact zero byte detection, unlike the usual (x - 0x01..) & ~x trick it has no false
+    // positives, which matters when scanning backwards.
+    return ~(((x & P_ULIB_MEM_LOW) + P_ULIB_MEM_LOW) | x | P_ULIB_MEM_LOW);
+}
+
+ULIB_INLINE
+p_ulib_mem_vec p_ulib_mem_case_bits(p_ulib_mem_vec x, unsigned char lo) {
+    // Per-byte comparisons on the low 7 bits cannot carry into the next byte.
+    uint64_t const h = x & P_ULIB_MEM_LOW;
+    uint64_t const ge_lo = h + p_ulib_mem_splat((unsigned char)(0x80 - lo));
+    uint64_t const ge_hi = h + p_ulib_mem_splat((unsigned char)(0x80 - lo - 26));
+    return (ge_lo & ~ge_hi & ~x & P_ULIB_MEM_HIGH) >> 2;
+}
+
+#endif
+
+#define p_ulib_mem_last_bit(mask) ulib_uint64_log2(mask)
+#define p_ulib_mem_first_bit(mask) ubit_first_set(64, mask)
+
+// Needles at least this long are searched via the Boyer-Moore-Horspool algorithm.
+#define P_ULIB_MEM_HORSPOOL_MIN_LEN 64
+
+// Byte sets at most this large are searched via vector comparisons, larger ones via a bitmap.
+#define P_ULIB_MEM_ANY_MAX_SIMD 4
+
+ULIB_INLINE
+void p_ulib_str_flip_case(char *dst, char const *src, size_t length, unsigned char lo) {
+    unsigned char *d = (unsigned char *)dst;
+    unsigned char const *s = (unsigned char const *)src;
+    size_t i = 0;
+
+    for (; i + P_ULIB_MEM_WIDTH <= length; i += P_ULIB_MEM_WIDTH) {
+        p_ulib_mem_vec const x = p_ulib_mem_load(s + i);
+        p_ulib_mem_store(d + i, p_ulib_mem_xor(x, p_ulib_mem_case_bits(x, lo)));
+    }
+
+    for (; i < length; ++i) d[i] = (unsigned char)(s[i] ^ ((ulib_byte)(s[i] - lo) < 26U) << 5U);
+}
+
+ULIB_INLINE
+bool p_ulib_str_has_case(char const *string, size_t length, unsigned char lo) {
+    unsigned char const *s = (unsigned char const *)string;
+    size_t i = 0;
+
+    for (; i + P_ULIB_MEM_WIDTH <= length; i += P_ULIB_MEM_WIDTH) {
+        if (!p_ulib_mem_is_zero(p_ulib_mem_case_bits(p_ulib_mem_load(s + i), lo))) return true;
+    }
+
+    for (; i < length; ++i) {
+        if ((ulib_byte)(s[i] - lo) < 26U) return true;
+    }
+
+    return false;
+}
+
+bool ulib_str_is_upper(char const *string, size_t length) {
+    return !p_ulib_str_has_case(string, length, 'a');
+}
+
+bool ulib_str_is_lower(char const *string, size_t length) {
+    return !p_ulib_str_has_case(string, length, 'A');
+}
+
+void ulib_str_to_upper(char *dst, char const *src, size_t length) {
+    p_ulib_str_flip_case(dst, src, length, 'a');
+}
+
+void ulib_str_to_lower(char *dst, char const *src, size_t length) {
+    p_ulib_str_flip_case(dst, src, length, 'A');
+}
+
+bool ulib_str_equals_ignore_case(char const *lhs, char const *rhs, size_t length) {
+    unsigned char const *l = (unsigned char const *)lhs;
+    unsigned char const *r = (unsigned char const *)rhs;
+    size_t i = 0;
+
+    for (; i + P_ULIB_MEM_WIDTH <= length; i += P_ULIB_MEM_WIDTH) {
+        p_ulib_mem_vec lv = p_ulib_mem_load(l + i), rv = p_ulib_mem_load(r + i);
+        lv = p_ulib_mem_xor(lv, p_ulib_mem_case_bits(lv, 'A'));
+        rv = p_ulib_mem_xor(rv, p_ulib_mem_case_bits(rv, 'A'));
+        if (!p_ulib_mem_is_zero(p_ulib_mem_xor(lv, rv))) return false;
+    }
+
+    for (; i < length; ++i) {
+        if (ulib_char_to_lower((char)l[i]) != ulib_char_to_lower((char)r[i])) return false;
+    }
+
+    return true;
+}
+
+static void *p_ulib_mem_mem_horspool(unsigned char const *h, size_t h_len, unsigned char const *n,
+                                     size_t n_len) {
+    size_t skip[UCHAR_MAX + 1];
+    for (size_t i = 0; i <= UCHAR_MAX; ++i) skip[i] = n_len;
+    for (size_t i = 0; i < n_len - 1; ++i) skip[n[i]] = n_len - 1 - i;
+
+    unsigned char const last = n[n_len - 1];
+
+    for (size_t i = 0, end = h_len - n_len; i <= end; i += skip[h[i + n_len - 1]]) {
+        if (h[i + n_len - 1] == last && memcmp(h + i, n, n_len - 1) == 0) return (void *)(h + i);
+    }
+
+    return NULL;
+}
+
+static void *p_ulib_mem_mem_last_horspool(unsigned char const *h, size_t h_len,
+                                          unsigned char const *n, size_t n_len) {
+    // Mirrored Horspool: windows are aligned on their first byte and move backwards.
+    size_t skip[UCHAR_MAX + 1];
+    for (size_t i = 0; i <= UCHAR_MAX; ++i) skip[i] = n_len;
+    for (size_t i = n_len - 1; i > 0; --i) skip[n[i]] = i;
+
+    unsigned char const first = n[0];
+
+    for (size_t i = h_len - n_len;;) {
+        if (h[i] == first && memcmp(h + i + 1, n + 1, n_len - 1) == 0) return (void *)(h + i);
+        size_t const s = skip[h[i]];
+        if (i < s) break;
+        i -= s;
+    }
+
+    return NULL;
+}
+
 void *ulib_mem_chr_last(void const *haystack, int c, size_t h_len) {
-    if (h_len == 0) return NULL;
-    for (char const *h = (char const *)haystack + h_len; h-- != haystack;) {
-        if (*h == c) return (void *)h;
+    unsigned char const *h = (unsigned char const *)haystack;
+    unsigned char const ch = (unsigned char)c;
+    p_ulib_mem_vec const v = p_ulib_mem_splat(ch);
+    size_t i = h_len;
+
+    for (; i >= P_ULIB_MEM_WIDTH; i -= P_ULIB_MEM_WIDTH) {
+        uint64_t const mask = p_ulib_mem_eq(h + i - P_ULIB_MEM_WIDTH, v);
+        if (mask) {
+            size_t const idx = p_ulib_mem_last_bit(mask) / P_ULIB_MEM_STRIDE;
+            return (void *)(h + i - P_ULIB_MEM_WIDTH + idx);
+        }
+    }
+
+    while (i--) {
+        if (h[i] == ch) return (void *)(h + i);
+    }
+
+    return NULL;
+}
+
+void *ulib_mem_chr_any(void const *haystack, size_t h_len, void const *set, size_t set_len) {
+    if (set_len <= 1) return set_len ? memchr(haystack, *(char const *)set, h_len) : NULL;
+
+    unsigned char const *h = (unsigned char const *)haystack;
+    unsigned char const *s = (unsigned char const *)set;
+    size_t i = 0;
+
+    if (set_len <= P_ULIB_MEM_ANY_MAX_SIMD) {
+        // Small sets, such as CSV delimiters, are matched via one comparison per byte.
+        p_ulib_mem_vec v[P_ULIB_MEM_ANY_MAX_SIMD];
+        for (size_t j = 0; j < set_len; ++j) v[j] = p_ulib_mem_splat(s[j]);
+
+        for (; i + P_ULIB_MEM_WIDTH <= h_len; i += P_ULIB_MEM_WIDTH) {
+            uint64_t mask = 0;
+            for (size_t j = 0; j < set_len; ++j) mask |= p_ulib_mem_eq(h + i, v[j]);
+            if (mask) return (void *)(h + i + p_ulib_mem_first_bit(mask) / P_ULIB_MEM_STRIDE);
+        }
+    }
+
+    ulib_byte table[(UCHAR_MAX + 1) / CHAR_BIT] = { 0 };
+    for (size_t j = 0; j < set_len; ++j) {
+        table[s[j] / CHAR_BIT] |= (ulib_byte)(1U << s[j] % CHAR_BIT);
+    }
+
+    for (; i < h_len; ++i) {
+        if (table[h[i] / CHAR_BIT] & (1U << h[i] % CHAR_BIT)) return (void *)(h + i);
     }
+
     return NULL;
 }
 
 void *ulib_mem_mem(void const *haystack, size_t h_len, void const *needle, size_t n_len) {
     if (n_len == 0 || h_len < n_len) return NULL;
-    if (n_len == 1) return memchr(haystack, ((char *)needle)[0], h_len);
+    if (n_len == 1) return memchr(haystack, ((unsigned char const *)needle)[0], h_len);
+
+    unsigned char const *h = (unsigned char const *)haystack;
+    unsigned char const *n = (unsigned char const *)needle;
+    if (n_len >= P_ULIB_MEM_HORSPOOL_MIN_LEN) return p_ulib_mem_mem_horspool(h, h_len, n, n_len);
 
-    char n_first = ((char *)needle)[0];
-    needle = (char const *)needle + 1;
-    n_len--;
-    char const *last_h = (char const *)haystack + h_len - n_len;
+    // Candidate positions must match both the first and the last byte of the needle,
+    // which filters out most false positives before comparing the middle bytes.
+    unsigned char const first = n[0], last = n[n_len - 1];
+    p_ulib_mem_vec const v_first = p_ulib_mem_splat(first);
+    p_ulib_mem_vec const v_last = p_ulib_mem_splat(last);
+    size_t const end = h_len - n_len + 1, m_len = n_len - 2;
+    size_t i = 0;
+
+    for (; i + P_ULIB_MEM_WIDTH <= end; i += P_ULIB_MEM_WIDTH) {
+        uint64_t mask = p_ulib_mem_eq(h + i, v_first) & p_ulib_mem_eq(h + i + n_len - 1, v_last);
+        for (; mask; mask &= mask - 1) {
+            size_t const pos = i + p_ulib_mem_first_bit(mask) / P_ULIB_MEM_STRIDE;
+            if (memcmp(h + pos + 1, n + 1, m_len) == 0) return (void *)(h + pos);
+        }
+    }
 
-    for (char const *h = haystack; (h = memchr(h, n_first, last_h - h)) != NULL; ++h) {
-        if (memcmp(h + 1, needle, n_len) == 0) return (void *)h;
+    for (; i < end; ++i) {
+        if (h[i] == first && h[i + n_len - 1] == last && memcmp(h + i + 1, n + 1, m_len) == 0) {
+            return (void *)(h + i);
+        }
     }
 
     return NULL;
@@ -64,14 +442,35 @@ void *ulib_mem_mem(void const *haystack, size_t h_len, void const *needle, size_
 
 void *ulib_mem_mem_last(void const *haystack, size_t h_len, void const *needle, size_t n_len) {
     if (n_len == 0 || h_len < n_len) return NULL;
-    if (n_len == 1) return ulib_mem_chr_last(haystack, ((char *)needle)[0], h_len);
+    if (n_len == 1) return ulib_mem_chr_last(haystack, ((unsigned char const *)needle)[0], h_len);
 
-    char n_first = ((char *)needle)[0];
-    needle = (char const *)needle + 1;
-    n_len--;
+    unsigned char const *h = (unsigned char const *)haystack;
+    unsigned char const *n = (unsigned char const *)needle;
+    if (n_len >= P_ULIB_MEM_HORSPOOL_MIN_LEN) {
+        return p_ulib_mem_mem_last_horspool(h, h_len, n, n_len);
+    }
+
+    unsigned char const first = n[0], last = n[n_len - 1];
+    p_ulib_mem_vec const v_first = p_ulib_mem_splat(first);
+    p_ulib_mem_vec const v_last = p_ulib_mem_splat(last);
+    size_t const m_len = n_len - 2;
+    size_t i = h_len - n_len + 1;
+
+    for (; i >= P_ULIB_MEM_WIDTH; i -= P_ULIB_MEM_WIDTH) {
+        unsigned char const *block = h + i - P_ULIB_MEM_WIDTH;
+        uint64_t mask = p_ulib_mem_eq(block, v_first) & p_ulib_mem_eq(block + n_len - 1, v_last);
+        while (mask) {
+            unsigned const bit = p_ulib_mem_last_bit(mask);
+            unsigned char const *pos = block + bit / P_ULIB_MEM_STRIDE;
+            if (memcmp(pos + 1, n + 1, m_len) == 0) return (void *)pos;
+            mask &= ~((uint64_t)1 << bit);
+        }
+    }
 
-    for (char const *h = (char const *)haystack + h_len - n_len; h-- != haystack;) {
-        if (*h == n_first && memcmp(h + 1, needle, n_len) == 0) return (void *)h;
+    while (i--) {
+        if (h[i] == first && h[i + n_len - 1] == last && memcmp(h + i + 1, n + 1, m_len) == 0) {
+            return (void *)(h + i);
+        }
     }
 
     return NULL;
@@ -0,0 +1,539 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "ustring_raw.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define P_ULIB_UTF8_HIGH 0x8080808080808080ULL
+
+// Vectorized UTF-8 validation, following the lookup algorithm by Keiser and Lemire.
+// Every pair of adjacent bytes is classified by looking up the high and low nibbles of the first
+// byte and the high nibble of the second one in three 16-entry tables: the three results are
+// and'ed together, yielding a nonzero byte for every invalid pair. Sequences of three and four
+// bytes are then checked by testing whether the bytes two and three positions back are leading
+// bytes. Since table lookups require byte shuffles, this is only available on AVX2, SSSE3
+// and NEON targets, other targets fall back to a scalar decoder with an ASCII fast path.
+// Builds for baseline x86-64 compile the AVX2 validator anyway, and select it at runtime.
+
+#if !defined(ULIB_NO_SIMD) &&                                                                      \
+    (defined(__AVX2__) ||                                                                          \
+     (!defined(__SSSE3__) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))))
+
+#include <immintrin.h>
+
+#ifndef __AVX2__
+#define P_ULIB_UTF8_DISPATCH
+#define P_ULIB_UTF8_TARGET __attribute__((target("avx2")))
+#endif
+
+#define P_ULIB_UTF8_SIMD
+#define P_ULIB_UTF8_WIDTH 32
+typedef __m256i p_ulib_utf8_vec;
+
+#define p_ulib_utf8_load(p) _mm256_loadu_si256((__m256i const *)(p))
+#define p_ulib_utf8_table(t) _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const *)(t)))
+#define p_ulib_utf8_splat(c) _mm256_set1_epi8((char)(c))
+#define p_ulib_utf8_zero() _mm256_setzero_si256()
+#define p_ulib_utf8_and(a, b) _mm256_and_si256(a, b)
+#define p_ulib_utf8_or(a, b) _mm256_or_si256(a, b)
+#define p_ulib_utf8_xor(a, b) _mm256_xor_si256(a, b)
+#define p_ulib_utf8_subs(a, b) _mm256_subs_epu8(a, b)
+#define p_ulib_utf8_lookup(t, idx) _mm256_shuffle_epi8(t, idx)
+#define p_ulib_utf8_high_nibble(v) p_ulib_utf8_and(_mm256_srli_epi16(v, 4), p_ulib_utf8_splat(0x0F))
+#define p_ulib_utf8_low_nibble(v) p_ulib_utf8_and(v, p_ulib_utf8_splat(0x0F))
+#define p_ulib_utf8_is_ascii(v) (_mm256_movemask_epi8(v) == 0)
+#define p_ulib_utf8_is_zero(v) _mm256_testz_si256(v, v)
+#define p_ulib_utf8_prev(v, prev, n)                                                               \
+    _mm256_alignr_epi8(v, _mm256_permute2x128_si256(prev, v, 0x21), 16 - (n))
+
+#elif !defined(ULIB_NO_SIMD) && defined(__SSSE3__)
+
+#include <tmmintrin.h>
+
+#define P_ULIB_UTF8_SIMD
+#define P_ULIB_UTF8_WIDTH 16
+typedef __m128i p_ulib_utf8_vec;
+
+#define p_ulib_utf8_load(p) _mm_loadu_si128((__m128i const *)(p))
+#define p_ulib_utf8_table(t) p_ulib_utf8_load(t)
+#define p_ulib_utf8_splat(c) _mm_set1_epi8((char)(c))
+#define p_ulib_utf8_zero() _mm_setzero_si128()
+#define p_ulib_utf8_and(a, b) _mm_and_si128(a, b)
+#define p_ulib_utf8_or(a, b) _mm_or_si128(a, b)
+#define p_ulib_utf8_xor(a, b) _mm_xor_si128(a, b)
+#define p_ulib_utf8_subs(a, b) _mm_subs_epu8(a, b)
+#define p_ulib_utf8_lookup(t, idx) _mm_shuffle_epi8(t, idx)
+#define p_ulib_utf8_high_nibble(v) p_ulib_utf8_and(_mm_srli_epi16(v, 4), p_ulib_utf8_splat(0x0F))
+#define p_ulib_utf8_low_nibble(v) p_ulib_utf8_and(v, p_ulib_utf8_splat(0x0F))
+#define p_ulib_utf8_is_ascii(v) (_mm_movemask_epi8(v) == 0)
+#define p_ulib_utf8_is_zero(v) (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF)
+#define p_ulib_utf8_prev(v, prev, n) _mm_alignr_epi8(v, prev, 16 - (n))
+
+#elif !defined(ULIB_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>
+
+#define P_ULIB_UTF8_SIMD
+#define P_ULIB_UTF8_WIDTH 16
+typedef uint8x16_t p_ulib_utf8_vec;
+
+#define p_ulib_utf8_load(p) vld1q_u8(p)
+#define p_ulib_utf8_table(t) vld1q_u8(t)
+#define p_ulib_utf8_splat(c) vdupq_n_u8(c)
+#define p_ulib_utf8_zero() vdupq_n_u8(0)
+#define p_ulib_utf8_and(a, b) vandq_u8(a, b)
+#define p_ulib_utf8_or(a, b) vorrq_u8(a, b)
+#define p_ulib_utf8_xor(a, b) veorq_u8(a, b)
+#define p_ulib_utf8_subs(a, b) vqsubq_u8(a, b)
+#define p_ulib_utf8_lookup(t, idx) vqtbl1q_u8(t, idx)
+#define p_ulib_utf8_high_nibble(v) vshrq_n_u8(v, 4)
+#define p_ulib_utf8_low_nibble(v) vandq_u8(v, vdupq_n_u8(0x0F))
+#define p_ulib_utf8_is_ascii(v) (vmaxvq_u8(v) < 0x80)
+#define p_ulib_utf8_is_zero(v) (vmaxvq_u8(v) == 0)
+#define p_ulib_utf8_prev(v, prev, n) vextq_u8(prev, v, 16 - (n))
+
+#endif
+
+#ifndef P_ULIB_UTF8_TARGET
+#define P_ULIB_UTF8_TARGET
+#endif
+
+#ifdef P_ULIB_UTF8_SIMD
+
+// Error classes of byte pairs, "+" denotes the specified byte or any greater one.
+#define P_ULIB_UTF8_TOO_SHORT 0x01      // 11______ 0_______, 11______ 11______
+#define P_ULIB_UTF8_TOO_LONG 0x02       // 0_______ 10______
+#define P_ULIB_UTF8_OVERLONG_3 0x04     // 11100000 100_____
+#define P_ULIB_UTF8_TOO_LARGE 0x08      // 11110100+ 1001____, 11110100+ 101_____
+#define P_ULIB_UTF8_SURROGATE 0x10      // 11101101 101_____
+#define P_ULIB_UTF8_OVERLONG_2 0x20     // 1100000_ 10______
+#define P_ULIB_UTF8_TOO_LARGE_1000 0x40 // 11110101+ 1000____
+#define P_ULIB_UTF8_OVERLONG_4 0x40     // 11110000 1000____
+#define P_ULIB_UTF8_TWO_CONTS 0x80      // 10______ 10______
+
+#define P_ULIB_UTF8_CARRY (P_ULIB_UTF8_TOO_SHORT | P_ULIB_UTF8_TOO_LONG | P_ULIB_UTF8_TWO_CONTS)
+#define P_ULIB_UTF8_LARGE (P_ULIB_UTF8_TOO_LARGE | P_ULIB_UTF8_TOO_LARGE_1000)
+#define P_ULIB_UTF8_CONT (P_ULIB_UTF8_TOO_LONG | P_ULIB_UTF8_OVERLONG_2 | P_ULIB_UTF8_TWO_CONTS)
+
+// Indexed by the high nibble of the first byte.
+static unsigned char const p_ulib_utf8_first_high[16] = {
+    // 0_______: ASCII
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    P_ULIB_UTF8_TOO_LONG,
+    // 10______: continuation
+    P_ULIB_UTF8_TWO_CONTS,
+    P_ULIB_UTF8_TWO_CONTS,
+    P_ULIB_UTF8_TWO_CONTS,
+    P_ULIB_UTF8_TWO_CONTS,
+    // 110_____: two byte lead
+    P_ULIB_UTF8_TOO_SHORT | P_ULIB_UTF8_OVERLONG_2,
+    P_ULIB_UTF8_TOO_SHORT,
+    // 1110____: three byte lead
+    P_ULIB_UTF8_TOO_SHORT | P_ULIB_UTF8_OVERLONG_3 | P_ULIB_UTF8_SURROGATE,
+    // 1111____: four byte lead
+    P_ULIB_UTF8_TOO_SHORT | P_ULIB_UTF8_LARGE | P_ULIB_UTF8_OVERLONG_4,
+};
+
+// Indexed by the low nibble of the first byte.
+static unsigned char const p_ulib_utf8_first_low[16] = {
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_OVERLONG_3 | P_ULIB_UTF8_OVERLONG_2 | P_ULIB_UTF8_OVERLONG_4,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_OVERLONG_2,
+    P_ULIB_UTF8_CARRY,
+    P_ULIB_UTF8_CARRY,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_TOO_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE | P_ULIB_UTF8_SURROGATE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+    P_ULIB_UTF8_CARRY | P_ULIB_UTF8_LARGE,
+};
+
+// Indexed by the high nibble of the second byte.
+static unsigned char const p_ulib_utf8_second_high[16] = {
+    // 0_______: ASCII
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    // 1000____
+    P_ULIB_UTF8_CONT | P_ULIB_UTF8_OVERLONG_3 | P_ULIB_UTF8_TOO_LARGE_1000 | P_ULIB_UTF8_OVERLONG_4,
+    // 1001____
+    P_ULIB_UTF8_CONT | P_ULIB_UTF8_OVERLONG_3 | P_ULIB_UTF8_TOO_LARGE,
+    // 101_____
+    P_ULIB_UTF8_CONT | P_ULIB_UTF8_SURROGATE | P_ULIB_UTF8_TOO_LARGE,
+    P_ULIB_UTF8_CONT | P_ULIB_UTF8_SURROGATE | P_ULIB_UTF8_TOO_LARGE,
+    // 11______: leading byte
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+    P_ULIB_UTF8_TOO_SHORT,
+};
+
+// Bytes greater than these values at the end of a block start sequences that continue
+// in the next block.
+static unsigned char const p_ulib_utf8_incomplete_max[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+P_ULIB_UTF8_TARGET
+ULIB_INLINE
+p_ulib_utf8_vec p_ulib_utf8_errors(p_ulib_utf8_vec v, p_ulib_utf8_vec prev,
+                                   p_ulib_utf8_vec const tables[3]) {
+    p_ulib_utf8_vec const prev1 = p_ulib_utf8_prev(v, prev, 1);
+    p_ulib_utf8_vec err = p_ulib_utf8_lookup(tables[0], p_ulib_utf8_high_nibble(prev1));
+    err = p_ulib_utf8_and(err, p_ulib_utf8_lookup(tables[1], p_ulib_utf8_low_nibble(prev1)));
+    err = p_ulib_utf8_and(err, p_ulib_utf8_lookup(tables[2], p_ulib_utf8_high_nibble(v)));
+
+    // Continuation bytes following pairs of continuation bytes are only valid if they
+    // are the third or fourth byte of a sequence, which is exactly when TWO_CONTS is set.
+    p_ulib_utf8_vec const third = p_ulib_utf8_subs(p_ulib_utf8_prev(v, prev, 2),
+                                                   p_ulib_utf8_splat(0xE0 - 0x80));
+    p_ulib_utf8_vec const fourth = p_ulib_utf8_subs(p_ulib_utf8_prev(v, prev, 3),
+                                                    p_ulib_utf8_splat(0xF0 - 0x80));
+    p_ulib_utf8_vec const must_cont = p_ulib_utf8_or(third, fourth);
+    return p_ulib_utf8_xor(p_ulib_utf8_and(must_cont, p_ulib_utf8_splat(0x80)), err);
+}
+
+#endif
+
+// Returns the length of the longest ASCII prefix of the buffer.
+ULIB_INLINE
+size_t p_ulib_utf8_ascii_prefix(unsigned char const *s, size_t length) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint64_t a, b;
+        memcpy(&a, s + i, 8);
+        memcpy(&b, s + i + 8, 8);
+        if ((a | b) & P_ULIB_UTF8_HIGH) break;
+    }
+
+    while (i < length && s[i] < 0x80) ++i;
+    return i;
+}
+
+// ASCII fast paths of the UTF-16 transcoders, which widen or narrow 16 code units at a time.
+// SSE2 is part of the x86-64 baseline, so unlike validation these need no runtime dispatch.
+
+#if !defined(ULIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+
+#include <emmintrin.h>
+
+// Widens the longest ASCII prefix of the buffer to UTF-16, returning its length.
+ULIB_INLINE
+size_t p_ulib_utf8_ascii_to_utf16(unsigned char const *s, size_t length, uint16_t *d) {
+    __m128i const zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i const v = _mm_loadu_si128((__m128i const *)(s + i));
+        if (_mm_movemask_epi8(v)) break;
+        _mm_storeu_si128((__m128i *)(d + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(d + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+
+    for (; i < length && s[i] < 0x80; ++i) d[i] = s[i];
+    return i;
+}
+
+// Narrows the longest ASCII prefix of the buffer to UTF-8, returning its length.
+ULIB_INLINE
+size_t p_ulib_utf16_ascii_to_utf8(uint16_t const *s, size_t length, unsigned char *d) {
+    __m128i const high = _mm_set1_epi16((short)0xFF80);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i const a = _mm_loadu_si128((__m128i const *)(s + i));
+        __m128i const b = _mm_loadu_si128((__m128i const *)(s + i + 8));
+        __m128i const any = _mm_and_si128(_mm_or_si128(a, b), high);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(any, _mm_setzero_si128())) != 0xFFFF) break;
+        _mm_storeu_si128((__m128i *)(d + i), _mm_packus_epi16(a, b));
+    }
+
+    for (; i < length && s[i] < 0x80; ++i) d[i] = (unsigned char)s[i];
+    return i;
+}
+
+#elif !defined(ULIB_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+
+ULIB_INLINE
+size_t p_ulib_utf8_ascii_to_utf16(unsigned char const *s, size_t length, uint16_t *d) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t const v = vld1q_u8(s + i);
+        if (vmaxvq_u8(v) >= 0x80) break;
+        vst1q_u16(d + i, vmovl_u8(vget_low_u8(v)));
+        vst1q_u16(d + i + 8, vmovl_high_u8(v));
+    }
+
+    for (; i < length && s[i] < 0x80; ++i) d[i] = s[i];
+    return i;
+}
+
+ULIB_INLINE
+size_t p_ulib_utf16_ascii_to_utf8(uint16_t const *s, size_t length, unsigned char *d) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint16x8_t const a = vld1q_u16(s + i);
+        uint16x8_t const b = vld1q_u16(s + i + 8);
+        if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) break;
+        vst1q_u8(d + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    }
+
+    for (; i < length && s[i] < 0x80; ++i) d[i] = (unsigned char)s[i];
+    return i;
+}
+
+#else
+
+ULIB_INLINE
+size_t p_ulib_utf8_ascii_to_utf16(unsigned char const *s, size_t length, uint16_t *d) {
+    size_t const ascii = p_ulib_utf8_ascii_prefix(s, length);
+    for (size_t i = 0; i < ascii; ++i) d[i] = s[i];
+    return ascii;
+}
+
+ULIB_INLINE
+size_t p_ulib_utf16_ascii_to_utf8(uint16_t const *s, size_t length, unsigned char *d) {
+    size_t i = 0;
+    for (; i < length && s[i] < 0x80; ++i) d[i] = (unsigned char)s[i];
+    return i;
+}
+
+#endif
+
+// Decodes the code point at the start of the buffer, returning the length of its encoding,
+// or zero if the buffer does not start with a valid UTF-8 sequence.
+ULIB_INLINE
+unsigned p_ulib_utf8_decode(unsigned char const *s, size_t length, uint32_t *cp) {
+    unsigned char const c = s[0];
+    uint32_t v;
+
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    }
+
+    if (c < 0xC2) return 0;
+
+    if (c < 0xE0) {
+        if (length < 2 || (s[1] & 0xC0) != 0x80) return 0;
+        *cp = (uint32_t)(c & 0x1F) << 6 | (s[1] & 0x3F);
+        return 2;
+    }
+
+    if (c < 0xF0) {
+        if (length < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80) return 0;
+        v = (uint32_t)(c & 0x0F) << 12 | (uint32_t)(s[1] & 0x3F) << 6 | (s[2] & 0x3F);
+        if (v < 0x800 || (v >= 0xD800 && v <= 0xDFFF)) return 0;
+        *cp = v;
+        return 3;
+    }
+
+    if (c > 0xF4 || length < 4) return 0;
+    if ((s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80) return 0;
+    v = (uint32_t)(c & 0x07) << 18 | (uint32_t)(s[1] & 0x3F) << 12 |
+        (uint32_t)(s[2] & 0x3F) << 6 | (s[3] & 0x3F);
+    if (v < 0x10000 || v > 0x10FFFF) return 0;
+    *cp = v;
+    return 4;
+}
+
+#if !defined(P_ULIB_UTF8_SIMD) || defined(P_ULIB_UTF8_DISPATCH)
+
+static bool p_ulib_utf8_is_valid_scalar(unsigned char const *s, size_t length) {
+    uint32_t cp;
+
+    for (size_t i = 0; (i += p_ulib_utf8_ascii_prefix(s + i, length - i)) < length;) {
+        unsigned const n = p_ulib_utf8_decode(s + i, length - i, &cp);
+        if (!n) return false;
+        i += n;
+    }
+
+    return true;
+}
+
+#endif
+
+#ifdef P_ULIB_UTF8_SIMD
+
+P_ULIB_UTF8_TARGET
+static bool p_ulib_utf8_is_valid_simd(unsigned char const *s, size_t length) {
+    p_ulib_utf8_vec const tables[] = {
+        p_ulib_utf8_table(p_ulib_utf8_first_high),
+        p_ulib_utf8_table(p_ulib_utf8_first_low),
+        p_ulib_utf8_table(p_ulib_utf8_second_high),
+    };
+    p_ulib_utf8_vec const max = p_ulib_utf8_load(p_ulib_utf8_incomplete_max + 32 -
+                                                 P_ULIB_UTF8_WIDTH);
+    p_ulib_utf8_vec prev = p_ulib_utf8_zero(), err = prev, incomplete = prev;
+    size_t i = 0;
+
+    for (; i + P_ULIB_UTF8_WIDTH <= length; i += P_ULIB_UTF8_WIDTH) {
+        p_ulib_utf8_vec const v = p_ulib_utf8_load(s + i);
+
+        if (p_ulib_utf8_is_ascii(v)) {
+            err = p_ulib_utf8_or(err, incomplete);
+        } else {
+            err = p_ulib_utf8_or(err, p_ulib_utf8_errors(v, prev, tables));
+            incomplete = p_ulib_utf8_subs(v, max);
+        }
+
+        prev = v;
+    }
+
+    if (i < length) {
+        // Pad the last block with ASCII bytes, which terminate incomplete sequences.
+        unsigned char buf[P_ULIB_UTF8_WIDTH] = { 0 };
+        memcpy(buf, s + i, length - i);
+        err = p_ulib_utf8_or(err, p_ulib_utf8_errors(p_ulib_utf8_load(buf), prev, tables));
+    } else {
+        err = p_ulib_utf8_or(err, incomplete);
+    }
+
+    return p_ulib_utf8_is_zero(err);
+}
+
+#endif
+
+bool ulib_str_is_valid_utf8(char const *src, size_t length) {
+    unsigned char const *s = (unsigned char const *)src;
+#if defined(P_ULIB_UTF8_DISPATCH)
+    if (!__builtin_cpu_supports("avx2")) return p_ulib_utf8_is_valid_scalar(s, length);
+#endif
+#if defined(P_ULIB_UTF8_SIMD)
+    return p_ulib_utf8_is_valid_simd(s, length);
+#else
+    return p_ulib_utf8_is_valid_scalar(s, length);
+#endif
+}
+
+size_t ulib_str_utf8_length(char const *src, size_t length) {
+    unsigned char const *s = (unsigned char const *)src;
+    size_t i = 0, conts = 0;
+
+    // Counts continuation bytes, whose bit 7 is set and bit 6 is unset, in per-byte counters
+    // that are summed up before they can overflow.
+    while (i + 8 <= length) {
+        uint64_t acc = 0;
+
+        for (unsigned n = 0; n < 255 && i + 8 <= length; ++n, i += 8) {
+            uint64_t x;
+            memcpy(&x, s + i, 8);
+            acc += (x & ~(x << 1U) & P_ULIB_UTF8_HIGH) >> 7U;
+        }
+
+        acc = (acc & 0x00FF00FF00FF00FFULL) + (acc >> 8U & 0x00FF00FF00FF00FFULL);
+        conts += (size_t)((acc * 0x0001000100010001ULL) >> 48U);
+    }
+
+    for (; i < length; ++i) conts += (s[i] & 0xC0) == 0x80;
+    return length - conts;
+}
+
+ulib_ret ulib_str_utf8_to_utf16(char const *src, size_t length, uint16_t *dst, size_t *written) {
+    unsigned char const *s = (unsigned char const *)src;
+    uint16_t *d = dst;
+    ulib_ret ret = ULIB_OK;
+    uint32_t cp;
+
+    for (size_t i = 0; i < length;) {
+        size_t const ascii = p_ulib_utf8_ascii_to_utf16(s + i, length - i, d);
+        d += ascii;
+        i += ascii;
+        if (i == length) break;
+
+        unsigned const n = p_ulib_utf8_decode(s + i, length - i, &cp);
+
+        if (!n) {
+            ret = ULIB_ERR;
+            break;
+        }
+
+        i += n;
+
+        if (cp < 0x10000) {
+            *d++ = (uint16_t)cp;
+        } else {
+            cp -= 0x10000;
+            *d++ = (uint16_t)(0xD800 | cp >> 10U);
+            *d++ = (uint16_t)(0xDC00 | (cp & 0x3FF));
+        }
+    }
+
+    if (written) *written = (size_t)(d - dst);
+    return ret;
+}
+
+size_t ulib_str_utf8_length_from_utf16(uint16_t const *src, size_t length) {
+    size_t ret = length;
+
+    for (size_t i = 0; i < length; ++i) {
+        uint16_t const u = src[i];
+        // Surrogates take two bytes each, since pairs are encoded as four bytes.
+        ret += (u >= 0x80) + (u >= 0x800 && (u & 0xF800) != 0xD800);
+    }
+
+    return ret;
+}
+
+ulib_ret ulib_str_utf16_to_utf8(uint16_t const *src, size_t length, char *dst, size_t *written) {
+    unsigned char *d = (unsigned char *)dst;
+    ulib_ret ret = ULIB_OK;
+
+    for (size_t i = 0; i < length;) {
+        size_t const ascii = p_ulib_utf16_ascii_to_utf8(src + i, length - i, d);
+        d += ascii;
+        i += ascii;
+        if (i == length) break;
+
+        uint32_t cp = src[i++];
+
+        if (cp < 0x800) {
+            *d++ = (unsigned char)(0xC0 | cp >> 6U);
+            *d++ = (unsigned char)(0x80 | (cp & 0x3F));
+        } else if ((cp & 0xF800) != 0xD800) {
+            *d++ = (unsigned char)(0xE0 | cp >> 12U);
+            *d++ = (unsigned char)(0x80 | (cp >> 6U & 0x3F));
+            *d++ = (unsigned char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0xDC00 && i < length && (src[i] & 0xFC00) == 0xDC00) {
+            cp = 0x10000 + ((cp - 0xD800) << 10U) + (uint32_t)(src[i++] - 0xDC00);
+            *d++ = (unsigned char)(0xF0 | cp >> 18U);
+            *d++ = (unsigned char)(0x80 | (cp >> 12U & 0x3F));
+            *d++ = (unsigned char)(0x80 | (cp >> 6U & 0x3F));
+            *d++ = (unsigned char)(0x80 | (cp & 0x3F));
+        } else {
+            ret = ULIB_ERR;
+            break;
+        }
+    }
+
+    if (written) *written = (size_t)(d - (unsigned char *)dst);
+    return ret;
+}
@@ -0,0 +1,150 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "ustrpool.h"
+#include "ualloc.h"
+#include <stdalign.h>
+#include <string.h>
+
+struct p_ustrpool_chunk {
+    struct p_ustrpool_chunk *next;
+    size_t size;
+    size_t used;
+};
+
+#define P_USTRPOOL_ALIGN alignof(struct p_ustrpool_entry)
+#define p_ustrpool_align(size) (((size) + P_USTRPOOL_ALIGN - 1) & ~(P_USTRPOOL_ALIGN - 1))
+#define P_USTRPOOL_CHUNK_HEADER p_ustrpool_align(sizeof(struct p_ustrpool_chunk))
+
+// Allocations larger than this get a dedicated chunk, so that they do not waste the free space
+// at the end of the current chunk.
+#define P_USTRPOOL_LARGE_ALLOC (USTRPOOL_CHUNK_SIZE / 4)
+
+UStrSym const ustrsym_null = ulib_struct_init;
+
+static void *p_ustrpool_alloc(UStrPool *pool, size_t size) {
+    size = p_ustrpool_align(size);
+    struct p_ustrpool_chunk *chunk = pool->_chunks;
+
+    if (chunk && chunk->size - chunk->used >= size) {
+        void *ptr = (char *)chunk + chunk->used;
+        chunk->used += size;
+        return ptr;
+    }
+
+    bool const large = size > P_USTRPOOL_LARGE_ALLOC;
+    size_t const chunk_size = P_USTRPOOL_CHUNK_HEADER + (large ? size : USTRPOOL_CHUNK_SIZE);
+    struct p_ustrpool_chunk *new_chunk = (struct p_ustrpool_chunk *)ulib_malloc(chunk_size);
+    if (!new_chunk) return NULL;
+
+    new_chunk->size = chunk_size;
+    new_chunk->used = P_USTRPOOL_CHUNK_HEADER + size;
+
+    if (large && chunk) {
+        // Keep allocating from the current chunk.
+        new_chunk->next = chunk->next;
+        chunk->next = new_chunk;
+    } else {
+        new_chunk->next = chunk;
+        pool->_chunks = new_chunk;
+    }
+
+    return (char *)new_chunk + P_USTRPOOL_CHUNK_HEADER;
+}
+
+static struct p_ustrpool_entry **p_ustrpool_slot(struct p_ustrpool_entry **table, ulib_uint mask,
+                                                 UString string, ulib_uint hash) {
+    for (ulib_uint i = hash & mask;; i = (i + 1) & mask) {
+        struct p_ustrpool_entry *e = table[i];
+        if (!e || (e->hash == hash && ustring_equals(e->string, string))) return table + i;
+    }
+}
+
+static ulib_ret p_ustrpool_grow(UStrPool *pool) {
+    ulib_uint const size = pool->_table_size ? (ulib_uint)(pool->_table_size * 2) : 16;
+    if (!size) return ULIB_ERR_MEM;
+
+    struct p_ustrpool_entry **table = ulib_calloc_array(table, size);
+    if (!table) return ULIB_ERR_MEM;
+
+    ulib_uint const mask = size - 1;
+    uvec_foreach (ulib_ptr, &pool->_entries, e) {
+        struct p_ustrpool_entry *entry = (struct p_ustrpool_entry *)*e.item;
+        ulib_uint i = entry->hash & mask;
+        while (table[i]) i = (i + 1) & mask;
+        table[i] = entry;
+    }
+
+    ulib_free(pool->_table);
+    pool->_table = table;
+    pool->_table_size = size;
+    return ULIB_OK;
+}
+
+void ustrpool_deinit(UStrPool *pool) {
+    for (struct p_ustrpool_chunk *chunk = pool->_chunks, *next; chunk; chunk = next) {
+        next = chunk->next;
+        ulib_free(chunk);
+    }
+    ulib_free(pool->_table);
+    uvec_deinit(ulib_ptr, &pool->_entries);
+    *pool = ustrpool();
+}
+
+UStrSym ustrpool_lookup(UStrPool const *pool, UString string) {
+    UStrSym sym = ustrsym_null;
+    if (!pool->_table_size) return sym;
+    ulib_uint const hash = ustring_hash(string);
+    sym._e = *p_ustrpool_slot(pool->_table, pool->_table_size - 1, string, hash);
+    return sym;
+}
+
+UStrSym ustrpool_intern(UStrPool *pool, UString string) {
+    UStrSym sym = ustrsym_null;
+    ulib_uint const count = ustrpool_count(pool);
+    ulib_uint const hash = ustring_hash(string);
+    struct p_ustrpool_entry **slot = NULL;
+
+    if (pool->_table_size) {
+        slot = p_ustrpool_slot(pool->_table, pool->_table_size - 1, string, hash);
+        if (*slot) {
+            sym._e = *slot;
+            return sym;
+        }
+    }
+
+    // Keep the load factor below 1/2, so that probe sequences stay short.
+    if (count >= pool->_table_size / 2) {
+        if (p_ustrpool_grow(pool)) return sym;
+        slot = p_ustrpool_slot(pool->_table, pool->_table_size - 1, string, hash);
+    }
+
+    if (uvec_reserve(ulib_ptr, &pool->_entries, count + 1)) return sym;
+
+    // Small strings are stored inline, larger ones are copied right after their entry.
+    size_t const length = ustring_length(string);
+    bool const small = p_ustring_length_is_small(length);
+    size_t const size = sizeof(struct p_ustrpool_entry) + (small ? 0 : length + 1);
+    struct p_ustrpool_entry *entry = (struct p_ustrpool_entry *)p_ustrpool_alloc(pool, size);
+    if (!entry) return sym;
+
+    if (small) {
+        entry->string = ustring_wrap(ustring_data(string), length);
+    } else {
+        char *buf = (char *)(entry + 1);
+        memcpy(buf, ustring_data(string), length);
+        buf[length] = '\0';
+        entry->string = ustring_wrap(buf, length);
+    }
+
+    entry->hash = hash;
+    entry->id = count;
+    uvec_push(ulib_ptr, &pool->_entries, entry);
+    *slot = entry;
+    sym._e = entry;
+    return sym;
+}
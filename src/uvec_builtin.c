@@ -9,6 +9,8 @@
 #include "ualloc.h"
 #include "unumber.h"
 #include "ustring.h"
+#include "ustring_raw.h"
+#include <string.h>
 
 UVEC_IMPL_IDENTIFIABLE(char)
 UVEC_IMPL_IDENTIFIABLE(ulib_byte)
@@ -17,3 +19,47 @@ UVEC_IMPL_IDENTIFIABLE(ulib_uint)
 UVEC_IMPL_IDENTIFIABLE(ulib_float)
 UVEC_IMPL_IDENTIFIABLE(ulib_ptr)
 UVEC_IMPL_COMPARABLE(UString, ustring_equals, ustring_precedes)
+
+UVEC_IMPL_PARALLEL(ulib_int)
+UVEC_IMPL_PARALLEL(ulib_uint)
+UVEC_IMPL_PARALLEL(ulib_float)
+
+#define P_UVEC_PARSE_IMPL(T, parse)                                                                \
+    ulib_ret uvec_parse_##T(UVec(T) *vec, UString string, UString delims) {                        \
+        char const *set = ustring_data(delims);                                                    \
+        size_t const set_len = ustring_length(delims);                                             \
+        bool const lf = set_len && memchr(set, '\n', set_len);                                     \
+        char const *p = ustring_data(string), *end = p + ustring_length(string);                   \
+                                                                                                   \
+        if (p != end && set_len && memchr(set, end[-1], set_len)) {                                \
+            --end;                                                                                 \
+            if (lf && *end == '\n' && p != end && end[-1] == '\r') --end;                          \
+        }                                                                                          \
+        if (p == end) return ULIB_OK;                                                              \
+                                                                                                   \
+        for (;;) {                                                                                 \
+            size_t const len = (size_t)(end - p);                                                  \
+            char const *delim = (char const *)ulib_mem_chr_any(p, len, set, set_len);              \
+            char const *value_end = delim ? delim : end;                                           \
+            T value;                                                                               \
+                                                                                                   \
+            /* If '\n' is a delimiter, "\r\n" counts as a single one. */                           \
+            if (lf && delim) {                                                                     \
+                if (*delim == '\r' && delim + 1 != end && delim[1] == '\n') {                      \
+                    ++delim;                                                                       \
+                } else if (*delim == '\n' && value_end != p && value_end[-1] == '\r') {            \
+                    --value_end;                                                                   \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            ulib_ret ret = parse(p, (size_t)(value_end - p), &value);                              \
+            if (ret) return ret;                                                                   \
+            if (uvec_push(T, vec, value)) return ULIB_ERR_MEM;                                     \
+            if (!delim) return ULIB_OK;                                                            \
+            p = delim + 1;                                                                         \
+        }                                                                                          \
+    }
+
+P_UVEC_PARSE_IMPL(ulib_int, ulib_str_parse_int)
+P_UVEC_PARSE_IMPL(ulib_uint, ulib_str_parse_uint)
+P_UVEC_PARSE_IMPL(ulib_float, ulib_str_parse_float)
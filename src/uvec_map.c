@@ -0,0 +1,166 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // mremap
+#endif
+
+#include "uvec.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define P_UVEC_MAP_SUPPORTED
+#endif
+
+#define P_UVEC_MAP_MAGIC 0x4345565542494c55ULL // "ULIBUVEC"
+
+#ifdef P_UVEC_MAP_SUPPORTED
+
+static size_t p_uvec_map_length(size_t item_size, uint64_t size) {
+    return sizeof(p_uvec_map_header) + (size_t)size * item_size;
+}
+
+static p_uvec_map_header *p_uvec_map(int fd, size_t length, uvec_map_mode mode) {
+    int const flags = mode == UVEC_MAP_READ ? MAP_PRIVATE : MAP_SHARED;
+    void *map = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, fd, 0);
+    return map == MAP_FAILED ? NULL : (p_uvec_map_header *)map;
+}
+
+void *p_uvec_map_open(char const *path, size_t item_size, uvec_map_mode mode, ulib_uint *count) {
+    int oflags = mode == UVEC_MAP_READ ? O_RDONLY : O_RDWR | O_CREAT;
+    if (mode == UVEC_MAP_CREATE) oflags |= O_TRUNC;
+
+    int const fd = open(path, oflags, 0644);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st)) goto err_fd;
+
+    size_t length = (size_t)st.st_size;
+    bool const init = length < sizeof(p_uvec_map_header);
+
+    if (init) {
+        if (mode == UVEC_MAP_READ) goto err_fd;
+        length = sizeof(p_uvec_map_header);
+        if (ftruncate(fd, (off_t)length)) goto err_fd;
+    }
+
+    p_uvec_map_header *header = p_uvec_map(fd, length, mode);
+    if (!header) goto err_fd;
+
+    if (init) {
+        header->magic = P_UVEC_MAP_MAGIC;
+        header->item_size = item_size;
+        header->count = 0;
+    } else if (header->magic != P_UVEC_MAP_MAGIC || header->item_size != item_size) {
+        goto err_map;
+    }
+
+    header->size = (length - sizeof(*header)) / item_size;
+    if (header->size > ULIB_UINT_MAX) header->size = ULIB_UINT_MAX;
+    if (header->count > header->size) header->count = header->size;
+    header->fd = fd;
+    header->mode = (uint64_t)mode;
+    *count = (ulib_uint)header->count;
+    return header + 1;
+
+err_map:
+    munmap((void *)header, length);
+err_fd:
+    close(fd);
+    return NULL;
+}
+
+void *p_uvec_map_reserve(void *data, size_t item_size, ulib_uint size) {
+    p_uvec_map_header *header = p_uvec_map_header(data);
+    if (header->mode == UVEC_MAP_READ) return NULL;
+
+    uint64_t const old_size = header->size;
+    if (size <= old_size) return data;
+
+    // Grow geometrically, so that the file is extended and remapped O(log n) times.
+    uint64_t new_size = old_size + old_size / 2;
+    if (new_size < size) new_size = size;
+    if (new_size > ULIB_UINT_MAX) new_size = ULIB_UINT_MAX;
+
+    int const fd = (int)header->fd;
+    size_t const old_length = p_uvec_map_length(item_size, old_size);
+    size_t const new_length = p_uvec_map_length(item_size, new_size);
+    if (ftruncate(fd, (off_t)new_length)) return NULL;
+
+#ifdef MREMAP_MAYMOVE
+    void *map = mremap((void *)header, old_length, new_length, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED) return NULL;
+    header = (p_uvec_map_header *)map;
+#else
+    // Elements live in the shared file mapping, so they survive remapping.
+    p_uvec_map_header *new_header = p_uvec_map(fd, new_length, (uvec_map_mode)header->mode);
+    if (!new_header) return NULL;
+    munmap((void *)header, old_length);
+    header = new_header;
+#endif
+
+    header->size = new_size;
+    return header + 1;
+}
+
+uvec_ret p_uvec_map_sync(void *data, ulib_uint count) {
+    p_uvec_map_header *header = p_uvec_map_header(data);
+    if (header->mode == UVEC_MAP_READ) return UVEC_OK;
+    header->count = count;
+    size_t const length = p_uvec_map_length(header->item_size, header->size);
+    return msync((void *)header, length, MS_SYNC) ? UVEC_ERR : UVEC_OK;
+}
+
+uvec_ret p_uvec_map_close(void *data, ulib_uint count) {
+    p_uvec_map_header *header = p_uvec_map_header(data);
+    int const fd = (int)header->fd;
+    bool const writable = header->mode != UVEC_MAP_READ;
+    size_t const length = p_uvec_map_length(header->item_size, header->size);
+    size_t const used = p_uvec_map_length(header->item_size, count);
+    uvec_ret ret = UVEC_OK;
+
+    if (writable) {
+        // Clear the process-local fields, so that they do not linger in the file.
+        header->count = count;
+        header->size = count;
+        header->fd = 0;
+        header->mode = 0;
+    }
+
+    if (munmap((void *)header, length)) ret = UVEC_ERR;
+
+    // Trim the excess capacity, the file grows again when it is remapped.
+    if (writable && used < length && ftruncate(fd, (off_t)used)) ret = UVEC_ERR;
+    if (close(fd)) ret = UVEC_ERR;
+    return ret;
+}
+
+#else
+
+void *p_uvec_map_open(ulib_unused char const *path, ulib_unused size_t item_size,
+                      ulib_unused uvec_map_mode mode, ulib_unused ulib_uint *count) {
+    return NULL;
+}
+
+void *p_uvec_map_reserve(ulib_unused void *data, ulib_unused size_t item_size,
+                         ulib_unused ulib_uint size) {
+    return NULL;
+}
+
+uvec_ret p_uvec_map_sync(ulib_unused void *data, ulib_unused ulib_uint count) {
+    return UVEC_ERR;
+}
+
+uvec_ret p_uvec_map_close(ulib_unused void *data, ulib_unused ulib_uint count) {
+    return UVEC_ERR;
+}
+
+#endif
@@ -6,12 +6,22 @@
  */
 
 #include "ubit_tests.h"
+#include "udeque_tests.h"
 #include "uhash_tests.h"
 #include "ulib.h"
+#include "umultimatch_tests.h"
 #include "unumber_tests.h"
+#include "upackedvec_tests.h"
+#include "upool_tests.h"
+#include "upqueue_tests.h"
+#include "uqueue_tests.h"
 #include "urand_tests.h"
+#include "urope_tests.h"
+#include "usegvec_tests.h"
+#include "usoa_tests.h"
 #include "ustream_tests.h"
 #include "ustring_tests.h"
+#include "ustrpool_tests.h"
 #include "utime_tests.h"
 #include "uvec_tests.h"
 #include "uversion_tests.h"
@@ -19,10 +29,20 @@
 utest_main({
     utest_run("unumber", UNUMBER_TESTS);
     utest_run("ubit", UBIT_TESTS);
+    utest_run("udeque", UDEQUE_TESTS);
     utest_run("uhash", UHASH_TESTS);
+    utest_run("umultimatch", UMULTIMATCH_TESTS);
+    utest_run("upackedvec", UPACKEDVEC_TESTS);
+    utest_run("upool", UPOOL_TESTS);
+    utest_run("upqueue", UPQUEUE_TESTS);
+    utest_run("uqueue", UQUEUE_TESTS);
     utest_run("urand", URAND_TESTS);
+    utest_run("urope", UROPE_TESTS);
+    utest_run("usegvec", USEGVEC_TESTS);
+    utest_run("usoa", USOA_TESTS);
     utest_run("ustream", USTREAM_TESTS);
     utest_run("ustring", USTRING_TESTS);
+    utest_run("ustrpool", USTRPOOL_TESTS);
     utest_run("uvec", UVEC_TESTS);
     utest_run("utime", UTIME_TESTS);
     utest_run("uversion", UVERSION_TESTS);
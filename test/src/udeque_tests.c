@@ -0,0 +1,146 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "udeque_tests.h"
+#include "ulib.h"
+
+#define DQTYPE int
+UDEQUE_INIT(DQTYPE)
+
+enum { QUEUE_COUNT = 1000 };
+
+#define udeque_assert_elements(T, q, ...)                                                          \
+    do {                                                                                           \
+        T const p_arr[] = { __VA_ARGS__ };                                                         \
+        utest_assert_uint(udeque_count(T, q), ==, ulib_array_count(p_arr));                        \
+        for (ulib_uint p_i = 0; p_i < ulib_array_count(p_arr); ++p_i) {                            \
+            utest_assert_int(udeque_get(T, q, p_i), ==, p_arr[p_i]);                               \
+        }                                                                                          \
+    } while (0)
+
+void udeque_test_base(void) {
+    UDeque(DQTYPE) q = udeque(DQTYPE);
+    utest_assert_uint(udeque_count(DQTYPE, &q), ==, 0);
+    utest_assert_false(udeque_pop_front(DQTYPE, &q, NULL));
+    utest_assert_false(udeque_pop_back(DQTYPE, &q, NULL));
+
+    utest_assert(udeque_push_back(DQTYPE, &q, 2) == UVEC_OK);
+    utest_assert(udeque_push_back(DQTYPE, &q, 3) == UVEC_OK);
+    utest_assert(udeque_push_front(DQTYPE, &q, 1) == UVEC_OK);
+    utest_assert(udeque_push_front(DQTYPE, &q, 0) == UVEC_OK);
+    udeque_assert_elements(DQTYPE, &q, 0, 1, 2, 3);
+    utest_assert_int(udeque_first(DQTYPE, &q), ==, 0);
+    utest_assert_int(udeque_last(DQTYPE, &q), ==, 3);
+
+    udeque_set(DQTYPE, &q, 1, 5);
+    udeque_assert_elements(DQTYPE, &q, 0, 5, 2, 3);
+
+    DQTYPE item;
+    utest_assert(udeque_pop_front(DQTYPE, &q, &item));
+    utest_assert_int(item, ==, 0);
+    utest_assert(udeque_pop_back(DQTYPE, &q, &item));
+    utest_assert_int(item, ==, 3);
+    udeque_assert_elements(DQTYPE, &q, 5, 2);
+
+    udeque_clear(DQTYPE, &q);
+    utest_assert_uint(udeque_count(DQTYPE, &q), ==, 0);
+    utest_assert_uint(udeque_size(DQTYPE, &q), >=, 4);
+
+    udeque_deinit(DQTYPE, &q);
+}
+
+void udeque_test_wrap(void) {
+    UDeque(DQTYPE) q = udeque(DQTYPE);
+
+    // Use the deque as a FIFO queue, keeping the head moving around the ring buffer.
+    DQTYPE next_in = 0, next_out = 0;
+    for (unsigned i = 0; i < QUEUE_COUNT; ++i) {
+        for (unsigned j = 0; j < i % 7 + 1; ++j) {
+            utest_assert(udeque_push_back(DQTYPE, &q, next_in++) == UVEC_OK);
+        }
+        for (unsigned j = 0; j < i % 5 + 1; ++j) {
+            DQTYPE item;
+            if (!udeque_pop_front(DQTYPE, &q, &item)) break;
+            utest_assert_int(item, ==, next_out++);
+        }
+        utest_assert_uint(udeque_count(DQTYPE, &q), ==, (ulib_uint)(next_in - next_out));
+    }
+
+    for (ulib_uint i = 0; i < udeque_count(DQTYPE, &q); ++i) {
+        utest_assert_int(udeque_get(DQTYPE, &q, i), ==, next_out + (DQTYPE)i);
+    }
+
+    // Grow while the elements wrap around.
+    udeque_clear(DQTYPE, &q);
+    for (DQTYPE i = 0; i < 6; ++i) {
+        utest_assert(udeque_push_back(DQTYPE, &q, i) == UVEC_OK);
+    }
+    utest_assert_uint(udeque_pop_front_array(DQTYPE, &q, NULL, 5), ==, 5);
+    for (DQTYPE i = 6; i < QUEUE_COUNT; ++i) {
+        utest_assert(udeque_push_back(DQTYPE, &q, i) == UVEC_OK);
+    }
+    for (DQTYPE i = 4; i >= 0; --i) {
+        utest_assert(udeque_push_front(DQTYPE, &q, i) == UVEC_OK);
+    }
+    utest_assert_uint(udeque_count(DQTYPE, &q), ==, QUEUE_COUNT);
+    for (ulib_uint i = 0; i < QUEUE_COUNT; ++i) {
+        utest_assert_int(udeque_get(DQTYPE, &q, i), ==, (DQTYPE)i);
+    }
+
+    udeque_deinit(DQTYPE, &q);
+}
+
+void udeque_test_spans(void) {
+    UDeque(DQTYPE) q = udeque(DQTYPE);
+    utest_assert(udeque_push_back_array(DQTYPE, &q, NULL, 0) == UVEC_OK);
+    utest_assert_uint(udeque_count(DQTYPE, &q), ==, 0);
+    utest_assert(udeque_reserve(DQTYPE, &q, 8) == UVEC_OK);
+    utest_assert_uint(udeque_size(DQTYPE, &q), ==, 8);
+
+    DQTYPE const in[] = { 1, 2, 3, 4, 5, 6 };
+    DQTYPE out[8];
+    utest_assert(udeque_push_back_array(DQTYPE, &q, in, 6) == UVEC_OK);
+    utest_assert_uint(udeque_pop_front_array(DQTYPE, &q, out, 4), ==, 4);
+    utest_assert_int(out[0], ==, 1);
+    utest_assert_int(out[3], ==, 4);
+
+    // Elements: 5, 6 at slots 4 and 5. Free: slots 6, 7, then 0 to 3.
+    UDequeSpans(DQTYPE) s = udeque_free_spans(DQTYPE, &q);
+    utest_assert_uint(s.first_count, ==, 2);
+    utest_assert_uint(s.second_count, ==, 4);
+    s.first[0] = 7;
+    s.first[1] = 8;
+    s.second[0] = 9;
+    udeque_commit(DQTYPE, &q, 3);
+    udeque_assert_elements(DQTYPE, &q, 5, 6, 7, 8, 9);
+
+    s = udeque_spans(DQTYPE, &q);
+    utest_assert_uint(s.first_count, ==, 4);
+    utest_assert_uint(s.second_count, ==, 1);
+    utest_assert_int(s.first[0], ==, 5);
+    utest_assert_int(s.second[0], ==, 9);
+
+    s = udeque_free_spans(DQTYPE, &q);
+    utest_assert_uint(s.first_count, ==, 3);
+    utest_assert_uint(s.second_count, ==, 0);
+
+    udeque_consume(DQTYPE, &q, 2);
+    udeque_assert_elements(DQTYPE, &q, 7, 8, 9);
+
+    utest_assert(udeque_push_back_array(DQTYPE, &q, in, 6) == UVEC_OK);
+    udeque_assert_elements(DQTYPE, &q, 7, 8, 9, 1, 2, 3, 4, 5, 6);
+    utest_assert_uint(udeque_size(DQTYPE, &q), ==, 16);
+
+    utest_assert_uint(udeque_pop_front_array(DQTYPE, &q, out, 8), ==, 8);
+    utest_assert_int(out[0], ==, 7);
+    utest_assert_int(out[7], ==, 5);
+    utest_assert_uint(udeque_pop_front_array(DQTYPE, &q, out, 8), ==, 1);
+    utest_assert_int(out[0], ==, 6);
+    utest_assert_uint(udeque_count(DQTYPE, &q), ==, 0);
+
+    udeque_deinit(DQTYPE, &q);
+}
@@ -0,0 +1,19 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UDEQUE_TESTS_H
+#define UDEQUE_TESTS_H
+
+#include <stdbool.h>
+
+void udeque_test_base(void);
+void udeque_test_wrap(void);
+void udeque_test_spans(void);
+
+#define UDEQUE_TESTS udeque_test_base, udeque_test_wrap, udeque_test_spans
+
+#endif // UDEQUE_TESTS_H
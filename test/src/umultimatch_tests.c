@@ -0,0 +1,153 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "umultimatch_tests.h"
+#include "ulib.h"
+
+enum { PATTERN_COUNT = 40, MAX_PATTERN_LENGTH = 6, TEXT_LENGTH = 2000, MAX_HITS = 8000 };
+
+static bool init_matcher(UMultiMatch *mm, char const *const *patterns, ulib_uint count) {
+    UVec(UString) vec = uvec(UString);
+
+    for (ulib_uint i = 0; i < count; ++i) {
+        if (uvec_push(UString, &vec, ustring_wrap_buf(patterns[i]))) return false;
+    }
+
+    bool const ret = umultimatch_init(mm, &vec) == ULIB_OK;
+    uvec_deinit(UString, &vec);
+    return ret;
+}
+
+static bool hit_equals(UMultiMatchHit hit, ulib_uint pattern, size_t start, size_t length) {
+    return hit.pattern == pattern && hit.start == start && hit.length == length;
+}
+
+// Enumerates all occurrences in the order they are reported by the matcher.
+static ulib_uint naive_hits(UVec(UString) const *patterns, char const *text, size_t length,
+                            UMultiMatchHit *hits) {
+    ulib_uint count = 0;
+
+    for (size_t end = 1; end <= length; ++end) {
+        for (size_t len = ulib_min(end, MAX_PATTERN_LENGTH); len > 0; --len) {
+            UString str = ustring_wrap(text + end - len, len);
+            ulib_uint idx = uvec_index_of(UString, patterns, str);
+            if (idx == uvec_count(UString, patterns)) continue;
+
+            hits[count].pattern = idx;
+            hits[count].start = end - len;
+            hits[count++].length = len;
+        }
+    }
+
+    return count;
+}
+
+void umultimatch_test_base(void) {
+    char const *const patterns[] = { "he", "she", "his", "hers", "\xFF\x7F", "she" };
+    UMultiMatch mm;
+    utest_assert_fatal(init_matcher(&mm, patterns, ulib_array_count(patterns)));
+
+    UMultiMatchHit hit;
+    UMultiMatchScan scan = umultimatch_scan(&mm);
+    umultimatch_scan_feed(&scan, "ushers", 6);
+    utest_assert(umultimatch_scan_next(&scan, &hit));
+    utest_assert(hit_equals(hit, 1, 1, 3));
+    utest_assert(umultimatch_scan_next(&scan, &hit));
+    utest_assert(hit_equals(hit, 0, 2, 2));
+    utest_assert(umultimatch_scan_next(&scan, &hit));
+    utest_assert(hit_equals(hit, 3, 2, 4));
+    utest_assert_false(umultimatch_scan_next(&scan, &hit));
+
+    utest_assert(umultimatch_find(&mm, ustring_literal("this is it"), &hit));
+    utest_assert(hit_equals(hit, 2, 1, 3));
+    utest_assert(umultimatch_find(&mm, ustring_literal("a\xFF\x7F"), &hit));
+    utest_assert(hit_equals(hit, 4, 1, 2));
+    utest_assert_false(umultimatch_find(&mm, ustring_literal("nothing to see"), NULL));
+    utest_assert_false(umultimatch_find(&mm, ustring_empty, NULL));
+    umultimatch_deinit(&mm);
+
+    utest_assert(init_matcher(&mm, NULL, 0));
+    utest_assert_false(umultimatch_find(&mm, ustring_literal("text"), NULL));
+    umultimatch_deinit(&mm);
+
+    char const *const empty[] = { "a", "" };
+    utest_assert_false(init_matcher(&mm, empty, 2));
+}
+
+void umultimatch_test_random(void) {
+    UVec(UString) patterns = uvec(UString);
+    char text[TEXT_LENGTH];
+    UMultiMatchHit *exp = (UMultiMatchHit *)ulib_alloc_array(exp, MAX_HITS);
+    utest_assert_fatal(exp);
+
+    for (ulib_uint i = 0; i < PATTERN_COUNT; ++i) {
+        UString pattern;
+        char *buf = ustring(&pattern, (size_t)urand_range(1, MAX_PATTERN_LENGTH));
+        for (ulib_uint j = 0; j < ustring_length(pattern); ++j) buf[j] = (char)urand_range('a', 3);
+        utest_assert(uvec_push(UString, &patterns, pattern) == UVEC_OK);
+    }
+
+    for (ulib_uint i = 0; i < TEXT_LENGTH; ++i) text[i] = (char)urand_range('a', 3);
+    ulib_uint const count = naive_hits(&patterns, text, TEXT_LENGTH, exp);
+    utest_assert_uint(count, <=, MAX_HITS);
+
+    UMultiMatch mm;
+    utest_assert_fatal(umultimatch_init(&mm, &patterns) == ULIB_OK);
+
+    UMultiMatchScan scan = umultimatch_scan(&mm);
+    umultimatch_scan_feed(&scan, text, TEXT_LENGTH);
+    ulib_uint i = 0;
+
+    for (UMultiMatchHit hit; umultimatch_scan_next(&scan, &hit); ++i) {
+        utest_assert_uint(i, <, count);
+        utest_assert(hit_equals(hit, exp[i].pattern, exp[i].start, exp[i].length));
+    }
+
+    utest_assert_uint(i, ==, count);
+
+    umultimatch_deinit(&mm);
+    uvec_foreach (UString, &patterns, p) {
+        ustring_deinit(p.item);
+    }
+    uvec_deinit(UString, &patterns);
+    ulib_free(exp);
+}
+
+void umultimatch_test_stream(void) {
+    char const *const patterns[] = { "error", "warning", "fatal error", "or" };
+    UMultiMatch mm;
+    utest_assert_fatal(init_matcher(&mm, patterns, ulib_array_count(patterns)));
+
+    UStrBuf text = ustrbuf();
+    for (unsigned i = 0; i < 50; ++i) ustrbuf_append_literal(&text, "log: fatal error, warning\n");
+
+    UMultiMatchScan scan = umultimatch_scan(&mm);
+    umultimatch_scan_feed(&scan, ustrbuf_data(&text), ustrbuf_length(&text));
+    ulib_uint count = 0;
+    for (UMultiMatchHit hit; umultimatch_scan_next(&scan, &hit);) ++count;
+    utest_assert_uint(count, ==, 50 * 4);
+
+    // Small chunks, so that occurrences span multiple chunks.
+    UIStream stream;
+    utest_assert(uistream_from_strbuf(&stream, &text) == USTREAM_OK);
+    scan = umultimatch_scan(&mm);
+    char buf[7];
+    size_t read;
+    ulib_uint i = 0;
+
+    while (umultimatch_scan_read(&scan, &stream, buf, sizeof(buf), &read) == USTREAM_OK && read) {
+        for (UMultiMatchHit hit; umultimatch_scan_next(&scan, &hit); ++i) {
+            char const *exp = ustrbuf_data(&text) + hit.start;
+            utest_assert(memcmp(exp, patterns[hit.pattern], hit.length) == 0);
+        }
+    }
+
+    utest_assert_uint(i, ==, count);
+    uistream_deinit(&stream);
+    ustrbuf_deinit(&text);
+    umultimatch_deinit(&mm);
+}
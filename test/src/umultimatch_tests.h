@@ -0,0 +1,19 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UMULTIMATCH_TESTS_H
+#define UMULTIMATCH_TESTS_H
+
+#include <stdbool.h>
+
+void umultimatch_test_base(void);
+void umultimatch_test_random(void);
+void umultimatch_test_stream(void);
+
+#define UMULTIMATCH_TESTS umultimatch_test_base, umultimatch_test_random, umultimatch_test_stream
+
+#endif // UMULTIMATCH_TESTS_H
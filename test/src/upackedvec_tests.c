@@ -0,0 +1,115 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "upackedvec_tests.h"
+#include "ulib.h"
+
+enum { ITEM_COUNT = 1000 };
+
+static ulib_uint items[ITEM_COUNT];
+static ulib_uint out[ITEM_COUNT];
+
+static bool check_packed(UPackedVec const *vec, ulib_uint const *array, ulib_uint n) {
+    if (upackedvec_count(vec) != n) return false;
+
+    for (ulib_uint i = 0; i < n; ++i) {
+        if (upackedvec_get(vec, i) != array[i]) return false;
+    }
+
+    for (ulib_uint start = 0; start < n; start += 37) {
+        ulib_uint const len = ulib_min(n - start, 150);
+        upackedvec_unpack(vec, start, len, out);
+        for (ulib_uint i = 0; i < len; ++i) {
+            if (out[i] != array[start + i]) return false;
+        }
+    }
+
+    UVec(ulib_uint) v = uvec(ulib_uint);
+    uvec_push(ulib_uint, &v, 42);
+    bool ret = upackedvec_to_uvec(vec, &v) == UVEC_OK && uvec_count(ulib_uint, &v) == n + 1 &&
+               uvec_first(ulib_uint, &v) == 42 &&
+               memcmp(uvec_data(ulib_uint, &v) + 1, array, n * sizeof(*array)) == 0;
+    uvec_deinit(ulib_uint, &v);
+    return ret;
+}
+
+void upackedvec_test_base(void) {
+    UPackedVec vec = upackedvec();
+    utest_assert_int(upackedvec_build(&vec, items, 0), ==, UVEC_OK);
+    utest_assert(check_packed(&vec, items, 0));
+
+    for (ulib_uint i = 0; i < ITEM_COUNT; ++i) {
+        items[i] = 1000 + (ulib_uint)urand_range(0, 4096);
+    }
+
+    utest_assert_int(upackedvec_build(&vec, items, ITEM_COUNT), ==, UVEC_OK);
+    utest_assert_false(upackedvec_is_delta(&vec));
+    utest_assert_uint(upackedvec_bits(&vec), <=, 12);
+    utest_assert_uint(upackedvec_memory(&vec), <, ITEM_COUNT * sizeof(ulib_uint));
+    utest_assert(check_packed(&vec, items, ITEM_COUNT));
+
+    for (ulib_uint i = 0; i < ITEM_COUNT; ++i) {
+        items[i] = 7;
+    }
+
+    utest_assert_int(upackedvec_build(&vec, items, ITEM_COUNT), ==, UVEC_OK);
+    utest_assert_uint(upackedvec_bits(&vec), ==, 0);
+    utest_assert(check_packed(&vec, items, ITEM_COUNT));
+
+    items[0] = 0;
+    items[1] = ULIB_UINT_MAX;
+    utest_assert_int(upackedvec_build(&vec, items, ITEM_COUNT), ==, UVEC_OK);
+    utest_assert_uint(upackedvec_bits(&vec), ==, sizeof(ulib_uint) * CHAR_BIT);
+    utest_assert(check_packed(&vec, items, ITEM_COUNT));
+
+    // Every width, with ranges that start at arbitrary bit offsets.
+    for (unsigned bits = 1; bits <= sizeof(ulib_uint) * CHAR_BIT; ++bits) {
+        ulib_uint const mask = (ulib_uint)(UINT64_MAX >> (64 - bits));
+        items[0] = 0;
+        items[1] = mask;
+        for (ulib_uint i = 2; i < ITEM_COUNT; ++i) {
+            items[i] = (ulib_uint)((uint64_t)urand() * 0x9E3779B97F4A7C15ULL) & mask;
+        }
+        utest_assert_int(upackedvec_build(&vec, items, ITEM_COUNT), ==, UVEC_OK);
+        utest_assert_uint(upackedvec_bits(&vec), ==, bits);
+        utest_assert(check_packed(&vec, items, ITEM_COUNT));
+    }
+
+    upackedvec_deinit(&vec);
+}
+
+void upackedvec_test_sorted(void) {
+    UPackedVec vec = upackedvec();
+    utest_assert_int(upackedvec_build_sorted(&vec, items, 0), ==, UVEC_OK);
+    utest_assert(check_packed(&vec, items, 0));
+
+    items[0] = 5;
+    utest_assert_int(upackedvec_build_sorted(&vec, items, 1), ==, UVEC_OK);
+    utest_assert(check_packed(&vec, items, 1));
+
+    for (ulib_uint i = 1; i < ITEM_COUNT; ++i) {
+        items[i] = items[i - 1] + 3 + (ulib_uint)urand_range(0, 16);
+    }
+
+    utest_assert_int(upackedvec_build_sorted(&vec, items, ITEM_COUNT), ==, UVEC_OK);
+    utest_assert(upackedvec_is_delta(&vec));
+    utest_assert_uint(upackedvec_bits(&vec), <=, 4);
+    utest_assert(check_packed(&vec, items, ITEM_COUNT));
+
+    for (ulib_uint i = 1; i < ITEM_COUNT; ++i) {
+        items[i] = items[i - 1] + 2;
+    }
+
+    utest_assert_int(upackedvec_build_sorted(&vec, items, ITEM_COUNT), ==, UVEC_OK);
+    utest_assert_uint(upackedvec_bits(&vec), ==, 0);
+    utest_assert(check_packed(&vec, items, ITEM_COUNT));
+
+    items[ITEM_COUNT / 2] = 0;
+    utest_assert_int(upackedvec_build_sorted(&vec, items, ITEM_COUNT), ==, UVEC_NO);
+
+    upackedvec_deinit(&vec);
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UPACKEDVEC_TESTS_H
+#define UPACKEDVEC_TESTS_H
+
+#include <stdbool.h>
+
+void upackedvec_test_base(void);
+void upackedvec_test_sorted(void);
+
+#define UPACKEDVEC_TESTS upackedvec_test_base, upackedvec_test_sorted
+
+#endif // UPACKEDVEC_TESTS_H
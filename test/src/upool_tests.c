@@ -0,0 +1,155 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "upool_tests.h"
+#include "ulib.h"
+
+enum {
+    RANGE_COUNT = 10000,
+    TREE_DEPTH = 8,
+    JOIN_RUNS = 1000,
+    JOIN_TASKS = 4,
+};
+
+static ulib_byte marks[RANGE_COUNT];
+
+static void mark_range(ulib_unused void *ctx, ulib_uint start, ulib_uint len) {
+    for (ulib_uint i = start; i < start + len; ++i) {
+        marks[i]++;
+    }
+}
+
+static bool check_marks(ulib_uint start, ulib_uint len) {
+    for (ulib_uint i = 0; i < RANGE_COUNT; ++i) {
+        ulib_byte const expected = i >= start && i < start + len ? 1 : 0;
+        if (marks[i] != expected) return false;
+    }
+    return true;
+}
+
+static void test_parallel_for(UPool *pool) {
+    static ulib_uint const grains[] = { 0, 1, 7, RANGE_COUNT };
+
+    for (unsigned i = 0; i < ulib_array_count(grains); ++i) {
+        memset(marks, 0, sizeof(marks));
+        utest_assert_int(upool_parallel_for(pool, 0, RANGE_COUNT, grains[i], mark_range, NULL),
+                         ==, ULIB_OK);
+        utest_assert(check_marks(0, RANGE_COUNT));
+    }
+
+    memset(marks, 0, sizeof(marks));
+    utest_assert_int(upool_parallel_for(pool, 100, 1000, 3, mark_range, NULL), ==, ULIB_OK);
+    utest_assert(check_marks(100, 1000));
+
+    memset(marks, 0, sizeof(marks));
+    utest_assert_int(upool_parallel_for(pool, 0, 0, 0, mark_range, NULL), ==, ULIB_OK);
+    utest_assert(check_marks(0, 0));
+}
+
+void upool_test_parallel_for(void) {
+    test_parallel_for(NULL);
+
+    static unsigned const threads[] = { 0, 1, 4 };
+
+    for (unsigned i = 0; i < ulib_array_count(threads); ++i) {
+        UPool *pool = upool_new(threads[i]);
+        utest_assert_not_null(pool);
+        test_parallel_for(pool);
+        upool_free(pool);
+    }
+}
+
+typedef struct tree_node {
+    UPoolGroup *group;
+    ulib_uint depth;
+    ulib_uint index;
+} tree_node;
+
+static ulib_byte leaves[1 << TREE_DEPTH];
+static tree_node nodes[1 << (TREE_DEPTH + 1)];
+
+static void visit_node(void *ctx) {
+    tree_node *node = (tree_node *)ctx;
+
+    if (node->depth == TREE_DEPTH) {
+        leaves[node->index - (1 << TREE_DEPTH)]++;
+        return;
+    }
+
+    for (ulib_uint i = 0; i < 2; ++i) {
+        tree_node *child = nodes + node->index * 2 + i;
+        child->group = node->group;
+        child->depth = node->depth + 1;
+        child->index = node->index * 2 + i;
+        upool_group_spawn(node->group, visit_node, child);
+    }
+}
+
+void upool_test_group(void) {
+    static unsigned const threads[] = { 0, 1, 4 };
+
+    for (unsigned i = 0; i < ulib_array_count(threads); ++i) {
+        UPool *pool = upool_new(threads[i]);
+        utest_assert_not_null(pool);
+
+        UPoolGroup *group = upool_group_new(pool);
+        utest_assert_not_null(group);
+
+        for (unsigned run = 0; run < 2; ++run) {
+            memset(leaves, 0, sizeof(leaves));
+            nodes[1].group = group;
+            nodes[1].depth = 0;
+            nodes[1].index = 1;
+            utest_assert_int(upool_group_spawn(group, visit_node, nodes + 1), ==, ULIB_OK);
+            upool_group_join(group);
+
+            for (ulib_uint j = 0; j < ulib_array_count(leaves); ++j) {
+                utest_assert_uint(leaves[j], ==, 1);
+            }
+        }
+
+        upool_group_free(group);
+        upool_free(pool);
+    }
+}
+
+static void slow_task(void *ctx) {
+    ulib_uint *slot = (ulib_uint *)ctx;
+    for (volatile ulib_uint i = 0; i < 1000; ++i) ulib_noop;
+    (*slot)++;
+}
+
+void upool_test_join(void) {
+    static unsigned const threads[] = { 0, 1, 4 };
+    ulib_uint slots[JOIN_TASKS];
+
+    for (unsigned i = 0; i < ulib_array_count(threads); ++i) {
+        UPool *pool = upool_new(threads[i]);
+        utest_assert_not_null(pool);
+        memset(slots, 0, sizeof(slots));
+
+        // Join groups whose tasks are still running on workers, so that joiners have to sleep.
+        for (unsigned run = 0; run < JOIN_RUNS; ++run) {
+            UPoolGroup *group = upool_group_new(pool);
+            utest_assert_not_null(group);
+
+            for (unsigned j = 0; j < JOIN_TASKS; ++j) {
+                utest_assert_int(upool_group_spawn(group, slow_task, slots + j), ==, ULIB_OK);
+            }
+
+            upool_group_join(group);
+
+            for (unsigned j = 0; j < JOIN_TASKS; ++j) {
+                utest_assert_uint(slots[j], ==, run + 1);
+            }
+
+            upool_group_free(group);
+        }
+
+        upool_free(pool);
+    }
+}
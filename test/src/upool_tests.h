@@ -0,0 +1,19 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UPOOL_TESTS_H
+#define UPOOL_TESTS_H
+
+#include <stdbool.h>
+
+void upool_test_parallel_for(void);
+void upool_test_group(void);
+void upool_test_join(void);
+
+#define UPOOL_TESTS upool_test_parallel_for, upool_test_group, upool_test_join
+
+#endif // UPOOL_TESTS_H
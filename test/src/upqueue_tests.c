@@ -0,0 +1,119 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "upqueue_tests.h"
+#include "ulib.h"
+
+#define PQTYPE int
+UPQUEUE_INIT(PQTYPE, ulib_lt)
+
+enum { RANDOM_COUNT = 1000 };
+
+void upqueue_test_base(void) {
+    UPQueue(PQTYPE) q = upqueue(PQTYPE);
+    utest_assert_uint(upqueue_count(PQTYPE, &q), ==, 0);
+    utest_assert_false(upqueue_pop(PQTYPE, &q, NULL, NULL));
+
+    PQTYPE const items[] = { 5, 3, 8, 1, 9, 2, 7 };
+    for (unsigned i = 0; i < ulib_array_count(items); ++i) {
+        utest_assert(upqueue_push(PQTYPE, &q, items[i], NULL) == UVEC_OK);
+    }
+
+    utest_assert_uint(upqueue_count(PQTYPE, &q), ==, ulib_array_count(items));
+    utest_assert_int(upqueue_top(PQTYPE, &q), ==, 1);
+
+    PQTYPE const sorted[] = { 1, 2, 3, 5, 7, 8, 9 };
+    for (unsigned i = 0; i < ulib_array_count(sorted); ++i) {
+        PQTYPE item;
+        utest_assert(upqueue_pop(PQTYPE, &q, &item, NULL));
+        utest_assert_int(item, ==, sorted[i]);
+    }
+
+    utest_assert_uint(upqueue_count(PQTYPE, &q), ==, 0);
+    upqueue_deinit(PQTYPE, &q);
+}
+
+void upqueue_test_handles(void) {
+    UPQueue(PQTYPE) q = upqueue(PQTYPE);
+    ulib_uint h[5];
+
+    for (unsigned i = 0; i < ulib_array_count(h); ++i) {
+        utest_assert(upqueue_push(PQTYPE, &q, (PQTYPE)(i + 1) * 10, &h[i]) == UVEC_OK);
+        utest_assert(upqueue_contains(PQTYPE, &q, h[i]));
+        utest_assert_int(upqueue_get(PQTYPE, &q, h[i]), ==, (PQTYPE)(i + 1) * 10);
+    }
+
+    // Decrease key
+    upqueue_update_priority(PQTYPE, &q, h[3], 5);
+    utest_assert_uint(upqueue_top_handle(PQTYPE, &q), ==, h[3]);
+    utest_assert_int(upqueue_top(PQTYPE, &q), ==, 5);
+
+    // Increase key
+    upqueue_update_priority(PQTYPE, &q, h[3], 100);
+    utest_assert_uint(upqueue_top_handle(PQTYPE, &q), ==, h[0]);
+    utest_assert_int(upqueue_get(PQTYPE, &q, h[3]), ==, 100);
+
+    // Remove by handle
+    PQTYPE item;
+    utest_assert(upqueue_remove(PQTYPE, &q, h[1], &item));
+    utest_assert_int(item, ==, 20);
+    utest_assert_false(upqueue_contains(PQTYPE, &q, h[1]));
+    utest_assert_false(upqueue_remove(PQTYPE, &q, h[1], NULL));
+    utest_assert_uint(upqueue_count(PQTYPE, &q), ==, 4);
+
+    // Handles are reused
+    ulib_uint handle;
+    utest_assert(upqueue_push(PQTYPE, &q, 1, &handle) == UVEC_OK);
+    utest_assert_uint(handle, ==, h[1]);
+    utest_assert(upqueue_contains(PQTYPE, &q, handle));
+
+    utest_assert(upqueue_pop(PQTYPE, &q, &item, &handle));
+    utest_assert_int(item, ==, 1);
+    utest_assert_uint(handle, ==, h[1]);
+
+    PQTYPE const sorted[] = { 10, 30, 50, 100 };
+    for (unsigned i = 0; i < ulib_array_count(sorted); ++i) {
+        utest_assert(upqueue_pop(PQTYPE, &q, &item, NULL));
+        utest_assert_int(item, ==, sorted[i]);
+    }
+
+    upqueue_clear(PQTYPE, &q);
+    utest_assert_false(upqueue_contains(PQTYPE, &q, h[0]));
+    upqueue_deinit(PQTYPE, &q);
+}
+
+void upqueue_test_random(void) {
+    UPQueue(PQTYPE) q = upqueue(PQTYPE);
+    static ulib_uint handles[RANDOM_COUNT];
+
+    for (unsigned i = 0; i < RANDOM_COUNT; ++i) {
+        PQTYPE const item = (PQTYPE)urand_range(0, RANDOM_COUNT);
+        utest_assert(upqueue_push(PQTYPE, &q, item, &handles[i]) == UVEC_OK);
+    }
+
+    for (unsigned i = 0; i < RANDOM_COUNT; i += 3) {
+        PQTYPE const item = (PQTYPE)urand_range(0, RANDOM_COUNT);
+        upqueue_update_priority(PQTYPE, &q, handles[i], item);
+        utest_assert_int(upqueue_get(PQTYPE, &q, handles[i]), ==, item);
+    }
+
+    for (unsigned i = 1; i < RANDOM_COUNT; i += 5) {
+        utest_assert(upqueue_remove(PQTYPE, &q, handles[i], NULL));
+    }
+
+    PQTYPE last = -1, item;
+    ulib_uint count = 0;
+
+    while (upqueue_pop(PQTYPE, &q, &item, NULL)) {
+        utest_assert_int(item, >=, last);
+        last = item;
+        ++count;
+    }
+
+    utest_assert_uint(count, ==, RANDOM_COUNT - (RANDOM_COUNT + 3) / 5);
+    upqueue_deinit(PQTYPE, &q);
+}
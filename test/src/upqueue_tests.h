@@ -0,0 +1,19 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UPQUEUE_TESTS_H
+#define UPQUEUE_TESTS_H
+
+#include <stdbool.h>
+
+void upqueue_test_base(void);
+void upqueue_test_handles(void);
+void upqueue_test_random(void);
+
+#define UPQUEUE_TESTS upqueue_test_base, upqueue_test_handles, upqueue_test_random
+
+#endif // UPQUEUE_TESTS_H
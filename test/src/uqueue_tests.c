@@ -0,0 +1,95 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "uqueue_tests.h"
+#include "ulib.h"
+
+#define QTYPE int
+USPSC_QUEUE_INIT(QTYPE)
+UMPMC_QUEUE_INIT(QTYPE)
+
+enum { QUEUE_SIZE = 16, QUEUE_ROUNDS = 100 };
+
+void uqueue_test_spsc(void) {
+    USpscQueue(QTYPE) q;
+    utest_assert(uspsc_queue_init(QTYPE, &q, 10) == UVEC_OK);
+    utest_assert_uint(uspsc_queue_size(QTYPE, &q), ==, QUEUE_SIZE);
+    utest_assert_uint(uspsc_queue_count(QTYPE, &q), ==, 0);
+    utest_assert_false(uspsc_queue_pop(QTYPE, &q, NULL));
+
+    QTYPE in = 0, out = 0, item;
+
+    for (unsigned r = 0; r < QUEUE_ROUNDS; ++r) {
+        while (uspsc_queue_push(QTYPE, &q, in)) in++;
+        utest_assert_uint(uspsc_queue_count(QTYPE, &q), ==, QUEUE_SIZE);
+        for (unsigned i = 0; i < r % QUEUE_SIZE + 1; ++i) {
+            utest_assert(uspsc_queue_pop(QTYPE, &q, &item));
+            utest_assert_int(item, ==, out++);
+        }
+    }
+
+    QTYPE items[QUEUE_SIZE];
+    ulib_uint n = uspsc_queue_pop_array(QTYPE, &q, items, QUEUE_SIZE);
+    utest_assert_uint(n, ==, (ulib_uint)(in - out));
+    for (ulib_uint i = 0; i < n; ++i) {
+        utest_assert_int(items[i], ==, out++);
+    }
+    utest_assert_uint(uspsc_queue_count(QTYPE, &q), ==, 0);
+
+    for (ulib_uint i = 0; i < QUEUE_SIZE; ++i) {
+        items[i] = (QTYPE)i;
+    }
+    utest_assert_uint(uspsc_queue_push_array(QTYPE, &q, items, 10), ==, 10);
+    utest_assert_uint(uspsc_queue_push_array(QTYPE, &q, items, 10), ==, 6);
+    utest_assert_false(uspsc_queue_push(QTYPE, &q, 0));
+    utest_assert_uint(uspsc_queue_pop_array(QTYPE, &q, NULL, 12), ==, 12);
+    utest_assert_uint(uspsc_queue_pop_array(QTYPE, &q, items, QUEUE_SIZE), ==, 4);
+    utest_assert_int(items[0], ==, 2);
+    utest_assert_int(items[3], ==, 5);
+
+    uspsc_queue_deinit(QTYPE, &q);
+}
+
+void uqueue_test_mpmc(void) {
+    UMpmcQueue(QTYPE) q;
+    utest_assert(umpmc_queue_init(QTYPE, &q, QUEUE_SIZE) == UVEC_OK);
+    utest_assert_uint(umpmc_queue_size(QTYPE, &q), ==, QUEUE_SIZE);
+    utest_assert_false(umpmc_queue_pop(QTYPE, &q, NULL));
+
+    QTYPE in = 0, out = 0, item;
+
+    for (unsigned r = 0; r < QUEUE_ROUNDS; ++r) {
+        while (umpmc_queue_push(QTYPE, &q, in)) in++;
+        utest_assert_uint(umpmc_queue_count(QTYPE, &q), ==, QUEUE_SIZE);
+        for (unsigned i = 0; i < r % QUEUE_SIZE + 1; ++i) {
+            utest_assert(umpmc_queue_pop(QTYPE, &q, &item));
+            utest_assert_int(item, ==, out++);
+        }
+    }
+
+    QTYPE items[QUEUE_SIZE];
+    ulib_uint n = umpmc_queue_pop_array(QTYPE, &q, items, QUEUE_SIZE);
+    utest_assert_uint(n, ==, (ulib_uint)(in - out));
+    for (ulib_uint i = 0; i < n; ++i) {
+        utest_assert_int(items[i], ==, out++);
+    }
+    utest_assert_uint(umpmc_queue_count(QTYPE, &q), ==, 0);
+    utest_assert_uint(umpmc_queue_pop_array(QTYPE, &q, items, QUEUE_SIZE), ==, 0);
+
+    for (ulib_uint i = 0; i < QUEUE_SIZE; ++i) {
+        items[i] = (QTYPE)i;
+    }
+    utest_assert_uint(umpmc_queue_push_array(QTYPE, &q, items, 10), ==, 10);
+    utest_assert_uint(umpmc_queue_push_array(QTYPE, &q, items, 10), ==, 6);
+    utest_assert_false(umpmc_queue_push(QTYPE, &q, 0));
+    utest_assert_uint(umpmc_queue_pop_array(QTYPE, &q, NULL, 12), ==, 12);
+    utest_assert_uint(umpmc_queue_pop_array(QTYPE, &q, items, QUEUE_SIZE), ==, 4);
+    utest_assert_int(items[0], ==, 2);
+    utest_assert_int(items[3], ==, 5);
+
+    umpmc_queue_deinit(QTYPE, &q);
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UQUEUE_TESTS_H
+#define UQUEUE_TESTS_H
+
+#include <stdbool.h>
+
+void uqueue_test_spsc(void);
+void uqueue_test_mpmc(void);
+
+#define UQUEUE_TESTS uqueue_test_spsc, uqueue_test_mpmc
+
+#endif // UQUEUE_TESTS_H
@@ -0,0 +1,143 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "urope_tests.h"
+#include "ulib.h"
+
+enum { CHUNK_COUNT = 80 };
+
+// Builds a rope and the equivalent string buffer from chunks of varying length.
+static bool build_rope(URope *rope, UStrBuf *buf) {
+    for (ulib_uint i = 0; i < CHUNK_COUNT; ++i) {
+        UString chunk = ustring_repeating(ustring_literal("abcdefghij"), i % 23 + 1);
+        if (ustrbuf_append_ustring(buf, chunk)) return false;
+        if (urope_append_ustring(rope, chunk)) return false;
+    }
+    return true;
+}
+
+static bool rope_equals(URope const *rope, char const *data, size_t length) {
+    if (urope_length(rope) != length) return false;
+    UString str = urope_to_ustring(rope);
+    bool ret = ustring_length(str) == length && memcmp(ustring_data(str), data, length) == 0;
+    ustring_deinit(&str);
+    return ret;
+}
+
+void urope_test_base(void) {
+    URope rope = urope();
+    utest_assert(urope_is_empty(&rope));
+    utest_assert_uint(urope_length(&rope), ==, 0);
+    utest_assert_uint(urope_chunk_count(&rope), ==, 0);
+
+    UStrBuf buf = ustrbuf();
+    utest_assert(build_rope(&rope, &buf));
+    utest_assert(rope_equals(&rope, ustrbuf_data(&buf), ustrbuf_length(&buf)));
+    utest_assert_uint(urope_chunk_count(&rope), <, CHUNK_COUNT);
+
+    for (size_t i = 0; i < ustrbuf_length(&buf); i += 37) {
+        utest_assert(urope_char_at(&rope, i) == ustrbuf_data(&buf)[i]);
+    }
+
+    // Concatenation with itself, then with a duplicate.
+    URope dup = urope_dup(&rope);
+    utest_assert_uint(urope_length(&dup), ==, urope_length(&rope));
+    utest_assert(urope_append(&rope, &rope) == ULIB_OK);
+    utest_assert(urope_append(&rope, &dup) == ULIB_OK);
+    utest_assert(urope_append_buf(&rope, "xyz", 3) == ULIB_OK);
+    utest_assert(rope_equals(&dup, ustrbuf_data(&buf), ustrbuf_length(&buf)));
+
+    UStrBuf expected = ustrbuf();
+    for (unsigned i = 0; i < 3; ++i) {
+        ustrbuf_append_string(&expected, ustrbuf_data(&buf), ustrbuf_length(&buf));
+    }
+    ustrbuf_append_literal(&expected, "xyz");
+    utest_assert(rope_equals(&rope, ustrbuf_data(&expected), ustrbuf_length(&expected)));
+
+    urope_deinit(&dup);
+    urope_deinit(&rope);
+    ustrbuf_deinit(&expected);
+    ustrbuf_deinit(&buf);
+}
+
+void urope_test_range(void) {
+    URope rope = urope(), range = urope();
+    UStrBuf buf = ustrbuf();
+    utest_assert(build_rope(&rope, &buf));
+
+    char const *data = ustrbuf_data(&buf);
+    size_t const length = ustrbuf_length(&buf);
+
+    for (size_t start = 0; start < length; start += 211) {
+        for (size_t len = 0; start + len <= length; len = len * 3 + 7) {
+            utest_assert(urope_range(&rope, start, len, &range) == ULIB_OK);
+            utest_assert(rope_equals(&range, data + start, len));
+
+            // Ranges of ranges.
+            if (len > 2) {
+                URope inner;
+                utest_assert(urope_range(&range, 1, len - 2, &inner) == ULIB_OK);
+                utest_assert(rope_equals(&inner, data + start + 1, len - 2));
+                urope_deinit(&inner);
+            }
+
+            urope_deinit(&range);
+        }
+    }
+
+    utest_assert(urope_range(&rope, length, 0, &range) == ULIB_OK);
+    utest_assert(urope_is_empty(&range));
+    utest_assert(urope_range(&rope, length, 1, &range) == ULIB_ERR);
+
+    // Ranges remain valid after the original rope is deinitialized.
+    utest_assert(urope_range(&rope, 100, length - 200, &range) == ULIB_OK);
+    urope_deinit(&rope);
+    utest_assert(rope_equals(&range, data + 100, length - 200));
+
+    urope_deinit(&range);
+    ustrbuf_deinit(&buf);
+}
+
+void urope_test_write(void) {
+    URope rope = urope();
+    UStrBuf buf = ustrbuf();
+    utest_assert(build_rope(&rope, &buf));
+
+    UStrBuf out = ustrbuf();
+    UOStream stream;
+    size_t written;
+    utest_assert(uostream_to_strbuf(&stream, &out) == USTREAM_OK);
+    utest_assert(urope_write(&rope, &stream, &written) == USTREAM_OK);
+    utest_assert_uint(written, ==, ustrbuf_length(&buf));
+    utest_assert_uint(ustrbuf_length(&out), ==, ustrbuf_length(&buf));
+    utest_assert_buf(ustrbuf_data(&out), ==, ustrbuf_data(&buf), ustrbuf_length(&buf));
+    uostream_deinit(&stream);
+    ustrbuf_deinit(&out);
+
+    // Vectored writes through a buffered file stream.
+    char const path[] = "urope_test.txt";
+    UOStream *raw;
+    utest_assert(uostream_buffered(&stream, &raw, 256) == USTREAM_OK);
+    utest_assert(uostream_to_path(raw, path) == USTREAM_OK);
+    utest_assert(urope_write(&rope, &stream, &written) == USTREAM_OK);
+    utest_assert_uint(written, ==, ustrbuf_length(&buf));
+    utest_assert(uostream_deinit(&stream) == USTREAM_OK);
+
+    UIStream in;
+    char *data = (char *)ulib_malloc(ustrbuf_length(&buf) + 1);
+    utest_assert_not_null(data);
+    utest_assert(uistream_from_path(&in, path) == USTREAM_OK);
+    utest_assert(uistream_read(&in, data, ustrbuf_length(&buf) + 1, &written) == USTREAM_OK);
+    utest_assert_uint(written, ==, ustrbuf_length(&buf));
+    utest_assert_buf(data, ==, ustrbuf_data(&buf), ustrbuf_length(&buf));
+    uistream_deinit(&in);
+    ulib_free(data);
+    remove(path);
+
+    urope_deinit(&rope);
+    ustrbuf_deinit(&buf);
+}
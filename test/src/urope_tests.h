@@ -0,0 +1,19 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef UROPE_TESTS_H
+#define UROPE_TESTS_H
+
+#include <stdbool.h>
+
+void urope_test_base(void);
+void urope_test_range(void);
+void urope_test_write(void);
+
+#define UROPE_TESTS urope_test_base, urope_test_range, urope_test_write
+
+#endif // UROPE_TESTS_H
@@ -0,0 +1,105 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "usegvec_tests.h"
+#include "ulib.h"
+
+#define SVTYPE int
+USEGVEC_INIT(SVTYPE)
+
+enum { PUSH_COUNT = 1000 };
+
+void usegvec_test_base(void) {
+    USegVec(SVTYPE) v = usegvec(SVTYPE);
+    utest_assert_uint(usegvec_count(SVTYPE, &v), ==, 0);
+    utest_assert_uint(usegvec_size(SVTYPE, &v), ==, 0);
+    utest_assert_false(usegvec_pop(SVTYPE, &v, NULL));
+
+    usegvec_foreach (SVTYPE, &v, entry) {
+        utest_fail();
+    }
+
+    for (int i = 0; i < PUSH_COUNT; ++i) {
+        utest_assert(usegvec_push(SVTYPE, &v, i) == UVEC_OK);
+    }
+
+    utest_assert_uint(usegvec_count(SVTYPE, &v), ==, PUSH_COUNT);
+    utest_assert_uint(usegvec_size(SVTYPE, &v), >=, PUSH_COUNT);
+    utest_assert_int(usegvec_last(SVTYPE, &v), ==, PUSH_COUNT - 1);
+
+    for (ulib_uint i = 0; i < PUSH_COUNT; ++i) {
+        utest_assert_int(usegvec_get(SVTYPE, &v, i), ==, (int)i);
+    }
+
+    ulib_uint count = 0;
+    usegvec_foreach (SVTYPE, &v, entry) {
+        utest_assert_uint(entry.i, ==, count++);
+        utest_assert_int(*entry.item, ==, (int)entry.i);
+        *entry.item *= 2;
+    }
+    utest_assert_uint(count, ==, PUSH_COUNT);
+
+    usegvec_set(SVTYPE, &v, 500, -1);
+    utest_assert_int(usegvec_get(SVTYPE, &v, 500), ==, -1);
+    utest_assert_int(usegvec_get(SVTYPE, &v, 501), ==, 1002);
+
+    SVTYPE item;
+    utest_assert(usegvec_pop(SVTYPE, &v, &item));
+    utest_assert_int(item, ==, 2 * (PUSH_COUNT - 1));
+    utest_assert_uint(usegvec_count(SVTYPE, &v), ==, PUSH_COUNT - 1);
+
+    ulib_uint const size = usegvec_size(SVTYPE, &v);
+    usegvec_clear(SVTYPE, &v);
+    utest_assert_uint(usegvec_count(SVTYPE, &v), ==, 0);
+    utest_assert_uint(usegvec_size(SVTYPE, &v), ==, size);
+
+    SVTYPE array[PUSH_COUNT];
+    for (int i = 0; i < PUSH_COUNT; ++i) {
+        array[i] = PUSH_COUNT - i;
+    }
+
+    utest_assert(usegvec_push(SVTYPE, &v, 0) == UVEC_OK);
+    utest_assert(usegvec_append_array(SVTYPE, &v, array, PUSH_COUNT) == UVEC_OK);
+    utest_assert_uint(usegvec_count(SVTYPE, &v), ==, PUSH_COUNT + 1);
+
+    for (ulib_uint i = 1; i <= PUSH_COUNT; ++i) {
+        utest_assert_int(usegvec_get(SVTYPE, &v, i), ==, array[i - 1]);
+    }
+
+    usegvec_deinit(SVTYPE, &v);
+}
+
+void usegvec_test_stability(void) {
+    USegVec(SVTYPE) v = usegvec(SVTYPE);
+    utest_assert(usegvec_push(SVTYPE, &v, 42) == UVEC_OK);
+    SVTYPE *first = usegvec_get_ref(SVTYPE, &v, 0);
+
+    utest_assert(usegvec_reserve(SVTYPE, &v, 10 * PUSH_COUNT) == UVEC_OK);
+    utest_assert_uint(usegvec_size(SVTYPE, &v), >=, 10 * PUSH_COUNT);
+    utest_assert(usegvec_get_ref(SVTYPE, &v, 0) == first);
+
+    SVTYPE *refs[PUSH_COUNT];
+    for (int i = 0; i < PUSH_COUNT; ++i) {
+        utest_assert(usegvec_push(SVTYPE, &v, i) == UVEC_OK);
+        refs[i] = usegvec_get_ref(SVTYPE, &v, usegvec_count(SVTYPE, &v) - 1);
+    }
+
+    for (int i = 0; i < 50 * PUSH_COUNT; ++i) {
+        utest_assert(usegvec_push(SVTYPE, &v, -i) == UVEC_OK);
+    }
+
+    utest_assert(usegvec_get_ref(SVTYPE, &v, 0) == first);
+    utest_assert_int(*first, ==, 42);
+
+    for (int i = 0; i < PUSH_COUNT; ++i) {
+        utest_assert(usegvec_get_ref(SVTYPE, &v, (ulib_uint)i + 1) == refs[i]);
+        utest_assert_int(*refs[i], ==, i);
+    }
+
+    usegvec_deinit(SVTYPE, &v);
+    utest_assert_uint(usegvec_count(SVTYPE, &v), ==, 0);
+}
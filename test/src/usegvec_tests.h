@@ -0,0 +1,18 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef USEGVEC_TESTS_H
+#define USEGVEC_TESTS_H
+
+#include <stdbool.h>
+
+void usegvec_test_base(void);
+void usegvec_test_stability(void);
+
+#define USEGVEC_TESTS usegvec_test_base, usegvec_test_stability
+
+#endif // USEGVEC_TESTS_H
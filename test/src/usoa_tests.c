@@ -0,0 +1,78 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "usoa_tests.h"
+#include "ulib.h"
+
+USOA_INIT(Particles, (float, x), (float, y), (ulib_uint, id), (char, tag))
+
+enum { PARTICLE_COUNT = 1000 };
+
+void usoa_test_base(void) {
+    Particles p = usoa(Particles);
+    utest_assert_uint(usoa_count(Particles, &p), ==, 0);
+    utest_assert_false(usoa_pop(Particles, &p, NULL));
+
+    USoaRow(Particles) row = { 1.0f, 2.0f, 42, 'a' };
+    utest_assert(usoa_push(Particles, &p, row) == UVEC_OK);
+    row.x = 3.0f;
+    row.id = 43;
+    row.tag = 'b';
+    utest_assert(usoa_push(Particles, &p, row) == UVEC_OK);
+    utest_assert_uint(usoa_count(Particles, &p), ==, 2);
+    utest_assert_uint(usoa_size(Particles, &p), >=, 2);
+
+    row = usoa_get(Particles, &p, 0);
+    utest_assert_float(row.x, ==, 1.0f);
+    utest_assert_float(row.y, ==, 2.0f);
+    utest_assert_uint(row.id, ==, 42);
+    utest_assert_int(row.tag, ==, 'a');
+
+    row.y = 5.0f;
+    usoa_set(Particles, &p, 1, row);
+    row = usoa_get(Particles, &p, 1);
+    utest_assert_float(row.x, ==, 1.0f);
+    utest_assert_float(row.y, ==, 5.0f);
+
+    utest_assert(usoa_pop(Particles, &p, &row));
+    utest_assert_uint(row.id, ==, 42);
+    utest_assert_uint(usoa_count(Particles, &p), ==, 1);
+
+    usoa_clear(Particles, &p);
+    utest_assert_uint(usoa_count(Particles, &p), ==, 0);
+
+    usoa_deinit(Particles, &p);
+}
+
+void usoa_test_columns(void) {
+    Particles p = usoa(Particles);
+    utest_assert(usoa_reserve(Particles, &p, PARTICLE_COUNT) == UVEC_OK);
+    utest_assert_uint(usoa_size(Particles, &p), >=, PARTICLE_COUNT);
+
+    for (ulib_uint i = 0; i < PARTICLE_COUNT; ++i) {
+        USoaRow(Particles) row = { (float)i, (float)(2 * i), i, (char)('a' + i % 26) };
+        utest_assert(usoa_push(Particles, &p, row) == UVEC_OK);
+    }
+
+    float const *xs = usoa_column(&p, x);
+    ulib_uint const *ids = usoa_column(&p, id);
+    double sum = 0.0;
+
+    for (ulib_uint i = 0; i < usoa_count(Particles, &p); ++i) {
+        utest_assert_uint(ids[i], ==, i);
+        sum += xs[i];
+    }
+
+    utest_assert_float(sum, ==, (double)PARTICLE_COUNT * (PARTICLE_COUNT - 1) / 2);
+
+    float *ys = usoa_column(&p, y);
+    ys[10] = -1.0f;
+    utest_assert_float(usoa_get(Particles, &p, 10).y, ==, -1.0f);
+    utest_assert_int(usoa_get(Particles, &p, 27).tag, ==, 'b');
+
+    usoa_deinit(Particles, &p);
+}
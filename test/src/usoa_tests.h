@@ -0,0 +1,18 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef USOA_TESTS_H
+#define USOA_TESTS_H
+
+#include <stdbool.h>
+
+void usoa_test_base(void);
+void usoa_test_columns(void);
+
+#define USOA_TESTS usoa_test_base, usoa_test_columns
+
+#endif // USOA_TESTS_H
@@ -211,6 +211,17 @@ void uostream_buf_test(void) {
     utest_assert_uint(written, ==, TEST_DATA_SIZE);
     utest_assert_buf(buf, ==, test_data, TEST_DATA_SIZE);
 
+    ret = uostream_write_int(&stream, -42, &written);
+    utest_assert(ret == USTREAM_OK);
+    utest_assert_uint(written, ==, 3);
+    ret = uostream_write_uint(&stream, 42, &written);
+    utest_assert(ret == USTREAM_OK);
+    utest_assert_uint(written, ==, 2);
+    ret = uostream_write_float(&stream, 0.25, &written);
+    utest_assert(ret == USTREAM_OK);
+    utest_assert_uint(written, ==, 4);
+    utest_assert_buf(buf + TEST_DATA_SIZE, ==, "-42420.25", 9);
+
     ret = uostream_deinit(&stream);
     utest_assert(ret == USTREAM_OK);
 
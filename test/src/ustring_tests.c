@@ -6,7 +6,13 @@
  */
 
 #include "ulib.h"
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
 enum { MAX_ASCII = 127 };
 
@@ -62,6 +68,21 @@ void ustring_utils_test(void) {
         }
     }
 
+    char bytes[UCHAR_MAX + 1], bytes_lower[UCHAR_MAX + 1];
+    for (unsigned i = 0; i <= UCHAR_MAX; ++i) bytes[i] = (char)i;
+
+    // Non-ASCII bytes must not be affected.
+    ulib_str_to_lower(bytes_lower, bytes, sizeof(bytes));
+    for (unsigned i = 0; i <= UCHAR_MAX; ++i) {
+        utest_assert(bytes_lower[i] == ulib_char_to_lower(bytes[i]));
+    }
+
+    utest_assert(ulib_str_equals_ignore_case(bytes, bytes_lower, sizeof(bytes)));
+    utest_assert(ulib_str_is_lower(bytes_lower, sizeof(bytes)));
+    utest_assert_false(ulib_str_is_upper(bytes_lower, sizeof(bytes)));
+    bytes_lower[200] = 'x';
+    utest_assert_false(ulib_str_equals_ignore_case(bytes, bytes_lower, sizeof(bytes)));
+
     char const h[] = "123ab456ab789";
     size_t const h_len = sizeof(h) - 1;
 
@@ -81,6 +102,453 @@ void ustring_utils_test(void) {
     utest_assert(ulib_mem_mem_last(h, h_len, "cd", sizeof("cd") - 1) == NULL);
 }
 
+static char const *naive_mem_mem(char const *h, size_t h_len, char const *n, size_t n_len,
+                                 bool last) {
+    char const *found = NULL;
+    for (size_t i = 0; n_len && i + n_len <= h_len; ++i) {
+        if (memcmp(h + i, n, n_len) != 0) continue;
+        found = h + i;
+        if (!last) break;
+    }
+    return found;
+}
+
+void ustring_test_search(void) {
+    enum { H_LEN = 600, N_MAX = 100 };
+    char h[H_LEN], n[N_MAX];
+
+    // Mostly repeated bytes, which defeat naive first byte filtering.
+    for (size_t i = 0; i < H_LEN; ++i) h[i] = (char)(i % 37 == 0 || i % 53 == 0 ? 'b' : 'a');
+
+    for (size_t len = 0; len < H_LEN; len += 7) {
+        char const *exp = NULL;
+        for (char const *p = h + len; p-- != h;) {
+            if (*p == 'b') {
+                exp = p;
+                break;
+            }
+        }
+        utest_assert(ulib_mem_chr_last(h, 'b', len) == exp);
+        utest_assert(ulib_mem_chr_last(h, 'c', len) == NULL);
+    }
+
+    for (size_t len = 0; len < H_LEN; len += 7) {
+        char const *exp = NULL;
+        for (char const *p = h; p != h + len; ++p) {
+            if (*p == 'b' || *p == 'x') {
+                exp = p;
+                break;
+            }
+        }
+        utest_assert(ulib_mem_chr_any(h, len, "xb", 2) == exp);
+        utest_assert(ulib_mem_chr_any(h, len, "vwxyzb", 6) == exp);
+        utest_assert(ulib_mem_chr_any(h, len, "xyz", 3) == NULL);
+        utest_assert(ulib_mem_chr_any(h, len, "", 0) == NULL);
+    }
+
+    for (size_t n_len = 1; n_len < N_MAX; n_len += 3) {
+        for (size_t start = 0; start + n_len <= H_LEN; start += 41) {
+            memcpy(n, h + start, n_len);
+            for (unsigned variant = 0; variant < 3; ++variant) {
+                if (variant == 1) n[n_len - 1] = 'c';
+                if (variant == 2) n[n_len / 2] = n[n_len / 2] == 'a' ? 'b' : 'a';
+                utest_assert(ulib_mem_mem(h, H_LEN, n, n_len) ==
+                             naive_mem_mem(h, H_LEN, n, n_len, false));
+                utest_assert(ulib_mem_mem_last(h, H_LEN, n, n_len) ==
+                             naive_mem_mem(h, H_LEN, n, n_len, true));
+                utest_assert(ulib_mem_mem_last(h, start + n_len, n, n_len) ==
+                             naive_mem_mem(h, start + n_len, n, n_len, true));
+            }
+        }
+    }
+}
+
+static bool split_equals(UStrSplit split, char const *const *exp, size_t count) {
+    size_t i = 0;
+    for (UString token; ustrsplit_next(&split, &token); ++i) {
+        if (i >= count || !ustring_equals(token, ustring_wrap_buf(exp[i]))) return false;
+    }
+    return i == count;
+}
+
+void ustring_test_split(void) {
+    UString str = ustring_literal("a,b;;c,");
+    char const *tokens[] = { "a", "b;;c", "" };
+    utest_assert(split_equals(ustring_split_iter(str, ustring_literal(",")), tokens, 3));
+
+    char const *any_tokens[] = { "a", "b", "", "c", "" };
+    utest_assert(split_equals(ustring_split_any(str, ustring_literal(",;")), any_tokens, 5));
+
+    char const *sep_tokens[] = { "a,b", "c," };
+    utest_assert(split_equals(ustring_split_iter(str, ustring_literal(";;")), sep_tokens, 2));
+
+    char const *whole[] = { "a,b;;c," };
+    utest_assert(split_equals(ustring_split_iter(str, ustring_empty), whole, 1));
+    utest_assert(split_equals(ustring_split_iter(str, ustring_literal("x")), whole, 1));
+
+    char const *empty[] = { "" };
+    utest_assert(split_equals(ustring_split_iter(ustring_empty, ustring_literal(",")), empty, 1));
+    utest_assert(split_equals(ustring_split_any(ustring_empty, ustring_literal(",")), empty, 1));
+
+    char const *lines[] = { "first", "", "third", "fourth" };
+    str = ustring_literal("first\r\n\nthird\nfourth");
+    utest_assert(split_equals(ustring_lines_iter(str), lines, 4));
+    str = ustring_literal("first\r\n\nthird\nfourth\n");
+    utest_assert(split_equals(ustring_lines_iter(str), lines, 4));
+    utest_assert(split_equals(ustring_lines_iter(ustring_empty), NULL, 0));
+
+    // Large tokens are views over the original buffer.
+    UString large = ustring_repeating(ustring_literal("0123456789abcdef\t"), 64);
+    UStrSplit split = ustring_split_any(large, ustring_literal("\t\n"));
+    size_t count = 0;
+
+    for (UString token; ustrsplit_next(&split, &token); ++count) {
+        if (count < 64) {
+            utest_assert(ustring_equals(token, ustring_literal("0123456789abcdef")));
+        } else {
+            utest_assert(ustring_is_empty(token));
+        }
+    }
+
+    utest_assert_uint(count, ==, 65);
+
+    split = ustring_split_iter(large, ustring_literal("\t0"));
+    UString token;
+    utest_assert(ustrsplit_next(&split, &token));
+    utest_assert(ustring_data(token) == ustring_data(large));
+    utest_assert(ustrsplit_next(&split, &token));
+    utest_assert(ustring_equals(token, ustring_literal("123456789abcdef")));
+
+    ustring_deinit(&large);
+}
+
+static bool float_str_equals(ulib_float value, char const *exp) {
+    char buf[ULIB_NUM_STR_SIZE];
+    size_t const len = ulib_str_from_float(buf, value);
+    return len == strlen(exp) && memcmp(buf, exp, len) == 0;
+}
+
+void ustring_test_num(void) {
+    char buf[ULIB_NUM_STR_SIZE + 1], exp[ULIB_NUM_STR_SIZE + 1];
+    ulib_int const ints[] = { 0, 1, -1, 9, 10, 99, 100, -12345, ULIB_INT_MAX, ULIB_INT_MIN };
+    ulib_uint const uints[] = { 0, 1, 9, 10, 99, 100, 999, 1000, 12345, ULIB_UINT_MAX };
+
+    for (unsigned i = 0; i < ulib_array_count(ints); ++i) {
+        size_t const len = ulib_str_from_int(buf, ints[i]);
+        buf[len] = '\0';
+        snprintf(exp, sizeof(exp), "%" ULIB_INT_FMT, ints[i]);
+        utest_assert_string(buf, ==, exp);
+    }
+
+    for (unsigned i = 0; i < ulib_array_count(uints); ++i) {
+        size_t const len = ulib_str_from_uint(buf, uints[i]);
+        buf[len] = '\0';
+        snprintf(exp, sizeof(exp), "%" ULIB_UINT_FMT, uints[i]);
+        utest_assert_string(buf, ==, exp);
+    }
+
+    utest_assert(float_str_equals((ulib_float)0.0, "0"));
+    utest_assert(float_str_equals((ulib_float)-0.0, "-0"));
+    utest_assert(float_str_equals((ulib_float)1.0, "1"));
+    utest_assert(float_str_equals((ulib_float)-1.5, "-1.5"));
+    utest_assert(float_str_equals((ulib_float)0.1, "0.1"));
+    utest_assert(float_str_equals((ulib_float)123.456, "123.456"));
+    utest_assert(float_str_equals((ulib_float)0.000001, "0.000001"));
+    utest_assert(float_str_equals((ulib_float)0.0000001, "1e-7"));
+    utest_assert(float_str_equals((ulib_float)1e20, "100000000000000000000"));
+    utest_assert(float_str_equals((ulib_float)1e21, "1e+21"));
+    utest_assert(float_str_equals((ulib_float)1.5e30, "1.5e+30"));
+    utest_assert(float_str_equals((ulib_float)INFINITY, "inf"));
+    utest_assert(float_str_equals((ulib_float)-INFINITY, "-inf"));
+    utest_assert(float_str_equals((ulib_float)NAN, "nan"));
+#if defined ULIB_TINY
+    utest_assert(float_str_equals(ULIB_FLOAT_MAX, "3.4028235e+38"));
+    utest_assert(float_str_equals(ULIB_FLOAT_MIN, "1e-45"));
+    // Digit generation ends deep in the fractional part, where the rounding distance is largest.
+    utest_assert(float_str_equals((ulib_float)7.92284647e28, "7.9228465e+28"));
+    // Grisu2 alone yields non-shortest digits for these.
+    utest_assert(float_str_equals((ulib_float)117760704, "117760700"));
+    utest_assert(float_str_equals((ulib_float)-36646552, "-36646550"));
+#else
+    utest_assert(float_str_equals(ULIB_FLOAT_MAX, "1.7976931348623157e+308"));
+    utest_assert(float_str_equals(ULIB_FLOAT_MIN, "5e-324"));
+    // Digit generation ends deep in the fractional part, where the rounding distance is largest.
+    utest_assert(float_str_equals((ulib_float)8.1677579565842645e-44, "8.1677579565842645e-44"));
+    // Grisu2 alone yields non-shortest digits for these.
+    utest_assert(float_str_equals((ulib_float)2.718316374298659e276, "2.718316374298659e+276"));
+    utest_assert(float_str_equals((ulib_float)6.529449870502798e16, "65294498705027980"));
+#endif
+
+    // Round trip of values spread across the whole range.
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (unsigned i = 0; i < 10000; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        ulib_float value;
+        if (sizeof(value) == sizeof(uint32_t)) {
+            uint32_t const bits = (uint32_t)(state >> 32);
+            memcpy(&value, &bits, sizeof(value));
+        } else {
+            memcpy(&value, &state, sizeof(value));
+        }
+        if (isnan(value) || isinf(value)) continue;
+
+        size_t const len = ulib_str_from_float(buf, value);
+        buf[len] = '\0';
+        utest_assert(ulib_str_to_float(buf, NULL) == value);
+    }
+
+    UStrBuf sbuf = ustrbuf();
+    utest_assert(ustrbuf_append_int(&sbuf, -7) == UVEC_OK);
+    utest_assert(ustrbuf_append_literal(&sbuf, " ") == UVEC_OK);
+    utest_assert(ustrbuf_append_uint(&sbuf, 12345) == UVEC_OK);
+    utest_assert(ustrbuf_append_literal(&sbuf, " ") == UVEC_OK);
+    utest_assert(ustrbuf_append_float(&sbuf, 2.5) == UVEC_OK);
+    UString string = ustrbuf_to_ustring(&sbuf);
+    utest_assert(ustring_equals(string, ustring_literal("-7 12345 2.5")));
+    ustring_deinit(&string);
+}
+
+static bool float_parse_matches(char const *str) {
+    ulib_float value, exp = ulib_str_to_float(str, NULL);
+    if (ulib_str_parse_float(str, strlen(str), &value)) return false;
+    return memcmp(&value, &exp, sizeof(value)) == 0;
+}
+
+void ustring_test_parse(void) {
+    ulib_int i;
+    ulib_uint u;
+    ulib_float f;
+
+    utest_assert(ustring_parse_int(ustring_literal("0"), &i) == ULIB_OK);
+    utest_assert_int(i, ==, 0);
+    utest_assert(ustring_parse_int(ustring_literal("-00123"), &i) == ULIB_OK);
+    utest_assert_int(i, ==, -123);
+    utest_assert(ustring_parse_int(ustring_literal("+12345"), &i) == ULIB_OK);
+    utest_assert_int(i, ==, 12345);
+
+    char buf[ULIB_NUM_STR_SIZE + 1];
+    size_t len = ulib_str_from_int(buf, ULIB_INT_MIN);
+    utest_assert(ulib_str_parse_int(buf, len, &i) == ULIB_OK);
+    utest_assert_int(i, ==, ULIB_INT_MIN);
+    len = ulib_str_from_int(buf, ULIB_INT_MAX);
+    utest_assert(ulib_str_parse_int(buf, len, &i) == ULIB_OK);
+    utest_assert_int(i, ==, ULIB_INT_MAX);
+    buf[len - 1]++;
+    utest_assert(ulib_str_parse_int(buf, len, &i) == ULIB_ERR);
+    len = ulib_str_from_uint(buf, ULIB_UINT_MAX);
+    utest_assert(ulib_str_parse_uint(buf, len, &u) == ULIB_OK);
+    utest_assert_uint(u, ==, ULIB_UINT_MAX);
+    buf[len - 1]++;
+    utest_assert(ulib_str_parse_uint(buf, len, &u) == ULIB_ERR);
+
+    utest_assert(ustring_parse_uint(ustring_literal("1234567890123456789012"), &u) == ULIB_ERR);
+    utest_assert(ustring_parse_uint(ustring_literal("-1"), &u) == ULIB_ERR);
+    utest_assert(ustring_parse_int(ustring_empty, &i) == ULIB_ERR);
+    utest_assert(ustring_parse_int(ustring_literal("-"), &i) == ULIB_ERR);
+    utest_assert(ustring_parse_int(ustring_literal(" 1"), &i) == ULIB_ERR);
+    utest_assert(ustring_parse_int(ustring_literal("12a"), &i) == ULIB_ERR);
+    utest_assert(ustring_parse_int(ustring_literal("1234567a"), &i) == ULIB_ERR);
+
+    // Only the specified length is parsed.
+    utest_assert(ulib_str_parse_int("4321", 2, &i) == ULIB_OK);
+    utest_assert_int(i, ==, 43);
+    utest_assert(ulib_str_parse_float("1.5e3", 3, &f) == ULIB_OK);
+    utest_assert_float(f, ==, 1.5);
+
+    char const *valid[] = {
+        "0",
+        "-0",
+        "1",
+        "+1.5",
+        ".5",
+        "5.",
+        "0.1",
+        "123.456",
+        "1e10",
+        "1E-10",
+        "-2.5e+3",
+        "0.000000000000000000000000000000000000001",
+        "123456789012345678",
+        "12345678901234567890123",
+        "9007199254740993",
+        "1e23",
+        "2.2250738585072011e-308",
+        "4.9406564584124654e-324",
+        "1.7976931348623157e308",
+        "1.7976931348623159e308",
+        "3.4028235e38",
+        "1.17549435e-38",
+        "1.4e-45",
+        "1e-400",
+        "1e400",
+        "0.30000000000000000000000000000000000000000001",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000005960464477550",
+        "7.0064923216240854e-46",
+    };
+
+    for (unsigned j = 0; j < ulib_array_count(valid); ++j) {
+        utest_assert(float_parse_matches(valid[j]));
+    }
+
+    char const *invalid[] = { "", "-", ".", "e5", "1e", "1e+", "1.2.3", "1x", " 1", "infx", "--1" };
+
+    for (unsigned j = 0; j < ulib_array_count(invalid); ++j) {
+        utest_assert(ulib_str_parse_float(invalid[j], strlen(invalid[j]), &f) == ULIB_ERR);
+    }
+
+    utest_assert(ustring_parse_float(ustring_literal("-Infinity"), &f) == ULIB_OK);
+    utest_assert(isinf(f) && f < 0);
+    utest_assert(ustring_parse_float(ustring_literal("NaN"), &f) == ULIB_OK);
+    utest_assert(isnan(f));
+
+    // Random significands and exponents, with up to 25 digits.
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    char str[64];
+
+    for (unsigned j = 0; j < 20000; ++j) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        unsigned const digits = (unsigned)(state >> 59) % 25 + 1;
+        int const exp = (int)((state >> 40) % 700) - 350;
+        char *p = str;
+
+        for (unsigned k = 0; k < digits; ++k) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            *p++ = (char)('0' + (state >> 60) % 10);
+            if (k == 0 && digits > 1) *p++ = '.';
+        }
+
+        snprintf(p, (size_t)(str + sizeof(str) - p), "e%d", exp);
+        utest_assert(float_parse_matches(str));
+    }
+}
+
+static bool utf8_is_valid_at(char const *str, size_t len, size_t offset, size_t pad) {
+    char buf[160];
+    memset(buf, 'a', sizeof(buf));
+    memcpy(buf + offset, str, len);
+    return ulib_str_is_valid_utf8(buf, offset + len + pad);
+}
+
+void ustring_test_utf8(void) {
+    static char const *const valid[] = {
+        "\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+        "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+        "a\xC3\xA8\xE2\x82\xAC\xF0\x9F\x98\x80z",
+    };
+    static char const *const invalid[] = {
+        "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41", "\xE0\x80\x80", "\xE0\x9F\xBF",
+        "\xE2\x82", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+        "\xF0\x9F\x98", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF",
+        "\xC2\xA9\x80", "\xE2\x82\xAC\xAC",
+    };
+
+    utest_assert(ustring_is_valid_utf8(ustring_empty));
+    utest_assert(ustring_is_valid_utf8(ustring_literal("ASCII only")));
+
+    // Sequences are checked at every offset, so that they cross the boundaries of vectors.
+    for (size_t offset = 0; offset < 80; ++offset) {
+        for (size_t i = 0; i < ulib_array_count(valid); ++i) {
+            size_t const len = strlen(valid[i]);
+            utest_assert(utf8_is_valid_at(valid[i], len, offset, 0));
+            utest_assert(utf8_is_valid_at(valid[i], len, offset, 40));
+        }
+        for (size_t i = 0; i < ulib_array_count(invalid); ++i) {
+            size_t const len = strlen(invalid[i]);
+            utest_assert_false(utf8_is_valid_at(invalid[i], len, offset, 0));
+            utest_assert_false(utf8_is_valid_at(invalid[i], len, offset, 40));
+        }
+    }
+
+    // Compare the validator against the decoder on all short sequences of boundary bytes.
+    static unsigned char const bytes[] = {
+        0x00, 0x41, 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0,
+        0xC1, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF,
+    };
+    size_t const count = ulib_array_count(bytes);
+    uint16_t units[8];
+
+    for (size_t i = 0; i < count * count * count * count; ++i) {
+        char seq[4];
+        for (size_t j = 0, k = i; j < 4; ++j, k /= count) seq[j] = (char)bytes[k % count];
+        bool const exp = ulib_str_utf8_to_utf16(seq, 4, units, NULL) == ULIB_OK;
+        utest_assert(ulib_str_is_valid_utf8(seq, 4) == exp);
+        utest_assert(utf8_is_valid_at(seq, 4, 14, 0) == exp);
+        utest_assert(utf8_is_valid_at(seq, 4, 30, 1) == exp);
+    }
+
+    // Code point counting and transcoding.
+    UString str = ustring_literal("a\xC3\xA8\xE2\x82\xAC\xF0\x9F\x98\x80z");
+    uint16_t const exp_units[] = { 'a', 0xE8, 0x20AC, 0xD83D, 0xDE00, 'z', 0 };
+    utest_assert_uint(ustring_utf8_length(str), ==, 5);
+    utest_assert_uint(ustring_utf8_length(ustring_empty), ==, 0);
+
+    size_t length;
+    uint16_t *utf16 = ustring_to_utf16(str, &length);
+    utest_assert_not_null(utf16);
+    utest_assert_uint(length, ==, 6);
+    utest_assert_buf(utf16, ==, exp_units, sizeof(exp_units));
+    utest_assert_uint(ulib_str_utf8_length_from_utf16(utf16, length), ==, ustring_length(str));
+
+    UString back = ustring_from_utf16(utf16, length);
+    utest_assert_ustring(back, ==, str);
+    ustring_deinit(&back);
+    ulib_free(utf16);
+
+    utest_assert_ptr(ustring_to_utf16(ustring_literal("a\xC0\x80"), NULL), ==, NULL);
+
+    uint16_t const unpaired[][2] = { { 0xD800, 'a' }, { 0xDC00, 0xD800 }, { 'a', 0xD83D } };
+    for (size_t i = 0; i < ulib_array_count(unpaired); ++i) {
+        utest_assert(ustring_is_null(ustring_from_utf16(unpaired[i], 2)));
+    }
+
+    // Longer strings, exercising the vectorized paths.
+    UStrBuf buf = ustrbuf();
+    for (unsigned i = 0; i < 300; ++i) ustrbuf_append_ustring(&buf, str);
+    str = ustrbuf_to_ustring(&buf);
+    utest_assert(ustring_is_valid_utf8(str));
+    utest_assert_uint(ustring_utf8_length(str), ==, 300 * 5);
+
+    utf16 = ustring_to_utf16(str, &length);
+    utest_assert_uint(length, ==, 300 * 6);
+    back = ustring_from_utf16(utf16, length);
+    utest_assert_ustring(back, ==, str);
+    ustring_deinit(&back);
+    ulib_free(utf16);
+
+    ((char *)ustring_data(str))[1000] = '\xFF';
+    utest_assert_false(ustring_is_valid_utf8(str));
+    ustring_deinit(&str);
+
+    // ASCII runs of every length up to a few vectors, separated by non-ASCII code points.
+    for (unsigned i = 0; i < 70; ++i) {
+        for (unsigned j = 0; j < i; ++j) uvec_push(char, &buf, (char)('a' + j % 26));
+        ustrbuf_append_literal(&buf, "\xC3\xA8");
+    }
+    str = ustrbuf_to_ustring(&buf);
+    utest_assert_uint(ustring_utf8_length(str), ==, 70 * 69 / 2 + 70);
+
+    utf16 = ustring_to_utf16(str, &length);
+    utest_assert_uint(length, ==, 70 * 69 / 2 + 70);
+    utest_assert_uint(utf16[0], ==, 0xE8);
+    utest_assert_uint(utf16[length - 2], ==, 'a' + 68 % 26);
+    back = ustring_from_utf16(utf16, length);
+    utest_assert_ustring(back, ==, str);
+    ustring_deinit(&back);
+
+    // Unpaired surrogates after a long ASCII run.
+    size_t written;
+    utf16[length - 1] = 0xDC00;
+    char *out = (char *)ulib_malloc(ustring_length(str));
+    utest_assert(ulib_str_utf16_to_utf8(utf16, length, out, &written) == ULIB_ERR);
+    utest_assert_uint(written, ==, ustring_length(str) - 2);
+    utest_assert_buf(out, ==, ustring_data(str), written);
+    ulib_free(out);
+    ulib_free(utf16);
+    ustring_deinit(&str);
+}
+
 void ustrbuf_test(void) {
     UStrBuf buf = ustrbuf();
     uvec_ret ret;
@@ -170,6 +638,23 @@ void ustring_test_base(void) {
     utest_assert_uint(ustring_hash(a), ==, ustring_hash(ustring_literal(str)));
     utest_assert_uint(ustring_hash(a), !=, ustring_hash(ustring_literal("012345678")));
 
+    UString c = ustring_copy_literal("Content-Type");
+    utest_assert(ustring_equals_ignore_case(c, ustring_literal("content-type")));
+    utest_assert(ustring_equals_ignore_case(c, ustring_literal("CONTENT-TYPE")));
+    utest_assert_false(ustring_equals_ignore_case(c, ustring_literal("content_type")));
+    utest_assert_false(ustring_equals_ignore_case(c, ustring_literal("content-typ")));
+    ulib_uint const hash = ustring_hash(ustring_literal("content-type"));
+    utest_assert_uint(ustring_hash_ignore_case(c), ==, hash);
+    ustring_deinit(&c);
+
+    c = ustring_repeating(ustring_literal("AbCdEfGhIj"), 20);
+    UString d = ustring_to_lower(c);
+    utest_assert(ustring_equals_ignore_case(c, d));
+    utest_assert_uint(ustring_hash_ignore_case(c), ==, ustring_hash(d));
+    utest_assert_uint(ustring_hash_ignore_case(c), ==, ustring_hash_ignore_case(d));
+    ustring_deinit(&c);
+    ustring_deinit(&d);
+
     UString b = ustring_dup(a);
     utest_assert_ustring(a, ==, b);
     utest_assert_ptr(ustring_data(a), !=, ustring_data(b));
@@ -267,3 +752,76 @@ void ustring_test_sso(void) {
     utest_assert_uint(ustring_length(a), ==, n * 10);
     ustring_deinit(&a);
 }
+
+void ustring_test_shared(void) {
+    UString a = ustring_repeating(ustring_literal("abcdefghij"), 10);
+    utest_assert(p_ustring_is_shared(a));
+
+    // Duplicates share the buffer and outlive the original.
+    UString b = ustring_dup(a);
+    UString c = ustring_dup(b);
+    utest_assert_ptr(ustring_data(b), ==, ustring_data(a));
+    utest_assert_ptr(ustring_data(c), ==, ustring_data(a));
+    utest_assert_ustring(b, ==, a);
+
+    UString d = ustring_copy(ustring_data(a), ustring_length(a));
+    utest_assert_ptr(ustring_data(d), !=, ustring_data(a));
+    utest_assert_ustring(d, ==, a);
+    ustring_deinit(&d);
+
+    ustring_deinit(&a);
+    utest_assert_uint(ustring_length(b), ==, 100);
+    utest_assert(ustring_starts_with(c, ustring_literal("abcdefghij")));
+
+    // Returning the data of shared strings copies the buffer if it is still referenced.
+    char *data = ustring_deinit_return_data(&b);
+    utest_assert_not_null(data);
+    utest_assert_ptr(data, !=, ustring_data(c));
+    utest_assert_uint(strlen(data), ==, 100);
+    ulib_free(data);
+
+    // The last reference hands over the buffer without copying it.
+    char const *c_data = ustring_data(c);
+    data = ustring_deinit_return_data(&c);
+    utest_assert_ptr(data, ==, c_data);
+    utest_assert_uint(strlen(data), ==, 100);
+    utest_assert(memcmp(data, "abcdefghij", 10) == 0);
+
+    // Strings that own foreign buffers are not shared, but their duplicates are.
+    a = ustring_assign(data, 100);
+    utest_assert_false(p_ustring_is_shared(a));
+    b = ustring_dup(a);
+    utest_assert(p_ustring_is_shared(b));
+    utest_assert_ptr(ustring_data(b), !=, ustring_data(a));
+    utest_assert_ustring(b, ==, a);
+    c = ustring_dup(b);
+    utest_assert_ptr(ustring_data(c), ==, ustring_data(b));
+    ustring_deinit(&a);
+    ustring_deinit(&b);
+    ustring_deinit(&c);
+
+    // Deinitialized strings are no longer shared, and can be deinitialized or duplicated again.
+    a = ustring_copy("0123456789012345678901234567890123456789", 40);
+    ustring_deinit(&a);
+    utest_assert_false(p_ustring_is_shared(a));
+    ustring_deinit(&a);
+    b = ustring_dup(a);
+    utest_assert_false(p_ustring_is_shared(b));
+    ustring_deinit(&b);
+
+    // Small strings are never shared.
+    a = ustring_literal("small");
+    b = ustring_dup(a);
+    utest_assert_false(p_ustring_is_shared(b));
+    ustring_deinit(&b);
+
+    // Lengths that would overlap the shared flag are rejected, without reading the buffer.
+    size_t const max = P_USTRING_SIZE_MASK - 1;
+    a = ustring_wrap("large", max);
+    utest_assert_uint(ustring_length(a), ==, max);
+    utest_assert_false(p_ustring_is_shared(a));
+    utest_assert(ustring_is_null(ustring_wrap("large", max + 1)));
+    utest_assert(ustring_is_null(ustring_assign((char *)ulib_malloc(1), max + 1)));
+    utest_assert_ptr(ustring(&a, max + 1), ==, NULL);
+    utest_assert(ustring_is_null(a));
+}
@@ -11,12 +11,20 @@
 #include <stdbool.h>
 
 void ustring_utils_test(void);
+void ustring_test_search(void);
+void ustring_test_split(void);
+void ustring_test_num(void);
+void ustring_test_parse(void);
+void ustring_test_utf8(void);
 void ustrbuf_test(void);
 void ustring_test_base(void);
 void ustring_test_convert(void);
 void ustring_test_sso(void);
+void ustring_test_shared(void);
 
 #define USTRING_TESTS                                                                              \
-    ustring_utils_test, ustrbuf_test, ustring_test_base, ustring_test_convert, ustring_test_sso
+    ustring_utils_test, ustring_test_search, ustring_test_split, ustring_test_num,                 \
+        ustring_test_parse, ustring_test_utf8, ustrbuf_test, ustring_test_base,                    \
+        ustring_test_convert, ustring_test_sso, ustring_test_shared
 
 #endif // USTRING_TESTS_H
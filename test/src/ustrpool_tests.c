@@ -0,0 +1,90 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#include "ustrpool_tests.h"
+#include "ulib.h"
+
+enum { STRING_COUNT = 1000, DISTINCT_COUNT = 250 };
+
+static UString test_string(ulib_uint i) {
+    // Alternate small and large strings.
+    return i % 2 ? ustring_with_format("%u", (unsigned)i)
+                 : ustring_with_format("a somewhat longer string, number %u", (unsigned)i);
+}
+
+void ustrpool_test_base(void) {
+    UStrPool pool = ustrpool();
+    utest_assert_uint(ustrpool_count(&pool), ==, 0);
+    utest_assert(ustrsym_is_null(ustrpool_lookup(&pool, ustring_literal("test"))));
+
+    UStrSym syms[DISTINCT_COUNT];
+
+    for (ulib_uint i = 0; i < STRING_COUNT; ++i) {
+        ulib_uint const idx = i % DISTINCT_COUNT;
+        UString str = test_string(idx);
+        UStrSym sym = ustrpool_intern(&pool, str);
+        utest_assert_false(ustrsym_is_null(sym));
+
+        if (i < DISTINCT_COUNT) {
+            syms[idx] = sym;
+            utest_assert_uint(ustrsym_id(sym), ==, i);
+        } else {
+            utest_assert(ustrsym_equals(sym, syms[idx]));
+        }
+
+        utest_assert_ustring(ustrsym_string(sym), ==, str);
+        ustring_deinit(&str);
+    }
+
+    utest_assert_uint(ustrpool_count(&pool), ==, DISTINCT_COUNT);
+
+    for (ulib_uint i = 0; i < DISTINCT_COUNT; ++i) {
+        UString str = test_string(i);
+        UStrSym sym = ustrpool_lookup(&pool, str);
+        utest_assert(ustrsym_equals(sym, syms[i]));
+        utest_assert(ustrsym_equals(ustrpool_get(&pool, i), syms[i]));
+        utest_assert_uint(ustrsym_hash(sym), ==, ustring_hash(str));
+        ustring_deinit(&str);
+
+        // Large canonical strings share their buffer.
+        if (i % 2 == 0) {
+            UString canonical = ustrsym_string(sym);
+            utest_assert_ptr(ustring_data(canonical), ==, ustring_data(ustrsym_string(syms[i])));
+        }
+    }
+
+    utest_assert(ustrsym_is_null(ustrpool_lookup(&pool, ustring_literal("missing"))));
+
+    // Strings exceeding the chunk size.
+    UString large = ustring_repeating(ustring_literal("0123456789"), USTRPOOL_CHUNK_SIZE / 8);
+    UStrSym sym = ustrpool_intern(&pool, large);
+    utest_assert_false(ustrsym_is_null(sym));
+    utest_assert_ustring(ustrsym_string(sym), ==, large);
+    utest_assert(ustrsym_equals(ustrpool_intern(&pool, large), sym));
+    utest_assert(ustrsym_equals(ustrpool_intern(&pool, ustrsym_string(syms[3])), syms[3]));
+    ustring_deinit(&large);
+
+    ustrpool_deinit(&pool);
+}
+
+void ustrpool_test_hash(void) {
+    UStrPool pool = ustrpool();
+    UHash(UStrSym) map = uhmap(UStrSym);
+
+    UStrSym a = ustrpool_intern(&pool, ustring_literal("Content-Type"));
+    UStrSym b = ustrpool_intern(&pool, ustring_literal("Content-Length"));
+    utest_assert(uhmap_set(UStrSym, &map, a, (ulib_ptr)1, NULL) == UHASH_INSERTED);
+    utest_assert(uhmap_set(UStrSym, &map, b, (ulib_ptr)2, NULL) == UHASH_INSERTED);
+
+    UStrSym c = ustrpool_intern(&pool, ustring_literal("Content-Type"));
+    utest_assert_ptr(uhmap_get(UStrSym, &map, c, NULL), ==, (ulib_ptr)1);
+    c = ustrpool_lookup(&pool, ustring_literal("Content-Length"));
+    utest_assert_ptr(uhmap_get(UStrSym, &map, c, NULL), ==, (ulib_ptr)2);
+
+    uhash_deinit(UStrSym, &map);
+    ustrpool_deinit(&pool);
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Ivano Bilenchi
+ *
+ * @copyright Copyright (c) 2025 Ivano Bilenchi <https://ivanobilenchi.com>
+ * @copyright SPDX-License-Identifier: ISC
+ */
+
+#ifndef USTRPOOL_TESTS_H
+#define USTRPOOL_TESTS_H
+
+#include <stdbool.h>
+
+void ustrpool_test_base(void);
+void ustrpool_test_hash(void);
+
+#define USTRPOOL_TESTS ustrpool_test_base, ustrpool_test_hash
+
+#endif // USTRPOOL_TESTS_H
@@ -31,6 +31,38 @@
 #define VTYPE int
 UVEC_INIT_IDENTIFIABLE(VTYPE)
 
+typedef int int_exact;
+typedef int int_grow;
+
+#undef UVEC_GROWTH_POLICY
+#define UVEC_GROWTH_POLICY UVEC_GROWTH_EXACT
+UVEC_INIT(int_exact)
+#undef UVEC_GROWTH_POLICY
+#define UVEC_GROWTH_POLICY UVEC_GROWTH_1_5X
+UVEC_INIT(int_grow)
+#undef UVEC_GROWTH_POLICY
+#define UVEC_GROWTH_POLICY UVEC_GROWTH_POW2
+
+// McIlroy's quicksort adversary: items are indices whose values are only fixed when compared,
+// which drives median-of-three quickselect into its quadratic worst case.
+typedef ulib_uint adv_item;
+static ulib_uint *adv_val, adv_gas, adv_solid, adv_candidate, adv_cmps;
+
+static bool adv_less(adv_item x, adv_item y) {
+    ++adv_cmps;
+    if (adv_val[x] == adv_gas && adv_val[y] == adv_gas) {
+        adv_val[x == adv_candidate ? x : y] = adv_solid++;
+    }
+    if (adv_val[x] == adv_gas) {
+        adv_candidate = x;
+    } else if (adv_val[y] == adv_gas) {
+        adv_candidate = y;
+    }
+    return adv_val[x] < adv_val[y];
+}
+
+UVEC_INIT_COMPARABLE(adv_item, ulib_eq, adv_less)
+
 void uvec_test_base(void) {
     UVec(VTYPE) v = uvec(VTYPE);
     utest_assert_uint(uvec_count(VTYPE, &v), ==, 0);
@@ -179,6 +211,42 @@ void uvec_test_capacity(void) {
     uvec_deinit(VTYPE, &v);
 }
 
+void uvec_test_growth(void) {
+    UVec(VTYPE) v = uvec(VTYPE);
+    utest_assert(uvec_reserve_exact(VTYPE, &v, 65) == UVEC_OK);
+    utest_assert_uint(uvec_size(VTYPE, &v), ==, 65);
+    utest_assert(uvec_reserve(VTYPE, &v, 66) == UVEC_OK);
+    utest_assert_uint(uvec_size(VTYPE, &v), ==, 128);
+    uvec_deinit(VTYPE, &v);
+
+    UVec(int_exact) ev = uvec(int_exact);
+    for (int i = 0; i < 1000; ++i) {
+        utest_assert(uvec_push(int_exact, &ev, i) == UVEC_OK);
+        utest_assert_uint(uvec_size(int_exact, &ev), >=, uvec_count(int_exact, &ev));
+    }
+    utest_assert_uint(uvec_size(int_exact, &ev), ==, 1000);
+    utest_assert(uvec_reserve(int_exact, &ev, 10007) == UVEC_OK);
+    utest_assert_uint(uvec_size(int_exact, &ev), >=, 10007);
+    utest_assert_uint(uvec_size(int_exact, &ev), <=, 10007 + 10007 / 256);
+    for (int i = 0; i < 1000; ++i) {
+        utest_assert_int(uvec_get(int_exact, &ev, (ulib_uint)i), ==, i);
+    }
+    uvec_deinit(int_exact, &ev);
+
+    UVec(int_grow) gv = uvec(int_grow);
+    utest_assert(uvec_reserve(int_grow, &gv, 100) == UVEC_OK);
+    utest_assert_uint(uvec_size(int_grow, &gv), ==, 100);
+    utest_assert(uvec_reserve(int_grow, &gv, 101) == UVEC_OK);
+    utest_assert_uint(uvec_size(int_grow, &gv), ==, 150);
+    for (int i = 0; i < 1000; ++i) {
+        utest_assert(uvec_push(int_grow, &gv, i) == UVEC_OK);
+    }
+    utest_assert_uint(uvec_count(int_grow, &gv), ==, 1000);
+    utest_assert(uvec_shrink(int_grow, &gv) == UVEC_OK);
+    utest_assert_uint(uvec_size(int_grow, &gv), ==, 1000);
+    uvec_deinit(int_grow, &gv);
+}
+
 void uvec_test_storage(void) {
     VTYPE s_array[32] = { 1, 2, 3 };
     UVec(VTYPE) vec = uvec_wrap(VTYPE, s_array, 3);
@@ -338,6 +406,190 @@ void uvec_test_comparable(void) {
     uvec_deinit(VTYPE, &values);
 }
 
+void uvec_test_sorted_search(void) {
+    UVec(VTYPE) v = uvec(VTYPE);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 0), ==, 0);
+    utest_assert_uint(uvec_eytzinger_index_of(VTYPE, &v, 0), ==, 0);
+
+    uvec_append_items(VTYPE, &v, 1, 2, 2, 2, 3, 4, 5, 5, 6);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 1), ==, 0);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 2), ==, 1);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 5), ==, 6);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 6), ==, 8);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 0), ==, 9);
+    utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, 7), ==, 9);
+
+    for (ulib_uint count = 1; count < 100; ++count) {
+        uvec_clear(VTYPE, &v);
+        for (ulib_uint i = 0; i < count; ++i) {
+            uvec_push(VTYPE, &v, (VTYPE)(i * 2 + 1));
+        }
+
+        for (ulib_uint i = 0; i < count; ++i) {
+            VTYPE const item = (VTYPE)(i * 2 + 1);
+            utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, item), ==, i);
+            utest_assert_uint(uvec_sorted_index_of_branchless(VTYPE, &v, item - 1), ==, count);
+        }
+
+        utest_assert(uvec_eytzinger(VTYPE, &v) == UVEC_OK);
+        utest_assert_uint(uvec_count(VTYPE, &v), ==, count);
+
+        for (ulib_uint i = 0; i < count; ++i) {
+            VTYPE const item = (VTYPE)(i * 2 + 1);
+            ulib_uint idx = uvec_eytzinger_index_of(VTYPE, &v, item);
+            utest_assert(uvec_index_is_valid(VTYPE, &v, idx));
+            utest_assert_int(uvec_get(VTYPE, &v, idx), ==, item);
+            idx = uvec_eytzinger_index_of(VTYPE, &v, item - 1);
+            utest_assert_false(uvec_index_is_valid(VTYPE, &v, idx));
+        }
+
+        utest_assert_false(uvec_index_is_valid(VTYPE, &v, uvec_eytzinger_index_of(VTYPE, &v, 0)));
+        utest_assert_false(
+            uvec_index_is_valid(VTYPE, &v, uvec_eytzinger_index_of(VTYPE, &v, (VTYPE)count * 2)));
+    }
+
+    uvec_deinit(VTYPE, &v);
+}
+
+void uvec_test_sorted_set_ops(void) {
+    UVec(VTYPE) a = uvec(VTYPE);
+    UVec(VTYPE) b = uvec(VTYPE);
+    UVec(VTYPE) r = uvec(VTYPE);
+
+    utest_assert(uvec_sorted_intersect(VTYPE, &a, &b, &r) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &r), ==, 0);
+
+    uvec_append_items(VTYPE, &a, 1, 2, 4, 5, 7, 9);
+    uvec_append_items(VTYPE, &b, 2, 3, 5, 6, 9, 10);
+
+    utest_assert(uvec_sorted_intersect(VTYPE, &a, &b, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, 2, 5, 9);
+    utest_assert(uvec_sorted_union(VTYPE, &a, &b, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, 1, 2, 3, 4, 5, 6, 7, 9, 10);
+    utest_assert(uvec_sorted_diff(VTYPE, &a, &b, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, 1, 4, 7);
+    utest_assert(uvec_sorted_diff(VTYPE, &b, &a, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, 3, 6, 10);
+
+    ulib_uint indexes[3];
+    uvec_clear(VTYPE, &b);
+    uvec_append_items(VTYPE, &b, 0, 4, 9);
+    uvec_sorted_index_of_many(VTYPE, &a, &b, indexes);
+    utest_assert_uint(indexes[0], ==, uvec_count(VTYPE, &a));
+    utest_assert_uint(indexes[1], ==, 2);
+    utest_assert_uint(indexes[2], ==, 5);
+
+    // Skewed sizes, exercising galloping
+    uvec_clear(VTYPE, &a);
+    for (VTYPE i = 0; i < (VTYPE)UVEC_GALLOP_RATIO * 20; ++i) {
+        uvec_push(VTYPE, &a, i * 2);
+    }
+    uvec_clear(VTYPE, &b);
+    uvec_append_items(VTYPE, &b, -1, 2, 3, 100, 101, 200);
+
+    utest_assert(uvec_sorted_intersect(VTYPE, &a, &b, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, 2, 100, 200);
+    utest_assert(uvec_sorted_intersect(VTYPE, &b, &a, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, 2, 100, 200);
+
+    utest_assert(uvec_sorted_diff(VTYPE, &b, &a, &r) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &r, -1, 3, 101);
+
+    utest_assert(uvec_sorted_diff(VTYPE, &a, &b, &r) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &r), ==, uvec_count(VTYPE, &a) - 3);
+    uvec_foreach (VTYPE, &r, loop) {
+        utest_assert_false(uvec_contains(VTYPE, &b, *loop.item));
+    }
+
+    utest_assert(uvec_sorted_union(VTYPE, &a, &b, &r) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &r), ==, uvec_count(VTYPE, &a) + 3);
+    utest_assert_int(uvec_first(VTYPE, &r), ==, -1);
+    utest_assert(uvec_sorted_contains(VTYPE, &r, 3));
+    utest_assert(uvec_sorted_contains(VTYPE, &r, 101));
+    uvec_foreach (VTYPE, &r, loop) {
+        if (loop.i) utest_assert_int(*loop.item, >, uvec_get(VTYPE, &r, loop.i - 1));
+    }
+
+#if defined ULIB_TINY
+    // The union of these vectors cannot be represented.
+    uvec_clear(VTYPE, &a);
+    uvec_clear(VTYPE, &b);
+    for (VTYPE i = 0; i <= (VTYPE)(ULIB_UINT_MAX / 2); ++i) {
+        utest_assert(uvec_push(VTYPE, &a, 2 * i) == UVEC_OK);
+        utest_assert(uvec_push(VTYPE, &b, 2 * i + 1) == UVEC_OK);
+    }
+    utest_assert(uvec_sorted_union(VTYPE, &a, &b, &r) == UVEC_ERR);
+#endif
+
+    uvec_deinit(VTYPE, &a);
+    uvec_deinit(VTYPE, &b);
+    uvec_deinit(VTYPE, &r);
+}
+
+enum { INSERT_ALL_COUNT = 100 };
+
+void uvec_test_sorted_insert_all(void) {
+    UVec(VTYPE) v = uvec(VTYPE);
+    UVec(VTYPE) src = uvec(VTYPE);
+
+    VTYPE const items[] = { 5, 1, 3, 3 };
+    utest_assert(uvec_sorted_insert_all(VTYPE, &v, items, ulib_array_count(items)) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &v, 1, 3, 3, 5);
+
+    VTYPE const more[] = { 6, 0, 3, 4 };
+    utest_assert(uvec_sorted_insert_all(VTYPE, &v, more, ulib_array_count(more)) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &v, 0, 1, 3, 3, 3, 4, 5, 6);
+
+    uvec_clear(VTYPE, &v);
+    uvec_append_items(VTYPE, &v, 1, 3, 5);
+    VTYPE const unique[] = { 7, 3, 2, 2, 0, 5 };
+    uvec_ret ret = uvec_sorted_unique_insert_all(VTYPE, &v, unique, ulib_array_count(unique));
+    utest_assert(ret == UVEC_OK);
+    uvec_assert_elements(VTYPE, &v, 0, 1, 2, 3, 5, 7);
+
+    ret = uvec_sorted_unique_insert_all(VTYPE, &v, unique, ulib_array_count(unique));
+    utest_assert(ret == UVEC_NO);
+    uvec_assert_elements(VTYPE, &v, 0, 1, 2, 3, 5, 7);
+
+    uvec_append_items(VTYPE, &src, -1, 2, 4, 8, 8);
+    utest_assert(uvec_sorted_unique_merge(VTYPE, &v, &src) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &v, -1, 0, 1, 2, 3, 4, 5, 7, 8);
+
+    utest_assert(uvec_sorted_merge(VTYPE, &v, &src) == UVEC_OK);
+    uvec_assert_elements(VTYPE, &v, -1, -1, 0, 1, 2, 2, 3, 4, 4, 5, 7, 8, 8, 8);
+
+    // Large batches
+    uvec_clear(VTYPE, &v);
+    uvec_clear(VTYPE, &src);
+    for (unsigned i = 0; i < INSERT_ALL_COUNT; ++i) {
+        VTYPE const item = (VTYPE)(urand() % 100);
+        uvec_push(VTYPE, &src, item);
+        utest_assert(uvec_sorted_insert_all(VTYPE, &v, &item, 1) == UVEC_OK);
+    }
+    utest_assert(uvec_sorted_insert_all(VTYPE, &v, uvec_data(VTYPE, &src), 0) == UVEC_OK);
+    utest_assert(uvec_sorted_insert_all(VTYPE, &v, uvec_data(VTYPE, &src),
+                                        uvec_count(VTYPE, &src)) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, INSERT_ALL_COUNT * 2);
+    uvec_foreach (VTYPE, &v, loop) {
+        if (loop.i) utest_assert_int(*loop.item, >=, uvec_get(VTYPE, &v, loop.i - 1));
+    }
+
+#if defined ULIB_TINY
+    // The merged vector cannot be represented.
+    uvec_clear(VTYPE, &v);
+    uvec_clear(VTYPE, &src);
+    for (VTYPE i = 0; i <= (VTYPE)(ULIB_UINT_MAX / 2); ++i) {
+        utest_assert(uvec_push(VTYPE, &v, 2 * i) == UVEC_OK);
+        utest_assert(uvec_push(VTYPE, &src, 2 * i + 1) == UVEC_OK);
+    }
+    utest_assert(uvec_sorted_merge(VTYPE, &v, &src) == UVEC_ERR);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, ULIB_UINT_MAX / 2 + 1);
+#endif
+
+    uvec_deinit(VTYPE, &v);
+    uvec_deinit(VTYPE, &src);
+}
+
 enum { SORT_COUNT = 1000 };
 
 static int vtype_compare(void const *a, void const *b) {
@@ -380,6 +632,75 @@ void uvec_test_sort(void) {
     uvec_deinit(VTYPE, &v);
 }
 
+void uvec_test_selection(void) {
+    VTYPE array[SORT_COUNT];
+    UVec(VTYPE) v = uvec(VTYPE);
+    UVec(VTYPE) top = uvec(VTYPE);
+
+    for (unsigned i = 0; i < SORT_COUNT; ++i) {
+        array[i] = (VTYPE)(urand() % (SORT_COUNT / 4));
+    }
+    uvec_append_array(VTYPE, &v, array, SORT_COUNT);
+    qsort(array, SORT_COUNT, sizeof(*array), vtype_compare);
+
+    ulib_uint const nths[] = { 0, 1, SORT_COUNT / 3, SORT_COUNT / 2, SORT_COUNT - 1 };
+    for (unsigned i = 0; i < ulib_array_count(nths); ++i) {
+        ulib_uint const nth = nths[i];
+        uvec_nth_element(VTYPE, &v, nth);
+        VTYPE const item = uvec_get(VTYPE, &v, nth);
+        utest_assert_int(item, ==, array[nth]);
+        uvec_foreach (VTYPE, &v, loop) {
+            if (loop.i < nth) utest_assert_int(*loop.item, <=, item);
+            if (loop.i > nth) utest_assert_int(*loop.item, >=, item);
+        }
+        uvec_shuffle(VTYPE, &v);
+    }
+
+    uvec_partial_sort(VTYPE, &v, 10);
+    utest_assert_buf(uvec_data(VTYPE, &v), ==, array, 10 * sizeof(*array));
+    uvec_partial_sort(VTYPE, &v, SORT_COUNT * 2);
+    uvec_assert_elements_array(VTYPE, &v, array);
+    uvec_shuffle(VTYPE, &v);
+
+    ulib_uint const ks[] = { 0, 1, 10, SORT_COUNT / 2, SORT_COUNT, SORT_COUNT * 2 };
+    for (unsigned i = 0; i < ulib_array_count(ks); ++i) {
+        ulib_uint const k = ulib_min(ks[i], SORT_COUNT);
+        utest_assert(uvec_top_k(VTYPE, &v, ks[i], &top) == UVEC_OK);
+        utest_assert_uint(uvec_count(VTYPE, &top), ==, k);
+        uvec_foreach (VTYPE, &top, loop) {
+            utest_assert_int(*loop.item, ==, array[SORT_COUNT - 1 - loop.i]);
+        }
+    }
+
+    uvec_deinit(VTYPE, &v);
+    uvec_deinit(VTYPE, &top);
+
+    // Adversarial input: the heapsort fallback must keep selection at O(n log n).
+    ulib_uint const n = 4096, nth = n / 2;
+    UVec(adv_item) adv = uvec(adv_item);
+    adv_val = (ulib_uint *)ulib_alloc_array(adv_val, n);
+    utest_assert_fatal(adv_val);
+    adv_gas = n;
+    adv_solid = adv_candidate = adv_cmps = 0;
+
+    for (ulib_uint i = 0; i < n; ++i) {
+        adv_val[i] = adv_gas;
+        utest_assert(uvec_push(adv_item, &adv, i) == UVEC_OK);
+    }
+
+    uvec_nth_element(adv_item, &adv, nth);
+    utest_assert_uint(adv_cmps, <, 16 * n * ulib_uint_log2(n));
+
+    ulib_uint const val = adv_val[uvec_get(adv_item, &adv, nth)];
+    uvec_foreach (adv_item, &adv, loop) {
+        if (loop.i < nth) utest_assert_uint(adv_val[*loop.item], <=, val);
+        if (loop.i > nth) utest_assert_uint(adv_val[*loop.item], >=, val);
+    }
+
+    uvec_deinit(adv_item, &adv);
+    ulib_free(adv_val);
+}
+
 void uvec_test_max_heapq(void) {
     VTYPE const arr[] = { 5, 6, 2, 2, 3, 7, 9, 8, 9, 4, 1 };
     VTYPE const max[] = { 5, 6, 6, 6, 6, 7, 9, 9, 9, 9, 9 };
@@ -497,3 +818,253 @@ void uvec_test_min_heapq(void) {
 
     uvec_deinit(VTYPE, &heap);
 }
+
+static bool is_multiple(void *ctx, VTYPE item) {
+    return item % *(VTYPE *)ctx == 0;
+}
+
+void uvec_test_remove_if(void) {
+    UVec(VTYPE) v = uvec(VTYPE);
+    VTYPE n = 3;
+
+    utest_assert_uint(uvec_remove_if(VTYPE, &v, is_multiple, &n), ==, 0);
+    utest_assert_uint(uvec_retain_if(VTYPE, &v, is_multiple, &n), ==, 0);
+
+    uvec_append_items(VTYPE, &v, 1, 3, 4, 6, 7, 9, 10, 12);
+    utest_assert_uint(uvec_remove_if(VTYPE, &v, is_multiple, &n), ==, 4);
+    uvec_assert_elements(VTYPE, &v, 1, 4, 7, 10);
+
+    n = 2;
+    utest_assert_uint(uvec_retain_if(VTYPE, &v, is_multiple, &n), ==, 2);
+    uvec_assert_elements(VTYPE, &v, 4, 10);
+
+    n = 5;
+    utest_assert_uint(uvec_retain_if(VTYPE, &v, is_multiple, &n), ==, 1);
+    uvec_assert_elements(VTYPE, &v, 10);
+
+    n = 1;
+    utest_assert_uint(uvec_remove_if(VTYPE, &v, is_multiple, &n), ==, 1);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, 0);
+
+    utest_assert_uint(uvec_sorted_dedup(VTYPE, &v), ==, 0);
+    uvec_append_items(VTYPE, &v, 1);
+    utest_assert_uint(uvec_sorted_dedup(VTYPE, &v), ==, 0);
+    uvec_assert_elements(VTYPE, &v, 1);
+
+    uvec_append_items(VTYPE, &v, 2, 3);
+    utest_assert_uint(uvec_sorted_dedup(VTYPE, &v), ==, 0);
+    uvec_assert_elements(VTYPE, &v, 1, 2, 3);
+
+    uvec_append_items(VTYPE, &v, 3, 3, 4, 5, 5, 6);
+    utest_assert_uint(uvec_sorted_dedup(VTYPE, &v), ==, 3);
+    uvec_assert_elements(VTYPE, &v, 1, 2, 3, 4, 5, 6);
+
+    uvec_clear(VTYPE, &v);
+    for (VTYPE i = 0; i < 1000; ++i) {
+        uvec_push(VTYPE, &v, i / 10);
+    }
+    utest_assert_uint(uvec_sorted_dedup(VTYPE, &v), ==, 900);
+    for (VTYPE i = 0; i < 100; ++i) {
+        utest_assert_int(uvec_get(VTYPE, &v, (ulib_uint)i), ==, i);
+    }
+
+    uvec_deinit(VTYPE, &v);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static void uvec_test_map_file_contents(char const *path) {
+    enum { MAP_COUNT = 10000 };
+
+    UVec(VTYPE) v;
+    utest_assert(uvec_map_file(VTYPE, &v, path, UVEC_MAP_CREATE) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, 0);
+
+    for (VTYPE i = 0; i < MAP_COUNT; ++i) {
+        utest_assert(uvec_push(VTYPE, &v, i) == UVEC_OK);
+    }
+
+    utest_assert_uint(uvec_size(VTYPE, &v), >=, MAP_COUNT);
+    utest_assert(uvec_sync(VTYPE, &v) == UVEC_OK);
+    utest_assert(uvec_unmap(VTYPE, &v) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, 0);
+
+    utest_assert(uvec_map_file(VTYPE, &v, path, UVEC_MAP_WRITE) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, MAP_COUNT);
+    utest_assert_uint(uvec_size(VTYPE, &v), ==, MAP_COUNT);
+    utest_assert_int(uvec_index_of(VTYPE, &v, 1234), ==, 1234);
+    uvec_remove_range(VTYPE, &v, 0, MAP_COUNT / 2);
+    utest_assert(uvec_push(VTYPE, &v, -1) == UVEC_OK);
+    uvec_deinit(VTYPE, &v);
+
+    utest_assert(uvec_map_file(VTYPE, &v, path, UVEC_MAP_READ) == UVEC_OK);
+    utest_assert_uint(uvec_count(VTYPE, &v), ==, MAP_COUNT / 2 + 1);
+    utest_assert_int(uvec_first(VTYPE, &v), ==, MAP_COUNT / 2);
+    utest_assert_int(uvec_last(VTYPE, &v), ==, -1);
+    utest_assert(uvec_push(VTYPE, &v, 0) == UVEC_ERR);
+    uvec_set(VTYPE, &v, 0, 42);
+    uvec_deinit(VTYPE, &v);
+
+    utest_assert(uvec_map_file(VTYPE, &v, path, UVEC_MAP_READ) == UVEC_OK);
+    utest_assert_int(uvec_first(VTYPE, &v), ==, MAP_COUNT / 2);
+    uvec_deinit(VTYPE, &v);
+
+    UVec(char) c;
+    utest_assert(uvec_map_file(char, &c, path, UVEC_MAP_READ) == UVEC_ERR);
+}
+#endif
+
+void uvec_test_map_file(void) {
+#if defined(__unix__) || defined(__APPLE__)
+    static char const path[] = "uvec_map_test.bin";
+
+    // Failed assertions return from the helper, so the file is removed on every path.
+    uvec_test_map_file_contents(path);
+    remove(path);
+
+    UVec(VTYPE) v;
+    utest_assert(uvec_map_file(VTYPE, &v, path, UVEC_MAP_READ) == UVEC_ERR);
+#endif
+}
+
+static ulib_int par_double(ulib_unused void *ctx, ulib_int item) {
+    return item * 2;
+}
+
+static void par_increment(void *ctx, ulib_int *item) {
+    *item += *(ulib_int *)ctx;
+}
+
+static bool par_is_odd(ulib_unused void *ctx, ulib_int item) {
+    return item % 2;
+}
+
+static ulib_int par_max(ulib_unused void *ctx, ulib_int a, ulib_int b) {
+    return ulib_max(a, b);
+}
+
+static ulib_float par_sum_float(ulib_unused void *ctx, ulib_float a, ulib_float b) {
+    return a + b;
+}
+
+void uvec_test_parallel(void) {
+    enum { COUNT = 10000 };
+    static unsigned const threads[] = { 0, 1, 4 };
+
+    UVec(ulib_int) v = uvec(ulib_int), out = uvec(ulib_int);
+    UVec(ulib_float) fv = uvec(ulib_float);
+
+    for (ulib_int i = 0; i < COUNT; ++i) {
+        uvec_push(ulib_int, &v, i % 100);
+        uvec_push(ulib_float, &fv, (ulib_float)1.0 / (ulib_float)(i + 1));
+    }
+
+    // Without a pool, the vector is reduced chunk by chunk on the calling thread, which is
+    // the same path taken when partial results cannot be allocated.
+    utest_assert_uint(COUNT, >, p_uvec_parallel_chunk(ulib_float));
+    ulib_float const fsum = uvec_parallel_reduce(ulib_float, NULL, &fv, 0, par_sum_float, NULL);
+    ulib_float fsum_seq = 0;
+    ulib_uint const chunk = p_uvec_parallel_chunk(ulib_float);
+    for (ulib_uint c = 0; c < COUNT; c += chunk) {
+        ulib_float partial = uvec_get(ulib_float, &fv, c);
+        for (ulib_uint i = c + 1; i < c + chunk && i < COUNT; ++i) {
+            partial += uvec_get(ulib_float, &fv, i);
+        }
+        fsum_seq += partial;
+    }
+    utest_assert(fsum == fsum_seq);
+
+    for (unsigned t = 0; t <= ulib_array_count(threads); ++t) {
+        UPool *pool = NULL;
+
+        if (t < ulib_array_count(threads)) {
+            pool = upool_new(threads[t]);
+            utest_assert_not_null(pool);
+        }
+
+        utest_assert_int(uvec_parallel_map(ulib_int, pool, &v, &out, par_double, NULL), ==,
+                         UVEC_OK);
+        utest_assert_uint(uvec_count(ulib_int, &out), ==, COUNT);
+        for (ulib_int i = 0; i < COUNT; ++i) {
+            utest_assert_int(uvec_get(ulib_int, &out, i), ==, i % 100 * 2);
+        }
+
+        ulib_int delta = 2;
+        uvec_parallel_foreach(ulib_int, pool, &out, par_increment, &delta);
+        for (ulib_int i = 0; i < COUNT; ++i) {
+            utest_assert_int(uvec_get(ulib_int, &out, i), ==, i % 100 * 2 + 2);
+        }
+
+        utest_assert_int(uvec_parallel_filter(ulib_int, pool, &v, &out, par_is_odd, NULL), ==,
+                         UVEC_OK);
+        utest_assert_uint(uvec_count(ulib_int, &out), ==, COUNT / 2);
+        for (ulib_int i = 0; i < COUNT / 2; ++i) {
+            utest_assert_int(uvec_get(ulib_int, &out, i), ==, (i * 2 + 1) % 100);
+        }
+
+        utest_assert_int(uvec_parallel_reduce(ulib_int, pool, &v, 3, par_max, NULL), ==, 99);
+        utest_assert(uvec_parallel_reduce(ulib_float, pool, &fv, 0, par_sum_float, NULL) == fsum);
+
+        upool_free(pool);
+    }
+
+    uvec_clear(ulib_int, &v);
+    utest_assert_int(uvec_parallel_reduce(ulib_int, NULL, &v, 7, par_max, NULL), ==, 7);
+    utest_assert_int(uvec_parallel_filter(ulib_int, NULL, &v, &out, par_is_odd, NULL), ==, UVEC_OK);
+    utest_assert_uint(uvec_count(ulib_int, &out), ==, 0);
+
+    uvec_deinit(ulib_int, &v);
+    uvec_deinit(ulib_int, &out);
+    uvec_deinit(ulib_float, &fv);
+}
+
+void uvec_test_parse(void) {
+    UVec(ulib_int) ints = uvec(ulib_int);
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("1,-2\n3,+4\n"),
+                            ustring_literal(",\n")) == ULIB_OK);
+    uvec_assert_elements(ulib_int, &ints, 1, -2, 3, 4);
+
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_empty, ustring_literal(",")) == ULIB_OK);
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("5,x,6"), ustring_literal(",")) ==
+                 ULIB_ERR);
+    uvec_assert_elements(ulib_int, &ints, 1, -2, 3, 4, 5);
+    uvec_clear(ulib_int, &ints);
+
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("7,,8"), ustring_literal(",")) ==
+                 ULIB_ERR);
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal(",9"), ustring_literal(",")) ==
+                 ULIB_ERR);
+    uvec_assert_elements(ulib_int, &ints, 7);
+    uvec_clear(ulib_int, &ints);
+
+    // CRLF line endings, whether or not '\r' is a delimiter.
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("1,2\r\n3\r\n"),
+                            ustring_literal(",\n")) == ULIB_OK);
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("4\r\n5\r6\r\n"),
+                            ustring_literal("\r\n")) == ULIB_OK);
+    uvec_assert_elements(ulib_int, &ints, 1, 2, 3, 4, 5, 6);
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("7\r\n\r\n8"),
+                            ustring_literal("\r\n")) == ULIB_ERR);
+    utest_assert(uvec_parse(ulib_int, &ints, ustring_literal("9\n\r\n"), ustring_literal("\n")) ==
+                 ULIB_ERR);
+    uvec_assert_elements(ulib_int, &ints, 1, 2, 3, 4, 5, 6, 7, 9);
+    uvec_deinit(ulib_int, &ints);
+
+    UVec(ulib_float) floats = uvec(ulib_float);
+    UStrBuf buf = ustrbuf();
+
+    for (ulib_uint i = 0; i < 100; ++i) {
+        ustrbuf_append_float(&buf, (ulib_float)i / 8);
+        ustrbuf_append_literal(&buf, "\t");
+    }
+
+    UString str = ustrbuf_to_ustring(&buf);
+    utest_assert(uvec_parse(ulib_float, &floats, str, ustring_literal("\t")) == ULIB_OK);
+    utest_assert_uint(uvec_count(ulib_float, &floats), ==, 100);
+
+    for (ulib_uint i = 0; i < 100; ++i) {
+        utest_assert_float(uvec_get(ulib_float, &floats, i), ==, (ulib_float)i / 8);
+    }
+
+    ustring_deinit(&str);
+    uvec_deinit(ulib_float, &floats);
+}
@@ -13,17 +13,28 @@
 void uvec_test_base(void);
 void uvec_test_range(void);
 void uvec_test_capacity(void);
+void uvec_test_growth(void);
 void uvec_test_storage(void);
 void uvec_test_equality(void);
 void uvec_test_contains(void);
 void uvec_test_comparable(void);
+void uvec_test_sorted_search(void);
+void uvec_test_sorted_set_ops(void);
+void uvec_test_sorted_insert_all(void);
 void uvec_test_sort(void);
+void uvec_test_selection(void);
 void uvec_test_max_heapq(void);
 void uvec_test_min_heapq(void);
+void uvec_test_remove_if(void);
+void uvec_test_map_file(void);
+void uvec_test_parallel(void);
+void uvec_test_parse(void);
 
 #define UVEC_TESTS                                                                                 \
-    uvec_test_base, uvec_test_range, uvec_test_capacity, uvec_test_storage, uvec_test_equality,    \
-        uvec_test_contains, uvec_test_comparable, uvec_test_sort, uvec_test_max_heapq,             \
-        uvec_test_min_heapq
+    uvec_test_base, uvec_test_range, uvec_test_capacity, uvec_test_growth, uvec_test_storage,      \
+        uvec_test_equality, uvec_test_contains, uvec_test_comparable, uvec_test_sorted_search,     \
+        uvec_test_sorted_set_ops, uvec_test_sorted_insert_all, uvec_test_sort,                     \
+        uvec_test_selection, uvec_test_max_heapq, uvec_test_min_heapq, uvec_test_remove_if,        \
+        uvec_test_map_file, uvec_test_parallel, uvec_test_parse
 
 #endif // UVEC_TESTS_H